@@ -0,0 +1,218 @@
+#include "KernelBenchmark.h"
+
+#include "Core/CPUFeatures.h"
+
+#include "Utilities/Utilities.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <thread>
+
+const std::vector<CoordinateSet> KernelBenchmark::CoordinateSets = {
+	{ "Interior", { -0.25, 0.0 }, 2.0 },			// The main cardioid fills most of the view
+	{ "Boundary", { -0.7436, 0.1318 }, 100.0 },		// Seahorse Valley, where the escape times vary from pixel to pixel
+	{ "Exterior", { 0.0, 0.0 }, 0.25 }				// The whole set, small in the middle of the view
+};
+
+static constexpr InstructionSet AllInstructionSets[] = { InstructionSet::Scalar, InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::AVX512 };
+
+static constexpr FractalAlgorithm AllAlgorithms[] = { FractalAlgorithm::Mandelbrot, FractalAlgorithm::BurningShip, FractalAlgorithm::Tricorn };
+
+// The quadratic power runs the SIMD kernels, any other one the scalar kernel with complex powers
+static constexpr float Powers[] = { 2.0f, 2.5f };
+
+KernelBenchmark::KernelBenchmark(const KernelBenchmarkSettings& settings)
+	: m_Settings(settings) {
+	m_Settings.Size = std::max(m_Settings.Size, 1u);
+	m_Settings.Repetitions = std::max(m_Settings.Repetitions, 1);
+
+	const uint32_t maxThreads = m_Settings.MaxThreads > 0 ? m_Settings.MaxThreads : std::max(1u, std::thread::hardware_concurrency());
+
+	// Powers of two up to the largest thread count, which is always measured
+	for (uint32_t threads = 1; threads < maxThreads; threads *= 2) {
+		m_ThreadCounts.push_back(threads);
+	}
+
+	m_ThreadCounts.push_back(maxThreads);
+
+	for (const uint32_t threads : m_ThreadCounts) {
+		m_Pools.push_back(CreateScope<ThreadPool>(threads));
+	}
+
+	for (const InstructionSet instructionSet : AllInstructionSets) {
+		if (CPUFeatures::Supports(instructionSet)) {
+			m_InstructionSets.push_back(instructionSet);
+		}
+	}
+
+	m_Orbits.resize((size_t)m_Settings.Size * m_Settings.Size);
+}
+
+uint32_t KernelBenchmark::Run(JsonWriter& writer) {
+	std::vector<BenchmarkCase> cases = GetCases();
+	std::erase_if(cases, [&](const BenchmarkCase& benchmarkCase) { return benchmarkCase.GetName().find(m_Settings.Filter) == std::string::npos; });
+
+	writer.BeginObject();
+
+	writer.Key("Machine").BeginObject();
+	writer.Key("HardwareThreads").Value(std::thread::hardware_concurrency());
+	writer.Key("BestInstructionSet").Value(Utilities::InstructionSetToString(CPUFeatures::GetBestInstructionSet()));
+	writer.EndObject();
+
+	writer.Key("Settings").BeginObject();
+	writer.Key("Size").Value(m_Settings.Size);
+	writer.Key("MaxIterations").Value(m_Settings.MaxIterations);
+	writer.Key("Repetitions").Value(m_Settings.Repetitions);
+	writer.Key("Filter").Value(m_Settings.Filter);
+	writer.EndObject();
+
+	writer.Key("Cases").BeginArray();
+
+	for (size_t i = 0; i < cases.size(); ++i) {
+		const BenchmarkCase& benchmarkCase = cases[i];
+		const KernelParameters params = CreateParameters(benchmarkCase);
+
+		std::fprintf(stderr, "[%zu/%zu] %s\n", i + 1, cases.size(), benchmarkCase.GetName().c_str());
+
+		writer.BeginObject();
+		writer.Key("Name").Value(benchmarkCase.GetName());
+		writer.Key("Algorithm").Value(Utilities::FractalAlgorithmToString(benchmarkCase.Algorithm));
+		writer.Key("Power").Value(benchmarkCase.Power);
+		writer.Key("Derivative").Value(benchmarkCase.Derivative);
+		writer.Key("Trap").Value(benchmarkCase.Trap);
+		writer.Key("Coordinates").Value(benchmarkCase.Coordinates->Name);
+		writer.Key("InteriorRejection").Value(params.RejectInterior);
+		writer.Key("Pixels").Value(m_Orbits.size());
+
+		// The SIMD kernels fall back to the scalar one for the frames they do not support, which would only measure it again
+		const bool simd = FractalKernel::SupportsSIMD(params);
+		const InstructionSet best = simd ? m_InstructionSets.back() : InstructionSet::Scalar;
+
+		writer.Key("Kernels").BeginArray();
+		for (const InstructionSet instructionSet : m_InstructionSets) {
+			if (!simd && instructionSet != InstructionSet::Scalar) {
+				continue;
+			}
+
+			writer.BeginObject();
+			writer.Key("InstructionSet").Value(Utilities::InstructionSetToString(instructionSet));
+			WriteMeasurement(writer, Measure(params, instructionSet, *m_Pools.front()));
+			writer.EndObject();
+		}
+		writer.EndArray();
+
+		writer.Key("Scaling").BeginObject();
+		writer.Key("InstructionSet").Value(Utilities::InstructionSetToString(best));
+		writer.Key("Threads").BeginArray();
+
+		double singleThreadSeconds = 0.0;
+		for (size_t t = 0; t < m_ThreadCounts.size(); ++t) {
+			const Measurement measurement = Measure(params, best, *m_Pools[t]);
+			if (t == 0) {
+				singleThreadSeconds = measurement.Seconds;
+			}
+
+			writer.BeginObject();
+			writer.Key("Threads").Value(m_ThreadCounts[t]);
+			WriteMeasurement(writer, measurement);
+			writer.Key("Speedup").Value(singleThreadSeconds / measurement.Seconds);
+			writer.Key("Efficiency").Value(singleThreadSeconds / measurement.Seconds / m_ThreadCounts[t]);
+			writer.EndObject();
+		}
+
+		writer.EndArray();
+		writer.EndObject();
+
+		writer.EndObject();
+	}
+
+	writer.EndArray();
+	writer.EndObject();
+
+	return (uint32_t)cases.size();
+}
+
+std::string KernelBenchmark::BenchmarkCase::GetName() const {
+	char power[16];
+	std::snprintf(power, sizeof(power), "%g", Power);
+
+	const char* work = Trap ? "Trap" : (Derivative ? "Derivative" : "Plain");
+
+	return Utilities::FractalAlgorithmToString(Algorithm) + "/Power" + power + "/" + work + "/" + Coordinates->Name;
+}
+
+std::vector<KernelBenchmark::BenchmarkCase> KernelBenchmark::GetCases() const {
+	std::vector<BenchmarkCase> cases;
+
+	for (const FractalAlgorithm algorithm : AllAlgorithms) {
+		for (const float power : Powers) {
+			// The orbit trap always tracks the derivative (see 'Mandelbrot::NeedsDerivative'), so there is no trap without it
+			for (int work = 0; work < 3; ++work) {
+				for (const CoordinateSet& coordinates : CoordinateSets) {
+					cases.push_back({ algorithm, power, work >= 1, work == 2, &coordinates });
+				}
+			}
+		}
+	}
+
+	return cases;
+}
+
+KernelParameters KernelBenchmark::CreateParameters(const BenchmarkCase& benchmarkCase) const {
+	Mandelbrot mandelbrot;
+	mandelbrot.Algorithm = benchmarkCase.Algorithm;
+	mandelbrot.Power = benchmarkCase.Power;
+	mandelbrot.MaxIterations = m_Settings.MaxIterations;
+	mandelbrot.Position = BigVec2(benchmarkCase.Coordinates->Position);
+	mandelbrot.Zoom = benchmarkCase.Coordinates->Zoom;
+
+	if (benchmarkCase.Derivative) {
+		mandelbrot.ExteriorColoring = ColorAlgorithm::DistanceEstimation;
+	}
+
+	if (benchmarkCase.Trap) {
+		mandelbrot.Trap.Type = OrbitTrapType::Circle;
+		mandelbrot.Trap.P1 = { 0.0f, 0.0f };
+		mandelbrot.Trap.P2 = { 0.5f, 0.5f };
+	}
+
+	return KernelParameters::Create(mandelbrot, m_Settings.Size, m_Settings.Size);
+}
+
+KernelBenchmark::Measurement KernelBenchmark::Measure(const KernelParameters& params, InstructionSet instructionSet, ThreadPool& pool) {
+	const uint32_t size = m_Settings.Size;
+
+	Measurement measurement;
+	measurement.Seconds = std::numeric_limits<double>::max();
+
+	for (int repetition = 0; repetition < m_Settings.Repetitions; ++repetition) {
+		const auto start = std::chrono::steady_clock::now();
+
+		// One row per job, which balances the rows of very different costs like the renderer's tiles do
+		pool.ParallelFor(size, [&](uint32_t y) {
+			FractalKernel::IterateRow(params, instructionSet, 0, y, size, m_Orbits.data() + (size_t)y * size);
+		});
+
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		measurement.Seconds = std::min(measurement.Seconds, elapsed.count());
+	}
+
+	// Every repetition iterates the same orbits
+	for (const OrbitResult& orbit : m_Orbits) {
+		measurement.Iterations += (uint64_t)orbit.ExecutedIterations;
+	}
+
+	return measurement;
+}
+
+void KernelBenchmark::WriteMeasurement(JsonWriter& writer, const Measurement& measurement) const {
+	const double seconds = std::max(measurement.Seconds, 1e-9);
+
+	writer.Key("Seconds").Value(measurement.Seconds);
+	writer.Key("Iterations").Value(measurement.Iterations);
+	writer.Key("NanosecondsPerIteration").Value(measurement.Iterations > 0 ? seconds * 1e9 / (double)measurement.Iterations : 0.0);
+	writer.Key("PixelsPerSecond").Value((double)m_Orbits.size() / seconds);
+	writer.Key("IterationsPerSecond").Value((double)measurement.Iterations / seconds);
+}
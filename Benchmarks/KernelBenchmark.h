@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Core/Core.h"
+#include "Core/JsonWriter.h"
+#include "Core/ThreadPool.h"
+
+#include "Renderer/CPU/FractalKernel.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * The options of a kernel benchmark run.
+ */
+struct KernelBenchmarkSettings {
+	/// @brief The width and height of the image iterated by every case, in pixels.
+	uint32_t Size = 128;
+
+	int MaxIterations = 500;
+
+	/// @brief How many times each measurement is repeated. The fastest repetition is kept, as the others only add the noise of the machine.
+	int Repetitions = 3;
+
+	/// @brief The largest number of threads the scaling is measured up to. `0` uses every hardware thread.
+	uint32_t MaxThreads = 0;
+
+	/// @brief Only the cases whose name contains this text are run.
+	std::string Filter;
+};
+
+/**
+ * A view the cases are iterated over, chosen for how its pixels escape.
+ */
+struct CoordinateSet {
+	const char* Name;
+	glm::dvec2 Position;
+	double Zoom;
+};
+
+/**
+ * Measures the escape-time kernels of the CPU engine, without any of the work the renderer does around them (area skipping, caches, shading).
+ *
+ * Every case iterates a fixed view with one combination of algorithm, power (quadratic or not) and per-iteration work (the derivative, the orbit trap).
+ * A case is measured on a single thread with every supported instruction set, then with the best one from one thread up to `MaxThreads`.
+ */
+class KernelBenchmark {
+public:
+	/// @brief The views every case is iterated over: mostly interior pixels (which run to the iteration limit), mostly boundary pixels, and mostly exterior pixels (which escape within a few iterations).
+	static const std::vector<CoordinateSet> CoordinateSets;
+
+	KernelBenchmark(const KernelBenchmarkSettings& settings);
+
+	/**
+	 * Runs every case matching the filter, writing the results as a JSON object and their progress to the standard error.
+	 *
+	 * @return The number of cases run.
+	 */
+	uint32_t Run(JsonWriter& writer);
+private:
+	struct BenchmarkCase {
+		FractalAlgorithm Algorithm;
+		float Power;
+		bool Derivative;
+		bool Trap;
+		const CoordinateSet* Coordinates;
+
+		std::string GetName() const;
+	};
+
+	struct Measurement {
+		double Seconds = 0.0;
+		uint64_t Iterations = 0;
+	};
+
+	std::vector<BenchmarkCase> GetCases() const;
+
+	/// @brief Builds the kernel parameters of a case the way the renderer would, from a fractal description.
+	KernelParameters CreateParameters(const BenchmarkCase& benchmarkCase) const;
+
+	/// @brief Iterates the image of a case `Repetitions` times, spreading its rows over the pool, and keeps the fastest repetition.
+	Measurement Measure(const KernelParameters& params, InstructionSet instructionSet, ThreadPool& pool);
+
+	void WriteMeasurement(JsonWriter& writer, const Measurement& measurement) const;
+private:
+	KernelBenchmarkSettings m_Settings;
+
+	/// @brief The thread counts the scaling is measured with, with a pool for each one.
+	std::vector<uint32_t> m_ThreadCounts;
+	std::vector<Scope<ThreadPool>> m_Pools;
+
+	/// @brief The instruction sets the processor supports, from the narrowest to the widest.
+	std::vector<InstructionSet> m_InstructionSets;
+
+	std::vector<OrbitResult> m_Orbits;
+};
@@ -0,0 +1,63 @@
+#include "KernelBenchmark.h"
+
+#include "Core/CommandLine.h"
+#include "Core/Log.h"
+
+#include <algorithm>
+#include <cstdio>
+
+static void PrintUsage() {
+	std::printf(
+		"Usage: MandelbrotBench [options]\n"
+		"\n"
+		"Measures the escape-time kernels of the CPU engine for every algorithm, power (quadratic or not) and\n"
+		"derivative/orbit trap combination, over interior-, boundary- and exterior-heavy views.\n"
+		"The results are written as JSON, so runs can be compared; the progress goes to the standard error.\n"
+		"\n"
+		"Options:\n"
+		"  --size=<pixels>        The width and height of the image of every case (default 128)\n"
+		"  --iterations=<n>       The iteration limit (default 500)\n"
+		"  --repetitions=<n>      How many times each measurement runs, the fastest one being kept (default 3)\n"
+		"  --threads=<n>          The largest thread count the scaling is measured with (default: every hardware thread)\n"
+		"  --filter=<text>        Only runs the cases whose name contains the text, like 'Mandelbrot/Power2/'\n"
+		"  --output=<file>        The JSON file the results are written to (default: the standard output)\n"
+	);
+}
+
+int main(int argc, char** argv) {
+	const CommandLine commandLine(argc, argv);
+
+	if (commandLine.HasOption("help")) {
+		PrintUsage();
+		return 0;
+	}
+
+	// The standard output may carry the report, so the log keeps to the errors, which go to the standard error
+	LogSpecification logSpecification;
+	logSpecification.Name = "MandelbrotBench";
+	logSpecification.WriteToFile = false;
+	Log::Init(logSpecification);
+	Log::SetLevel(Level::Error);
+
+	KernelBenchmarkSettings settings;
+	settings.Size = (uint32_t)std::max(commandLine.GetInt("size", (int)settings.Size), 1);
+	settings.MaxIterations = std::max(commandLine.GetInt("iterations", settings.MaxIterations), 1);
+	settings.Repetitions = std::max(commandLine.GetInt("repetitions", settings.Repetitions), 1);
+	settings.MaxThreads = (uint32_t)std::max(commandLine.GetInt("threads", 0), 0);
+	settings.Filter = commandLine.GetOption("filter");
+
+	KernelBenchmark benchmark(settings);
+
+	JsonWriter writer;
+	if (benchmark.Run(writer) == 0) {
+		Log::Error("main - No case matches the filter '" + settings.Filter + "'");
+		return 1;
+	}
+
+	if (!commandLine.HasOption("output")) {
+		std::printf("%s\n", writer.GetString().c_str());
+		return 0;
+	}
+
+	return writer.Save(commandLine.GetOption("output")) ? 0 : 1;
+}
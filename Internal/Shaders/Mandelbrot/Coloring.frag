@@ -0,0 +1,130 @@
+#version 460 core
+
+out vec4 FragColor;
+
+// The coloring pass: turns the orbits stored by the iteration pass (Iteration.frag) into colors, without iterating anything.
+layout(binding = 0) uniform sampler2D u_Orbits; // Iterations, final z, minimum trap distance
+layout(binding = 1) uniform sampler2D u_Derivatives; // Squared magnitude of the final derivative
+layout(binding = 2) uniform sampler2D u_HistogramCDF; // Cumulative iteration histogram (HistogramScan.comp), only bound for the Histogram mode
+layout(binding = 3) uniform sampler2D u_PaletteLUT; // The palette baked into a linearly filtered lookup table (see 'PaletteLUT')
+layout(binding = 4) uniform sampler2D u_SampleMask; // The pixels that get extra samples (SampleMask.frag), only bound for the sample passes
+layout(binding = 5) uniform sampler2D u_Accumulated; // The sum of the colors of the samples before this one, only bound for the sample passes
+
+// Calculation Uniforms
+uniform int u_MaxIterations;
+uniform float u_Power;
+
+// Coloring Uniforms
+uniform int u_ExteriorColoring; // 0: Step, 1: Smooth, 2: DistanceEstimation, 3: Histogram
+uniform int u_InteriorColoring; // 0: Black, 1: White, 2: CustomColor
+uniform vec3 u_InteriorColor;
+uniform float u_ColorFrequency;
+uniform float u_ColorOffset;
+uniform bool u_OrbitColoring;
+uniform float u_DistanceScale;
+uniform int u_HistogramBins;
+
+// Orbit Trap Uniforms
+uniform int u_TrapType; // 0: None, 1: Point, 2: Circle, 3: Line, 4: Box, 5: Cross
+uniform vec3 u_TrapColor;
+uniform float u_TrapBlend;
+
+// Supersampling Uniforms: a sample pass adds its color to the sum of the samples before it, the last one scaling the sum into their average
+uniform bool u_Accumulate;
+uniform float u_ColorScale;
+
+#define PI 3.14159265358979323846
+
+// Interpolates the color from the palette
+vec3 GetPaletteColor(float t) {
+    t = fract(t * u_ColorFrequency + u_ColorOffset);
+
+    // The ends of the gradient are the centers of the first and last texels, so the filtering interpolates between samples like the CPU does
+    float size = float(textureSize(u_PaletteLUT, 0).x);
+    return texture(u_PaletteLUT, vec2((t * (size - 1.0) + 0.5) / size, 0.5)).rgb;
+}
+
+void main() {
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+
+    // Only the pixels flagged by the mask get extra samples
+    if (u_Accumulate && texelFetch(u_SampleMask, pixel, 0).r == 0.0) {
+        discard;
+    }
+
+    vec4 orbit = texelFetch(u_Orbits, pixel, 0);
+
+    int i = int(orbit.x);
+    vec2 z = orbit.yz;
+    float minTrapDist = orbit.w;
+
+    vec3 finalColor;
+    if (i >= u_MaxIterations) {
+        // Interior Coloring
+        if (u_InteriorColoring == 0) finalColor = vec3(0.0); // Black
+        else if (u_InteriorColoring == 1) finalColor = vec3(1.0); // White
+        else finalColor = u_InteriorColor; // CustomColor
+    } else {
+        // Exterior Coloring
+        float t = 0.0;
+
+        if (u_ExteriorColoring == 0) { // Step
+            t = float(i) / float(u_MaxIterations);
+        } else if (u_ExteriorColoring == 1) { // Smooth
+            float logP = log(u_Power);
+            float log_zn = log(dot(z, z)) * 0.5;
+            float nu = log(log_zn / logP) / logP;
+            t = (float(i) + 1.0 - nu) / float(u_MaxIterations);
+        } else if (u_ExteriorColoring == 3) { // Histogram
+            float logP = log(u_Power);
+            float log_zn = log(dot(z, z)) * 0.5;
+            float nu = log(log_zn / logP) / logP;
+
+            // The smooth iteration count, kept within the iteration of the pixel so it falls into the bin the pixel was counted in
+            float mu = float(i) + clamp(1.0 - nu, 0.0, 1.0);
+
+            // Interpolates the cumulative histogram across the bin, so the bands of the palette stay smooth
+            float bin = mu * (float(u_HistogramBins) / float(u_MaxIterations));
+            int k = min(int(bin), u_HistogramBins - 1);
+            float below = texelFetch(u_HistogramCDF, ivec2(k, 0), 0).r;
+            float above = texelFetch(u_HistogramCDF, ivec2(k + 1, 0), 0).r;
+            t = mix(below, above, clamp(bin - float(k), 0.0, 1.0));
+        } else { // Distance Estimation
+            // Calculate the squares of the magnitudes
+            float z_sq = dot(z, z);
+            float dz_sq = texelFetch(u_Derivatives, pixel, 0).r;
+
+            // Security guards to prevent mathematical errors
+            if (dz_sq < 1e-20 || z_sq < 1e-20) {
+                // If in an unstable area, simply use Step mode as a fallback.
+                t = float(i) / float(u_MaxIterations);
+            } else {
+                // If it is safe, calculate the distance
+                float d = sqrt(z_sq / dz_sq) * log(z_sq) * 0.5; // 0.5 adjusts the scale
+                t = d * u_DistanceScale;
+            }
+        }
+
+        finalColor = GetPaletteColor(t);
+
+        if (u_OrbitColoring) {
+            // Use the angle of the end point 'z' to modify the color
+            float angle = atan(z.y, z.x) / (2.0 * PI);
+            vec3 orbit_color = GetPaletteColor(angle);
+            // Mix the original color with the orbit color
+            finalColor = mix(finalColor, orbit_color, 0.5);
+        }
+    }
+
+    // Final mix with Orbit Trap
+    if (u_TrapType > 0 && minTrapDist < 1e19) {
+        float trapFactor = u_TrapBlend * exp(-2.0 * minTrapDist);
+        finalColor = mix(finalColor, u_TrapColor, trapFactor);
+    }
+
+    if (u_Accumulate) {
+        finalColor = (texelFetch(u_Accumulated, pixel, 0).rgb + finalColor) * u_ColorScale;
+    }
+
+    FragColor = vec4(finalColor, 1.0);
+}
\ No newline at end of file
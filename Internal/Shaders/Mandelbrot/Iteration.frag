@@ -0,0 +1,371 @@
+#version 460 core
+
+// The iteration pass: every pixel stores the outcome of its orbit, which the coloring pass (Coloring.frag) turns into a color.
+// Coloring changes only rerun the coloring pass, so nothing here may depend on them.
+layout(location = 0) out vec4 o_Orbit; // Iterations, final z, minimum trap distance
+layout(location = 1) out float o_Derivative; // Squared magnitude of the final derivative
+
+// Vision and Calculation Uniforms
+uniform vec2 u_Resolution;
+uniform float u_Zoom;
+uniform vec2 u_Position;
+uniform float u_Rotation;
+uniform int u_MaxIterations;
+uniform float u_Bailout;
+uniform float u_Power;
+uniform int u_Algorithm; // 0: Mandelbrot, 1: Burning Ship, 2: Tricorn
+uniform bool u_RejectInterior; // Quadratic Mandelbrot without orbit trap only
+
+// Double Precision Uniforms (deep zooms, where the pixel spacing drops below the float resolution)
+uniform bool u_UseDoublePrecision;
+uniform double u_DoubleZoom;
+uniform dvec2 u_DoublePosition;
+
+// Julia Uniforms
+uniform bool u_JuliaMode;
+uniform vec2 u_JuliaC;
+
+// Derivative Uniforms (Distance Estimation and Orbit Traps)
+uniform bool u_NeedsDerivative;
+
+// Orbit Trap Uniforms
+uniform int u_TrapType; // 0: None, 1: Point, 2: Circle, 3: Line, 4: Box, 5: Cross
+uniform vec2 u_TrapP1;
+uniform vec2 u_TrapP2;
+
+// Panning Uniforms: the orbits of the previous frame, shifted by a whole number of pixels, only the exposed pixels being iterated
+layout(binding = 0) uniform sampler2D u_PreviousOrbits;
+layout(binding = 1) uniform sampler2D u_PreviousDerivatives;
+uniform bool u_ReuseOrbits;
+uniform ivec2 u_ReuseOffset;
+
+// Progressive Uniforms: the passes iterated by this draw, the pixels of the other passes copying an orbit from the previous buffer (see ProgressivePass)
+uniform bool u_Progressive;
+uniform int u_PassBegin;
+uniform int u_PassEnd;
+
+// Supersampling Uniforms: the offset of the sample from the pixel center, and the pixels that get extra samples (SampleMask.frag)
+uniform vec2 u_SampleOffset;
+layout(binding = 2) uniform sampler2D u_SampleMask;
+uniform bool u_UseSampleMask;
+
+// The pass of progressive rendering a pixel is iterated in, out of 64: an 8x8 Bayer matrix, whose first 1, 4 and 16 passes iterate a pixel in every 8x8, 4x4 and 2x2 block
+int ProgressivePass(ivec2 pixel) {
+    int pass = 0;
+
+    // The finest level spreads the passes furthest apart, so it weighs the most
+    for (int level = 0; level < 3; level++) {
+        ivec2 bit = (pixel >> level) & 1;
+        pass += (2 * (bit.x ^ bit.y) + bit.y) << (2 * (2 - level));
+    }
+
+    return pass;
+}
+
+// The size of the blocks whose first pixel was iterated once 'passes' passes are done
+int ProgressiveBlockSize(int passes) {
+    return passes >= 16 ? 2 : (passes >= 4 ? 4 : 8);
+}
+
+// Complex multiplication
+vec2 CMul(vec2 a, vec2 b) {
+    return vec2(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+// Complex power: z^p
+vec2 CPow(vec2 z, float p) {
+    float r = length(z);
+    float a = atan(z.y, z.x);
+
+    return pow(r, p) * vec2(cos(p * a), sin(p * a));
+}
+
+// Distance from a point to a line segment
+float DistanceToLine(vec2 p, vec2 a, vec2 b) {
+    vec2 pa = p - a, ba = b - a;
+    float h = clamp(dot(pa, ba) / dot(ba, ba), 0.0, 1.0);
+
+    return length(pa - ba * h);
+}
+
+// Function to calculate the distance to a box (Chebyshev distance)
+float DistanceToBox(vec2 p, vec2 center, vec2 size) {
+    vec2 d = abs(p - center) - size;
+
+    return length(max(d, 0.0)) + min(max(d.x, d.y), 0.0);
+}
+
+// Function to calculate the distance to a cross
+float DistanceToCross(vec2 p, vec2 center) {
+    vec2 d = abs(p - center);
+
+    return min(d.x, d.y);
+}
+
+// Distance from 'z' to the orbit trap
+float TrapDistance(vec2 z) {
+    float dist = 1e20;
+
+    if (u_TrapType == 1) { // Point
+        dist = length(z - u_TrapP1);
+    } else if (u_TrapType == 2) { // Circle
+        dist = abs(length(z - u_TrapP1) - u_TrapP2.x);
+    } else if (u_TrapType == 3) { // Line
+        dist = DistanceToLine(z, u_TrapP1, u_TrapP2);
+    } else if (u_TrapType == 4) { // Box
+        dist = DistanceToBox(z, u_TrapP1, u_TrapP2);
+    } else if (u_TrapType == 5) { // Cross
+        dist = DistanceToCross(z, u_TrapP1);
+    }
+
+    return dist;
+}
+
+// Whether 'c' lies inside the main cardioid or the period-2 bulb, where every orbit stays bounded
+bool IsInMainCardioidOrBulb(vec2 c) {
+    float x = c.x - 0.25;
+    float y2 = c.y * c.y;
+    float q = x * x + y2;
+    if (q * (q + x) <= 0.25 * y2) {
+        return true;
+    }
+
+    float x1 = c.x + 1.0;
+    return x1 * x1 + y2 <= 0.0625;
+}
+
+bool IsInMainCardioidOrBulb(dvec2 c) {
+    double x = c.x - 0.25;
+    double y2 = c.y * c.y;
+    double q = x * x + y2;
+    if (q * (q + x) <= 0.25 * y2) {
+        return true;
+    }
+
+    double x1 = c.x + 1.0;
+    return x1 * x1 + y2 <= 0.0625;
+}
+
+// Iterates the point 'p' of the complex plane in single precision
+void IterateFloat(vec2 p, out int i, out vec2 z, out vec2 dz, out float minTrapDist) {
+    vec2 c;
+    if (u_JuliaMode) {
+        z = p;
+        c = u_JuliaC;
+    } else {
+        z = vec2(0.0);
+        c = p;
+    }
+
+    dz = vec2(0.0); // Derivative for Distance Estimation
+    if (u_JuliaMode) {
+        dz = vec2(1.0, 0.0);
+    }
+    minTrapDist = 1e20; // Minimum distance for Orbit Trap
+
+    // Interior pixels that can be classified analytically skip the iteration entirely
+    if (u_RejectInterior && IsInMainCardioidOrBulb(c)) {
+        i = u_MaxIterations;
+        return;
+    }
+
+    bool needsDerivative = u_NeedsDerivative;
+    bool isPow2 = (u_Power == 2.0);
+
+    // Brent's periodicity check: the orbit is compared with a point saved at doubling intervals.
+    // An orbit that lands exactly on it again has entered a cycle, so it will never escape and its trap distances are already known.
+    vec2 saved = z;
+    int checkpoint = 1;
+
+    for (i = 0; i < u_MaxIterations; i++) {
+        // The derivative is updated using the current 'z'
+        if (needsDerivative) {
+            // Avoid singularity at the origin for non-integer powers
+            if (dot(z, z) > 1e-12) {
+                if (isPow2) {
+                    dz = 2.0 * CMul(z, dz);
+                } else {
+                    dz = u_Power * CMul(CPow(z, u_Power - 1.0), dz);
+                }
+            }
+        }
+
+        if (u_Algorithm == 1) { // Burning Ship
+            z = vec2(abs(z.x), abs(z.y));
+        } else if (u_Algorithm == 2) { // Tricorn
+            z = vec2(z.x, -z.y); // Use the conjugate
+        }
+
+        // Z Update
+        if (isPow2) {
+            z = vec2(z.x * z.x - z.y * z.y, 2.0 * z.x * z.y) + c;
+        } else {
+            z = CPow(z, u_Power) + c;
+        }
+
+        // For Mandelbrot, on the first iteration, dz must be 1
+        if (!u_JuliaMode && i == 0) {
+            dz = vec2(1.0, 0.0);
+        }
+
+        // Orbit Trap Logic
+        if (u_TrapType > 0) {
+            minTrapDist = min(minTrapDist, TrapDistance(z));
+        }
+
+        if (dot(z, z) > u_Bailout) {
+            break;
+        }
+
+        if (z == saved) {
+            i = u_MaxIterations;
+            break;
+        }
+
+        if (i == checkpoint) {
+            saved = z;
+            checkpoint *= 2;
+        }
+    }
+}
+
+// Iterates the point 'p' of the complex plane in double precision.
+// GLSL has no double transcendental functions, so non-quadratic powers and orbit traps are evaluated in single precision around the double orbit.
+void IterateDouble(dvec2 p, out int i, out vec2 zOut, out vec2 dzOut, out float minTrapDist) {
+    dvec2 z, c;
+    if (u_JuliaMode) {
+        z = p;
+        c = dvec2(u_JuliaC);
+    } else {
+        z = dvec2(0.0);
+        c = p;
+    }
+
+    dvec2 dz = dvec2(0.0);
+    if (u_JuliaMode) {
+        dz = dvec2(1.0, 0.0);
+    }
+    minTrapDist = 1e20;
+
+    if (u_RejectInterior && IsInMainCardioidOrBulb(c)) {
+        i = u_MaxIterations;
+        zOut = vec2(0.0);
+        dzOut = vec2(0.0);
+        return;
+    }
+
+    bool needsDerivative = u_NeedsDerivative;
+    bool isPow2 = (u_Power == 2.0);
+
+    dvec2 saved = z;
+    int checkpoint = 1;
+
+    for (i = 0; i < u_MaxIterations; i++) {
+        if (needsDerivative) {
+            if (dot(z, z) > 1e-12) {
+                if (isPow2) {
+                    dz = 2.0 * dvec2(z.x * dz.x - z.y * dz.y, z.x * dz.y + z.y * dz.x);
+                } else {
+                    dz = dvec2(u_Power * CMul(CPow(vec2(z), u_Power - 1.0), vec2(dz)));
+                }
+            }
+        }
+
+        if (u_Algorithm == 1) { // Burning Ship
+            z = dvec2(abs(z.x), abs(z.y));
+        } else if (u_Algorithm == 2) { // Tricorn
+            z = dvec2(z.x, -z.y);
+        }
+
+        if (isPow2) {
+            z = dvec2(z.x * z.x - z.y * z.y, 2.0 * z.x * z.y) + c;
+        } else {
+            z = dvec2(CPow(vec2(z), u_Power)) + c;
+        }
+
+        if (!u_JuliaMode && i == 0) {
+            dz = dvec2(1.0, 0.0);
+        }
+
+        if (u_TrapType > 0) {
+            minTrapDist = min(minTrapDist, TrapDistance(vec2(z)));
+        }
+
+        if (dot(z, z) > double(u_Bailout)) {
+            break;
+        }
+
+        if (z == saved) {
+            i = u_MaxIterations;
+            break;
+        }
+
+        if (i == checkpoint) {
+            saved = z;
+            checkpoint *= 2;
+        }
+    }
+
+    zOut = vec2(z);
+    dzOut = vec2(dz);
+}
+
+void main() {
+    // Only the pixels flagged by the mask get extra samples
+    if (u_UseSampleMask && texelFetch(u_SampleMask, ivec2(gl_FragCoord.xy), 0).r == 0.0) {
+        discard;
+    }
+
+    // Progressive rendering iterates a few passes per draw. The pixels of the passes before keep their orbit,
+    // and those of the passes after show the orbit of the first pixel of their block, the closest one iterated before the draw.
+    if (u_Progressive) {
+        ivec2 pixel = ivec2(gl_FragCoord.xy);
+        int pass = ProgressivePass(pixel);
+
+        if (pass < u_PassBegin || pass >= u_PassEnd) {
+            ivec2 source = pass < u_PassBegin ? pixel : pixel & ~(ProgressiveBlockSize(u_PassBegin) - 1);
+
+            o_Orbit = texelFetch(u_PreviousOrbits, source, 0);
+            o_Derivative = texelFetch(u_PreviousDerivatives, source, 0).r;
+            return;
+        }
+    }
+
+    // The pixel was on screen in the previous frame, so its orbit is copied over
+    if (u_ReuseOrbits) {
+        ivec2 source = ivec2(gl_FragCoord.xy) + u_ReuseOffset;
+
+        if (all(greaterThanEqual(source, ivec2(0))) && all(lessThan(source, textureSize(u_PreviousOrbits, 0)))) {
+            o_Orbit = texelFetch(u_PreviousOrbits, source, 0);
+            o_Derivative = texelFetch(u_PreviousDerivatives, source, 0).r;
+            return;
+        }
+    }
+
+    vec2 fragCoord = gl_FragCoord.xy + u_SampleOffset;
+    vec2 uv = (fragCoord * 2.0 - u_Resolution.xy) / u_Resolution.y;
+
+    // Calculate the sine and cosine only once
+    float cosR = cos(u_Rotation);
+    float sinR = sin(u_Rotation);
+
+    // Create a rotation matrix and apply it to the view coordinates
+    mat2 rotationMatrix = mat2(cosR, -sinR, sinR, cosR);
+    uv = rotationMatrix * uv;
+
+    int i;
+    vec2 z, dz;
+    float minTrapDist;
+
+    if (u_UseDoublePrecision) {
+        dvec2 duv = dvec2((fragCoord * 2.0 - u_Resolution.xy)) / double(u_Resolution.y);
+        duv = dmat2(cosR, -sinR, sinR, cosR) * duv;
+
+        IterateDouble(u_DoublePosition + duv / u_DoubleZoom, i, z, dz, minTrapDist);
+    } else {
+        IterateFloat(u_Position + uv / u_Zoom, i, z, dz, minTrapDist);
+    }
+
+    o_Orbit = vec4(float(i), z, minTrapDist);
+    o_Derivative = dot(dz, dz);
+}
\ No newline at end of file
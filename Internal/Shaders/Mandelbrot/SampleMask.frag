@@ -0,0 +1,59 @@
+#version 460 core
+
+out float FragColor;
+
+// The mask pass of adaptive supersampling: flags the pixels whose neighbours differ from them, or that the distance estimate puts near the boundary.
+// The sample passes (Iteration.frag and Coloring.frag) then only run for the flagged pixels.
+layout(binding = 0) uniform sampler2D u_Orbits; // Iterations, final z, minimum trap distance
+layout(binding = 1) uniform sampler2D u_Derivatives; // Squared magnitude of the final derivative
+layout(binding = 2) uniform sampler2D u_Colors; // The colors of the coloring pass
+
+uniform int u_MaxIterations;
+
+// Thresholds Uniforms
+uniform float u_ColorThreshold;
+uniform int u_IterationThreshold;
+
+// Distance Uniforms: only when the iteration pass tracked the derivative
+uniform bool u_UseDistance;
+uniform float u_PixelSpacing;
+
+// Whether a pixel and its neighbour differ enough for the edge between them to alias
+bool Differs(ivec2 neighbour, int i, vec3 color) {
+    if (any(lessThan(neighbour, ivec2(0))) || any(greaterThanEqual(neighbour, textureSize(u_Orbits, 0)))) {
+        return false;
+    }
+
+    int j = int(texelFetch(u_Orbits, neighbour, 0).x);
+    if ((i >= u_MaxIterations) != (j >= u_MaxIterations) || abs(i - j) > u_IterationThreshold) {
+        return true;
+    }
+
+    vec3 delta = abs(texelFetch(u_Colors, neighbour, 0).rgb - color);
+    return max(delta.r, max(delta.g, delta.b)) > u_ColorThreshold;
+}
+
+void main() {
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    vec4 orbit = texelFetch(u_Orbits, pixel, 0);
+    vec3 color = texelFetch(u_Colors, pixel, 0).rgb;
+    int i = int(orbit.x);
+
+    bool flagged = Differs(pixel + ivec2(-1, 0), i, color)
+        || Differs(pixel + ivec2(1, 0), i, color)
+        || Differs(pixel + ivec2(0, -1), i, color)
+        || Differs(pixel + ivec2(0, 1), i, color);
+
+    // Same distance as the Distance Estimation coloring, for the exterior pixels closer to the boundary than a pixel
+    if (!flagged && u_UseDistance && i < u_MaxIterations) {
+        float z_sq = dot(orbit.yz, orbit.yz);
+        float dz_sq = texelFetch(u_Derivatives, pixel, 0).r;
+
+        if (dz_sq >= 1e-20 && z_sq >= 1e-20 && !isinf(dz_sq)) {
+            float d = sqrt(z_sq / dz_sq) * log(z_sq) * 0.5;
+            flagged = d < u_PixelSpacing;
+        }
+    }
+
+    FragColor = flagged ? 1.0 : 0.0;
+}
\ No newline at end of file
@@ -1,8 +1,13 @@
 #include "Core/Application.h"
 #include "Core/EntryPoint.h"
 
+#include "Core/Log.h"
 #include "Core/Settings/SettingsManager.h"
 
+#include "Headless/BatchRenderer.h"
+#include "Headless/ParityChecker.h"
+#include "Headless/PresetBenchmark.h"
+
 #include "Layers/Layers.h"
 
 Application* CreateApplication() {
@@ -34,4 +39,38 @@ Application* CreateApplication() {
 	app->PushLayer(new MandelbrotLayer());
 
 	return app;
+}
+
+std::optional<int> RunHeadless(const CommandLine& commandLine) {
+	if (commandLine.GetCommand().empty()) {
+		return std::nullopt;
+	}
+
+	// Headless commands report on the standard output, so the log keeps to the warnings and errors unless asked otherwise
+	LogSpecification logSpecification;
+	logSpecification.WriteToFile = false;
+	Log::Init(logSpecification);
+
+	if (!commandLine.HasOption("verbose")) {
+		Log::SetLevel(Level::Warning);
+	}
+
+	SettingsManager::Load();
+	Log::SetAppName(SettingsManager::Get().Application.Name);
+
+	if (commandLine.GetCommand() == "render") {
+		return BatchRenderer::Run(commandLine);
+	}
+
+	if (commandLine.GetCommand() == "benchmark") {
+		return PresetBenchmark::Run(commandLine);
+	}
+
+	if (commandLine.GetCommand() == "parity") {
+		return ParityChecker::Run(commandLine);
+	}
+
+	Log::Error("RunHeadless - Unknown command '" + commandLine.GetCommand() + "'. Available commands: render, benchmark, parity");
+
+	return 1;
 }
\ No newline at end of file
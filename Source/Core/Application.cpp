@@ -1,6 +1,8 @@
 #include "Application.h"
 
+#include "Core/FrameTimings.h"
 #include "Core/Log.h"
+#include "Core/Profiler.h"
 
 #include "Core/Input/Input.h"
 #include "Core/Input/Cursor.h"
@@ -235,6 +237,8 @@ void Application::Run() {
 
 	// Main application loop that continues until the window should close or the application is signaled to stop running.
 	while (!glfwWindowShouldClose(m_WindowHandle) && m_Running) {
+		MB_PROFILE_SCOPE("Application::Run");
+
 		// Record the frame start time for frame-rate limiting.
 		double frameStart = glfwGetTime();
 
@@ -243,25 +247,45 @@ void Application::Run() {
 		Timestep timestep = time - m_LastFrameTime;
 		m_LastFrameTime = time;
 
+		// Start measuring the frame for the Statistics window.
+		FrameTimings::BeginFrame();
+
 		// Begin the UI frame, which will prepare for rendering the user interface for this frame.
 		UI::Begin();
 
 		for (Layer* layer : m_LayerStack) {
 			// Update each layer with the calculated timestep.
-			layer->OnUpdate(timestep);
+			{
+				MB_PROFILE_SCOPE("Layer::OnUpdate");
+				layer->OnUpdate(timestep);
+			}
 
-			// Render the UI for each layer.
-			layer->OnUIRender();
+			// Render the UI for each layer, timed apart from the update, which is where the frame is rendered.
+			const double uiStart = glfwGetTime();
+			{
+				MB_PROFILE_SCOPE("Layer::OnUIRender");
+				layer->OnUIRender();
+			}
+			FrameTimings::AddUITime((glfwGetTime() - uiStart) * 1000.0);
 		}
 
 		// End the UI frame, which will finalize the rendering of the user interface for this frame.
+		const double uiEndStart = glfwGetTime();
 		UI::End();
+		FrameTimings::AddUITime((glfwGetTime() - uiEndStart) * 1000.0);
 
 		// Update the input state at the end of the frame to ensure that input states are correctly updated for the next frame.
 		Input::OnUpdate();
 
+		// Read back the GPU time of the previous frames the GPU has finished, and stop measuring the CPU time of the frame before the swap waits for VSync.
+		Renderer::CollectTimings();
+		FrameTimings::EndFrame();
+
 		// Swap the front and back buffers to display the rendered frame and poll for input events to process user interactions.
-		glfwSwapBuffers(m_WindowHandle);
+		{
+			MB_PROFILE_SCOPE("Application::SwapBuffers");
+			glfwSwapBuffers(m_WindowHandle);
+		}
 
 		// Poll for and process input events, which will trigger the appropriate callbacks for key input, mouse input, and other events.
 		glfwPollEvents();
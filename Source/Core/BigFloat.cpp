@@ -0,0 +1,496 @@
+#include "BigFloat.h"
+
+#include <vector>
+
+uint32_t BigFloatArithmetic::Add(uint32_t* result, const uint32_t* a, const uint32_t* b, uint32_t count) {
+	uint64_t carry = 0;
+	for (uint32_t i = 0; i < count; ++i) {
+		carry += (uint64_t)a[i] + b[i];
+		result[i] = (uint32_t)carry;
+		carry >>= 32;
+	}
+
+	return (uint32_t)carry;
+}
+
+uint32_t BigFloatArithmetic::Subtract(uint32_t* result, const uint32_t* a, const uint32_t* b, uint32_t count) {
+	uint64_t borrow = 0;
+	for (uint32_t i = 0; i < count; ++i) {
+		const uint64_t difference = (uint64_t)a[i] - b[i] - borrow;
+		result[i] = (uint32_t)difference;
+		borrow = (difference >> 63) & 1;
+	}
+
+	return (uint32_t)borrow;
+}
+
+int BigFloatArithmetic::Compare(const uint32_t* a, const uint32_t* b, uint32_t count) {
+	for (uint32_t i = count; i-- > 0;) {
+		if (a[i] != b[i]) {
+			return a[i] > b[i] ? 1 : -1;
+		}
+	}
+
+	return 0;
+}
+
+void BigFloatArithmetic::ShiftLeft(uint32_t* limbs, uint32_t count, uint64_t bits) {
+	if (bits >= 32ull * count) {
+		std::fill_n(limbs, count, 0u);
+		return;
+	}
+
+	const uint32_t limbShift = (uint32_t)(bits / 32);
+	const uint32_t bitShift = (uint32_t)(bits % 32);
+
+	for (uint32_t i = count; i-- > 0;) {
+		uint32_t value = 0;
+		if (i >= limbShift) {
+			value = limbs[i - limbShift] << bitShift;
+			if (bitShift != 0 && i > limbShift) {
+				value |= limbs[i - limbShift - 1] >> (32 - bitShift);
+			}
+		}
+
+		limbs[i] = value;
+	}
+}
+
+void BigFloatArithmetic::ShiftRight(uint32_t* limbs, uint32_t count, uint64_t bits) {
+	if (bits >= 32ull * count) {
+		std::fill_n(limbs, count, 0u);
+		return;
+	}
+
+	const uint32_t limbShift = (uint32_t)(bits / 32);
+	const uint32_t bitShift = (uint32_t)(bits % 32);
+
+	for (uint32_t i = 0; i < count; ++i) {
+		uint32_t value = 0;
+		if (i + limbShift < count) {
+			value = limbs[i + limbShift] >> bitShift;
+			if (bitShift != 0 && i + limbShift + 1 < count) {
+				value |= limbs[i + limbShift + 1] << (32 - bitShift);
+			}
+		}
+
+		limbs[i] = value;
+	}
+}
+
+uint32_t BigFloatArithmetic::CountLeadingZeros(const uint32_t* limbs, uint32_t count) {
+	for (uint32_t i = count; i-- > 0;) {
+		if (limbs[i] != 0) {
+			uint32_t zeros = 0;
+			for (uint32_t value = limbs[i]; (value & 0x80000000u) == 0; value <<= 1) {
+				++zeros;
+			}
+
+			return 32 * (count - 1 - i) + zeros;
+		}
+	}
+
+	return 32 * count;
+}
+
+void BigFloatArithmetic::Multiply(uint32_t* result, const uint32_t* a, const uint32_t* b, uint32_t count, uint32_t* scratch) {
+	if (count >= KaratsubaThreshold) {
+		MultiplyKaratsuba(result, a, b, count, scratch);
+	} else {
+		MultiplySchoolbook(result, a, b, count);
+	}
+}
+
+void BigFloatArithmetic::MultiplySchoolbook(uint32_t* result, const uint32_t* a, const uint32_t* b, uint32_t count) {
+	std::fill_n(result, 2 * count, 0u);
+
+	for (uint32_t i = 0; i < count; ++i) {
+		uint64_t carry = 0;
+		for (uint32_t j = 0; j < count; ++j) {
+			carry += (uint64_t)a[i] * b[j] + result[i + j];
+			result[i + j] = (uint32_t)carry;
+			carry >>= 32;
+		}
+
+		result[i + count] = (uint32_t)carry;
+	}
+}
+
+// Adds 'value' ('valueCount' limbs) into 'target' ('targetCount' limbs), propagating the carry
+static void AddInto(uint32_t* target, uint32_t targetCount, const uint32_t* value, uint32_t valueCount) {
+	uint64_t carry = 0;
+	for (uint32_t i = 0; i < targetCount && (i < valueCount || carry != 0); ++i) {
+		carry += (uint64_t)target[i] + (i < valueCount ? value[i] : 0u);
+		target[i] = (uint32_t)carry;
+		carry >>= 32;
+	}
+}
+
+// Subtracts 'value' ('valueCount' limbs) from 'target' ('targetCount' limbs), propagating the borrow
+static void SubtractFrom(uint32_t* target, uint32_t targetCount, const uint32_t* value, uint32_t valueCount) {
+	uint64_t borrow = 0;
+	for (uint32_t i = 0; i < targetCount && (i < valueCount || borrow != 0); ++i) {
+		const uint64_t difference = (uint64_t)target[i] - (i < valueCount ? value[i] : 0u) - borrow;
+		target[i] = (uint32_t)difference;
+		borrow = (difference >> 63) & 1;
+	}
+}
+
+void BigFloatArithmetic::MultiplyKaratsuba(uint32_t* result, const uint32_t* a, const uint32_t* b, uint32_t count, uint32_t* scratch) {
+	if (count < KaratsubaThreshold) {
+		MultiplySchoolbook(result, a, b, count);
+		return;
+	}
+
+	// a = a1 * B^low + a0 and b = b1 * B^low + b0, with the high halves being the longest
+	const uint32_t low = count / 2;
+	const uint32_t high = count - low;
+
+	// z0 = a0 * b0 and z2 = a1 * b1 go straight into the result
+	MultiplyKaratsuba(result, a, b, low, scratch);
+	MultiplyKaratsuba(result + 2 * low, a + low, b + low, high, scratch);
+
+	// The sums of the halves, with their carries kept apart
+	uint32_t* sumA = scratch;
+	uint32_t* sumB = scratch + high;
+	uint32_t* middle = scratch + 2 * high;
+	uint32_t* next = middle + 2 * high + 2;
+
+	uint64_t carryA = 0, carryB = 0;
+	for (uint32_t i = 0; i < high; ++i) {
+		carryA += (uint64_t)a[low + i] + (i < low ? a[i] : 0u);
+		sumA[i] = (uint32_t)carryA;
+		carryA >>= 32;
+
+		carryB += (uint64_t)b[low + i] + (i < low ? b[i] : 0u);
+		sumB[i] = (uint32_t)carryB;
+		carryB >>= 32;
+	}
+
+	// z1 = (a0 + a1)(b0 + b1) - z0 - z2
+	MultiplyKaratsuba(middle, sumA, sumB, high, next);
+	middle[2 * high] = 0;
+	middle[2 * high + 1] = 0;
+
+	if (carryA != 0) {
+		AddInto(middle + high, high + 2, sumB, high);
+	}
+	if (carryB != 0) {
+		AddInto(middle + high, high + 2, sumA, high);
+	}
+	if (carryA != 0 && carryB != 0) {
+		const uint32_t one = 1;
+		AddInto(middle + 2 * high, 2, &one, 1);
+	}
+
+	SubtractFrom(middle, 2 * high + 2, result, 2 * low);
+	SubtractFrom(middle, 2 * high + 2, result + 2 * low, 2 * high);
+
+	AddInto(result + low, 2 * count - low, middle, std::min(2 * high + 2, 2 * count - low));
+}
+
+#pragma region - Decimal Conversion -
+
+// Arbitrary-size unsigned integers used by the decimal conversions, least significant limb first
+
+static void MultiplySmall(std::vector<uint32_t>& value, uint32_t factor) {
+	uint64_t carry = 0;
+	for (uint32_t& limb : value) {
+		carry += (uint64_t)limb * factor;
+		limb = (uint32_t)carry;
+		carry >>= 32;
+	}
+
+	if (carry != 0) {
+		value.push_back((uint32_t)carry);
+	}
+}
+
+static void AddSmall(std::vector<uint32_t>& value, uint32_t term) {
+	uint64_t carry = term;
+	for (size_t i = 0; i < value.size() && carry != 0; ++i) {
+		carry += value[i];
+		value[i] = (uint32_t)carry;
+		carry >>= 32;
+	}
+
+	if (carry != 0) {
+		value.push_back((uint32_t)carry);
+	}
+}
+
+static uint32_t DivideSmall(std::vector<uint32_t>& value, uint32_t divisor) {
+	uint64_t remainder = 0;
+	for (size_t i = value.size(); i-- > 0;) {
+		const uint64_t current = (remainder << 32) | value[i];
+		value[i] = (uint32_t)(current / divisor);
+		remainder = current % divisor;
+	}
+
+	while (!value.empty() && value.back() == 0) {
+		value.pop_back();
+	}
+
+	return (uint32_t)remainder;
+}
+
+static uint64_t GetBitLength(const std::vector<uint32_t>& value) {
+	if (value.empty()) {
+		return 0;
+	}
+
+	return 32ull * value.size() - BigFloatArithmetic::CountLeadingZeros(&value.back(), 1);
+}
+
+static void ShiftLeftBits(std::vector<uint32_t>& value, uint64_t bits) {
+	value.resize(value.size() + (size_t)(bits / 32) + 1, 0u);
+	BigFloatArithmetic::ShiftLeft(value.data(), (uint32_t)value.size(), bits);
+
+	while (!value.empty() && value.back() == 0) {
+		value.pop_back();
+	}
+}
+
+static void ShiftRightBits(std::vector<uint32_t>& value, uint64_t bits) {
+	if (!value.empty()) {
+		BigFloatArithmetic::ShiftRight(value.data(), (uint32_t)value.size(), bits);
+	}
+
+	while (!value.empty() && value.back() == 0) {
+		value.pop_back();
+	}
+}
+
+// Shifts right, rounding to nearest by adding half of the last discarded unit first
+static void RoundShiftRightBits(std::vector<uint32_t>& value, uint64_t bits) {
+	if (bits == 0) {
+		return;
+	}
+
+	std::vector<uint32_t> half(1, 1u);
+	ShiftLeftBits(half, bits - 1);
+
+	value.resize(std::max(value.size(), half.size()) + 1, 0u);
+	AddInto(value.data(), (uint32_t)value.size(), half.data(), (uint32_t)half.size());
+
+	ShiftRightBits(value, bits);
+}
+
+// Multiplies or divides by a power of a small base, in chunks that fit in a limb
+static void ScaleByPower(std::vector<uint32_t>& value, uint32_t base, uint32_t chunk, uint32_t chunkPower, int64_t power) {
+	const bool divide = power < 0;
+	uint64_t remaining = (uint64_t)(divide ? -power : power);
+
+	while (remaining > 0) {
+		uint32_t factor = chunk;
+		if (remaining < chunkPower) {
+			factor = 1;
+			for (uint64_t i = 0; i < remaining; ++i) {
+				factor *= base;
+			}
+		}
+
+		if (divide) {
+			DivideSmall(value, factor);
+		} else {
+			MultiplySmall(value, factor);
+		}
+
+		remaining -= std::min<uint64_t>(remaining, chunkPower);
+	}
+}
+
+std::string BigFloatArithmetic::ToString(const uint32_t* mantissa, uint32_t count, int64_t exponent, bool negative, uint32_t digits) {
+	if (CountLeadingZeros(mantissa, count) == 32 * count) {
+		return "0";
+	}
+
+	digits = std::max(digits, 1u);
+
+	// The value is M * 2^e; estimate its decimal exponent from the leading bits
+	const int64_t binaryExponent = exponent - 32 * (int64_t)count;
+	const double leading = ((double)mantissa[count - 1] + (double)mantissa[count - 2] / 4294967296.0) / 4294967296.0;
+	const int64_t estimate = (int64_t)std::floor(std::log10(leading) + (double)exponent * 0.30102999566398120);
+
+	// Compute N = round(value * 10^p), an integer of about 'digits' decimal digits and a guard digit, as M * 5^p * 2^(e + p)
+	const int64_t p = (int64_t)digits - estimate;
+	std::vector<uint32_t> integer(mantissa, mantissa + count);
+	int64_t shift = binaryExponent + p;
+
+	if (p < 0) {
+		// Keep enough bits below the point for the divisions by 5
+		const uint64_t guard = (uint64_t)(-p) * 3 + 64;
+		ShiftLeftBits(integer, guard);
+		shift -= (int64_t)guard;
+	}
+
+	ScaleByPower(integer, 5, 1220703125u, 13, p);
+
+	if (shift >= 0) {
+		ShiftLeftBits(integer, (uint64_t)shift);
+	} else {
+		RoundShiftRightBits(integer, (uint64_t)(-shift));
+	}
+
+	std::string decimal;
+	while (!integer.empty()) {
+		uint32_t chunk = DivideSmall(integer, 1000000000u);
+		for (int i = 0; i < 9; ++i) {
+			decimal.push_back((char)('0' + chunk % 10));
+			chunk /= 10;
+		}
+	}
+
+	while (decimal.size() > 1 && decimal.back() == '0') {
+		decimal.pop_back();
+	}
+	std::reverse(decimal.begin(), decimal.end());
+
+	// The estimate may be off by one, which only changes the number of digits produced
+	int64_t decimalExponent = (int64_t)decimal.size() - 1 - p;
+
+	// The digits past the requested ones round the last one half-up, carrying into those before it
+	if (decimal.size() > digits) {
+		const bool roundUp = decimal[digits] >= '5';
+		decimal.resize(digits);
+
+		if (roundUp) {
+			size_t i = digits;
+			while (i > 0 && decimal[i - 1] == '9') {
+				decimal[--i] = '0';
+			}
+
+			// A carry out of the leading digit (like 9.99 rounding to 10.0) adds a digit in front
+			if (i == 0) {
+				decimal.insert(decimal.begin(), '1');
+				decimal.pop_back();
+				++decimalExponent;
+			} else {
+				++decimal[i - 1];
+			}
+		}
+	}
+
+	while (decimal.size() > 1 && decimal.back() == '0') {
+		decimal.pop_back();
+	}
+
+	std::string text = negative ? "-" : "";
+
+	if (decimalExponent >= -6 && decimalExponent < 21) {
+		// Fixed notation
+		if (decimalExponent < 0) {
+			text += "0." + std::string((size_t)(-decimalExponent - 1), '0') + decimal;
+		} else if ((int64_t)decimal.size() <= decimalExponent + 1) {
+			text += decimal + std::string((size_t)(decimalExponent + 1 - (int64_t)decimal.size()), '0');
+		} else {
+			text += decimal.substr(0, (size_t)decimalExponent + 1) + "." + decimal.substr((size_t)decimalExponent + 1);
+		}
+	} else {
+		// Scientific notation
+		text += decimal.substr(0, 1);
+		if (decimal.size() > 1) {
+			text += "." + decimal.substr(1);
+		}
+		text += "e" + std::to_string(decimalExponent);
+	}
+
+	return text;
+}
+
+bool BigFloatArithmetic::FromString(const std::string& text, uint32_t* mantissa, uint32_t count, int64_t& exponent, bool& negative) {
+	size_t position = text.find_first_not_of(" \t");
+	if (position == std::string::npos) {
+		return false;
+	}
+
+	negative = false;
+	if (text[position] == '-' || text[position] == '+') {
+		negative = text[position] == '-';
+		++position;
+	}
+
+	std::vector<uint32_t> integer;
+	int64_t decimalExponent = 0;
+	bool hasDigits = false, hasPoint = false;
+
+	for (; position < text.size(); ++position) {
+		const char c = text[position];
+
+		if (c >= '0' && c <= '9') {
+			MultiplySmall(integer, 10);
+			AddSmall(integer, (uint32_t)(c - '0'));
+			hasDigits = true;
+
+			if (hasPoint) {
+				--decimalExponent;
+			}
+		} else if (c == '.' && !hasPoint) {
+			hasPoint = true;
+		} else {
+			break;
+		}
+	}
+
+	if (!hasDigits) {
+		return false;
+	}
+
+	if (position < text.size() && (text[position] == 'e' || text[position] == 'E')) {
+		size_t parsed = 0;
+		try {
+			decimalExponent += std::stoll(text.substr(position + 1), &parsed);
+		} catch (...) {
+			return false;
+		}
+
+		position += 1 + parsed;
+	}
+
+	if (text.find_first_not_of(" \t", position) != std::string::npos) {
+		return false;
+	}
+
+	while (!integer.empty() && integer.back() == 0) {
+		integer.pop_back();
+	}
+
+	std::fill_n(mantissa, count, 0u);
+	exponent = 0;
+
+	if (integer.empty()) {
+		negative = false;
+		return true;
+	}
+
+	// value = N * 10^d; for negative powers, N is scaled up by 2^guard first so the divisions keep the full precision
+	int64_t binaryExponent = 0;
+	if (decimalExponent < 0) {
+		const uint64_t guard = 32ull * count + (uint64_t)(-decimalExponent) * 4 + 64;
+		ShiftLeftBits(integer, guard);
+		binaryExponent = -(int64_t)guard;
+	}
+
+	ScaleByPower(integer, 10, 1000000000u, 9, decimalExponent);
+
+	// Keep the 32 * count most significant bits, rounded to nearest
+	uint64_t bitLength = GetBitLength(integer);
+	if (bitLength > 32ull * count) {
+		RoundShiftRightBits(integer, bitLength - 32ull * count);
+
+		// Rounding up may carry into a new bit
+		if (GetBitLength(integer) > 32ull * count) {
+			ShiftRightBits(integer, 1);
+			++bitLength;
+		}
+	} else {
+		ShiftLeftBits(integer, 32ull * count - bitLength);
+	}
+
+	std::copy_n(integer.begin(), std::min<size_t>(integer.size(), count), mantissa);
+	exponent = (int64_t)bitLength + binaryExponent;
+
+	return true;
+}
+
+#pragma endregion
@@ -0,0 +1,390 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+/**
+ * The limb-level routines shared by every `BigFloat` precision.
+ *
+ * Limbs are 32-bit unsigned integers stored least significant first, so products fit in 64 bits on every compiler.
+ */
+class BigFloatArithmetic {
+public:
+	/// @brief Operands of at least this many limbs are multiplied with Karatsuba, smaller ones with the schoolbook algorithm.
+	static constexpr uint32_t KaratsubaThreshold = 24;
+
+	/**
+	 * Gets the number of scratch limbs `Multiply` needs for operands of `count` limbs.
+	 */
+	static constexpr uint32_t GetScratchSize(uint32_t count) { return 8 * count + 64; }
+
+	/**
+	 * Adds two numbers of `count` limbs. `result` may alias either operand.
+	 *
+	 * @return The carry out of the most significant limb.
+	 */
+	static uint32_t Add(uint32_t* result, const uint32_t* a, const uint32_t* b, uint32_t count);
+
+	/**
+	 * Subtracts `b` from `a`, both `count` limbs long. `result` may alias either operand.
+	 *
+	 * @return The borrow out of the most significant limb.
+	 */
+	static uint32_t Subtract(uint32_t* result, const uint32_t* a, const uint32_t* b, uint32_t count);
+
+	/**
+	 * Compares two numbers of `count` limbs.
+	 *
+	 * @return A negative value if `a < b`, zero if they are equal, and a positive value if `a > b`.
+	 */
+	static int Compare(const uint32_t* a, const uint32_t* b, uint32_t count);
+
+	/**
+	 * Shifts a number of `count` limbs in place. Bits shifted out are lost, and the shift may exceed the width of the number.
+	 */
+	static void ShiftLeft(uint32_t* limbs, uint32_t count, uint64_t bits);
+	static void ShiftRight(uint32_t* limbs, uint32_t count, uint64_t bits);
+
+	/**
+	 * Counts the leading zero bits of a number of `count` limbs.
+	 *
+	 * @return The number of leading zero bits, `32 * count` for zero.
+	 */
+	static uint32_t CountLeadingZeros(const uint32_t* limbs, uint32_t count);
+
+	/**
+	 * Computes the full `2 * count` limbs product of two numbers of `count` limbs.
+	 *
+	 * @param result The product, `2 * count` limbs long. It must not alias the operands.
+	 * @param a The first operand.
+	 * @param b The second operand.
+	 * @param count The number of limbs of the operands.
+	 * @param scratch A temporary buffer of `GetScratchSize(count)` limbs.
+	 */
+	static void Multiply(uint32_t* result, const uint32_t* a, const uint32_t* b, uint32_t count, uint32_t* scratch);
+
+	/**
+	 * Formats the number `(-1)^negative * mantissa * 2^(exponent - 32 * count)` in decimal.
+	 *
+	 * @param digits The number of significant digits to print.
+	 * @return The decimal representation, in fixed notation for moderate magnitudes and in scientific notation otherwise.
+	 */
+	static std::string ToString(const uint32_t* mantissa, uint32_t count, int64_t exponent, bool negative, uint32_t digits);
+
+	/**
+	 * Parses a decimal number (like `-0.75`, `1.25e-40` or `3`) into a normalized mantissa of `count` limbs and its exponent.
+	 *
+	 * @return `true` if the text is a valid number, `false` otherwise.
+	 */
+	static bool FromString(const std::string& text, uint32_t* mantissa, uint32_t count, int64_t& exponent, bool& negative);
+private:
+	static void MultiplySchoolbook(uint32_t* result, const uint32_t* a, const uint32_t* b, uint32_t count);
+	static void MultiplyKaratsuba(uint32_t* result, const uint32_t* a, const uint32_t* b, uint32_t count, uint32_t* scratch);
+};
+
+/**
+ * A binary floating-point number with `Limbs` 32-bit limbs of mantissa, fixed at compile time, and a 64-bit exponent.
+ *
+ * The value is `(-1)^sign * 0.mantissa * 2^exponent`, with the mantissa normalized so its most significant bit is set (or entirely zero for `0`).
+ * Every operation works on fixed-size arrays, without any heap allocation, and results are truncated to the precision of the type.
+ *
+ * @tparam Limbs The number of 32-bit limbs of the mantissa. The precision is `32 * Limbs` bits.
+ */
+template<uint32_t Limbs>
+class BigFloat {
+	static_assert(Limbs >= 2, "BigFloat needs at least 64 bits of mantissa to hold a double exactly");
+public:
+	/// @brief The precision of the mantissa, in bits.
+	static constexpr uint32_t Bits = 32 * Limbs;
+
+	BigFloat() = default;
+
+	BigFloat(double value) {
+		if (value == 0.0 || !std::isfinite(value)) {
+			return;
+		}
+
+		int exponent = 0;
+		const double mantissa = std::frexp(std::abs(value), &exponent);
+		const uint64_t bits = (uint64_t)std::ldexp(mantissa, 64);
+
+		m_Mantissa[Limbs - 1] = (uint32_t)(bits >> 32);
+		m_Mantissa[Limbs - 2] = (uint32_t)bits;
+		m_Exponent = exponent;
+		m_Negative = value < 0.0;
+	}
+
+	/**
+	 * Converts from another precision, truncating the mantissa if it is narrower.
+	 */
+	template<uint32_t OtherLimbs>
+	explicit BigFloat(const BigFloat<OtherLimbs>& other) {
+		const uint32_t count = Limbs < OtherLimbs ? Limbs : OtherLimbs;
+		for (uint32_t i = 0; i < count; ++i) {
+			m_Mantissa[Limbs - 1 - i] = other.GetMantissa()[OtherLimbs - 1 - i];
+		}
+
+		m_Exponent = other.GetExponent();
+		m_Negative = other.IsNegative();
+	}
+
+	explicit operator double() const {
+		if (IsZero()) {
+			return 0.0;
+		}
+
+		const uint64_t bits = ((uint64_t)m_Mantissa[Limbs - 1] << 32) | m_Mantissa[Limbs - 2];
+		const double magnitude = std::ldexp((double)bits, (int)std::clamp<int64_t>(m_Exponent - 64, -4096, 4096));
+
+		return m_Negative ? -magnitude : magnitude;
+	}
+
+	bool IsZero() const { return m_Mantissa[Limbs - 1] == 0; }
+	bool IsNegative() const { return m_Negative; }
+
+	const uint32_t* GetMantissa() const { return m_Mantissa; }
+	int64_t GetExponent() const { return m_Exponent; }
+
+	/**
+	 * Multiplies the number by `2^power`, exactly.
+	 */
+	BigFloat MultiplyByPowerOfTwo(int64_t power) const {
+		BigFloat result = *this;
+		if (!result.IsZero()) {
+			result.m_Exponent += power;
+		}
+
+		return result;
+	}
+
+	/**
+	 * Formats the number in decimal.
+	 *
+	 * @param digits The number of significant digits. `0` prints every digit the precision of the type can resolve.
+	 * @return The decimal representation of the number.
+	 */
+	std::string ToString(uint32_t digits = 0) const {
+		if (digits == 0) {
+			digits = (uint32_t)std::ceil(Bits * 0.30102999566398120) + 1;
+		}
+
+		return BigFloatArithmetic::ToString(m_Mantissa, Limbs, m_Exponent, m_Negative, digits);
+	}
+
+	/**
+	 * Parses a decimal number.
+	 *
+	 * @param text The number, in fixed or scientific notation.
+	 * @param value The parsed value. Left untouched if the text is not a valid number.
+	 * @return `true` if the text was parsed, `false` otherwise.
+	 */
+	static bool FromString(const std::string& text, BigFloat& value) {
+		BigFloat parsed;
+		if (!BigFloatArithmetic::FromString(text, parsed.m_Mantissa, Limbs, parsed.m_Exponent, parsed.m_Negative)) {
+			return false;
+		}
+
+		value = parsed;
+		return true;
+	}
+
+	BigFloat operator-() const {
+		BigFloat result = *this;
+		if (!result.IsZero()) {
+			result.m_Negative = !result.m_Negative;
+		}
+
+		return result;
+	}
+
+	friend BigFloat operator+(const BigFloat& a, const BigFloat& b) {
+		if (a.IsZero()) return b;
+		if (b.IsZero()) return a;
+
+		if (a.m_Negative == b.m_Negative) {
+			return AddMagnitudes(a, b);
+		}
+
+		// Opposite signs: subtract the smaller magnitude from the larger one, which gives its sign to the result
+		return CompareMagnitudes(a, b) >= 0 ? SubtractMagnitudes(a, b) : SubtractMagnitudes(b, a);
+	}
+
+	friend BigFloat operator-(const BigFloat& a, const BigFloat& b) {
+		return a + (-b);
+	}
+
+	friend BigFloat operator*(const BigFloat& a, const BigFloat& b) {
+		if (a.IsZero() || b.IsZero()) {
+			return BigFloat();
+		}
+
+		uint32_t product[2 * Limbs];
+		uint32_t scratch[BigFloatArithmetic::GetScratchSize(Limbs)];
+		BigFloatArithmetic::Multiply(product, a.m_Mantissa, b.m_Mantissa, Limbs, scratch);
+
+		BigFloat result;
+		result.m_Exponent = a.m_Exponent + b.m_Exponent;
+		result.m_Negative = a.m_Negative != b.m_Negative;
+
+		// The product of two mantissas in [0.5, 1) lies in [0.25, 1), so it needs at most one bit of normalization
+		if ((product[2 * Limbs - 1] & 0x80000000u) == 0) {
+			BigFloatArithmetic::ShiftLeft(product, 2 * Limbs, 1);
+			result.m_Exponent -= 1;
+		}
+
+		for (uint32_t i = 0; i < Limbs; ++i) {
+			result.m_Mantissa[i] = product[Limbs + i];
+		}
+
+		return result;
+	}
+
+	friend BigFloat operator*(const BigFloat& a, double b) { return a * BigFloat(b); }
+	friend BigFloat operator*(double a, const BigFloat& b) { return BigFloat(a) * b; }
+
+	BigFloat& operator+=(const BigFloat& other) { return *this = *this + other; }
+	BigFloat& operator-=(const BigFloat& other) { return *this = *this - other; }
+	BigFloat& operator*=(const BigFloat& other) { return *this = *this * other; }
+
+	friend bool operator==(const BigFloat& a, const BigFloat& b) {
+		return a.m_Negative == b.m_Negative && a.m_Exponent == b.m_Exponent && BigFloatArithmetic::Compare(a.m_Mantissa, b.m_Mantissa, Limbs) == 0;
+	}
+
+	friend bool operator!=(const BigFloat& a, const BigFloat& b) { return !(a == b); }
+
+	friend bool operator<(const BigFloat& a, const BigFloat& b) {
+		if (a.m_Negative != b.m_Negative) {
+			return a.m_Negative;
+		}
+
+		const int comparison = CompareMagnitudes(a, b);
+		return a.m_Negative ? comparison > 0 : comparison < 0;
+	}
+private:
+	static int CompareMagnitudes(const BigFloat& a, const BigFloat& b) {
+		if (a.IsZero() || b.IsZero()) {
+			return (int)!a.IsZero() - (int)!b.IsZero();
+		}
+
+		if (a.m_Exponent != b.m_Exponent) {
+			return a.m_Exponent > b.m_Exponent ? 1 : -1;
+		}
+
+		return BigFloatArithmetic::Compare(a.m_Mantissa, b.m_Mantissa, Limbs);
+	}
+
+	/**
+	 * Copies the mantissas of `a` and `b` into buffers with one extra guard limb, aligning `b` to the exponent of `a`.
+	 *
+	 * @return `false` if `b` is too small to affect `a`.
+	 */
+	static bool Align(const BigFloat& a, const BigFloat& b, uint32_t* alignedA, uint32_t* alignedB) {
+		const int64_t shift = a.m_Exponent - b.m_Exponent;
+		if (shift >= (int64_t)(Bits + 32)) {
+			return false;
+		}
+
+		alignedA[0] = 0;
+		alignedB[0] = 0;
+		for (uint32_t i = 0; i < Limbs; ++i) {
+			alignedA[i + 1] = a.m_Mantissa[i];
+			alignedB[i + 1] = b.m_Mantissa[i];
+		}
+
+		BigFloatArithmetic::ShiftRight(alignedB, Limbs + 1, (uint64_t)shift);
+		return true;
+	}
+
+	static BigFloat AddMagnitudes(const BigFloat& a, const BigFloat& b) {
+		if (a.m_Exponent < b.m_Exponent) {
+			return AddMagnitudes(b, a);
+		}
+
+		uint32_t sum[Limbs + 1], aligned[Limbs + 1];
+		if (!Align(a, b, sum, aligned)) {
+			return a;
+		}
+
+		BigFloat result;
+		result.m_Exponent = a.m_Exponent;
+		result.m_Negative = a.m_Negative;
+
+		if (BigFloatArithmetic::Add(sum, sum, aligned, Limbs + 1) != 0) {
+			BigFloatArithmetic::ShiftRight(sum, Limbs + 1, 1);
+			sum[Limbs] |= 0x80000000u;
+			result.m_Exponent += 1;
+		}
+
+		for (uint32_t i = 0; i < Limbs; ++i) {
+			result.m_Mantissa[i] = sum[i + 1];
+		}
+
+		return result;
+	}
+
+	// Requires |a| >= |b|, and gives the sign of 'a' to the result
+	static BigFloat SubtractMagnitudes(const BigFloat& a, const BigFloat& b) {
+		uint32_t difference[Limbs + 1], aligned[Limbs + 1];
+		if (!Align(a, b, difference, aligned)) {
+			return a;
+		}
+
+		BigFloatArithmetic::Subtract(difference, difference, aligned, Limbs + 1);
+
+		const uint32_t leadingZeros = BigFloatArithmetic::CountLeadingZeros(difference, Limbs + 1);
+		if (leadingZeros == 32 * (Limbs + 1)) {
+			return BigFloat();
+		}
+
+		BigFloatArithmetic::ShiftLeft(difference, Limbs + 1, leadingZeros);
+
+		BigFloat result;
+		result.m_Exponent = a.m_Exponent - leadingZeros;
+		result.m_Negative = a.m_Negative;
+
+		for (uint32_t i = 0; i < Limbs; ++i) {
+			result.m_Mantissa[i] = difference[i + 1];
+		}
+
+		return result;
+	}
+private:
+	/// @brief The mantissa, least significant limb first.
+	uint32_t m_Mantissa[Limbs] = {};
+
+	/// @brief The binary exponent, such that the value is `0.mantissa * 2^exponent`.
+	int64_t m_Exponent = 0;
+
+	bool m_Negative = false;
+};
+
+/// @brief The precision of the view center: 1024 bits (about 308 decimal digits), more than the deepest zoom perturbation can render needs.
+using BigReal = BigFloat<32>;
+
+/**
+ * A point of the complex plane in `BigReal` precision, used for the view center.
+ */
+struct BigVec2 {
+	BigReal x, y;
+
+	BigVec2() = default;
+	BigVec2(double x, double y) : x(x), y(y) {}
+	BigVec2(const glm::dvec2& value) : x(value.x), y(value.y) {}
+	BigVec2(const BigReal& x, const BigReal& y) : x(x), y(y) {}
+
+	explicit operator glm::dvec2() const { return glm::dvec2((double)x, (double)y); }
+
+	friend BigVec2 operator+(const BigVec2& a, const BigVec2& b) { return BigVec2(a.x + b.x, a.y + b.y); }
+	friend BigVec2 operator-(const BigVec2& a, const BigVec2& b) { return BigVec2(a.x - b.x, a.y - b.y); }
+	friend BigVec2 operator*(const BigVec2& a, double b) { const BigReal scale(b); return BigVec2(a.x * scale, a.y * scale); }
+
+	BigVec2& operator+=(const BigVec2& other) { return *this = *this + other; }
+	BigVec2& operator-=(const BigVec2& other) { return *this = *this - other; }
+
+	friend bool operator==(const BigVec2& a, const BigVec2& b) { return a.x == b.x && a.y == b.y; }
+	friend bool operator!=(const BigVec2& a, const BigVec2& b) { return !(a == b); }
+};
@@ -0,0 +1,133 @@
+#include "CPUFeatures.h"
+
+#include "Core/Log.h"
+
+#include "Utilities/Utilities.h"
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+	#include <cpuid.h>
+#endif
+
+struct DetectedFeatures {
+	bool SSE2 = false;
+	bool AVX2 = false;
+	bool AVX512 = false;
+};
+
+static void CPUID(uint32_t leaf, uint32_t subleaf, uint32_t registers[4]) {
+#if defined(_MSC_VER)
+	int values[4];
+	__cpuidex(values, (int)leaf, (int)subleaf);
+	for (int i = 0; i < 4; ++i) {
+		registers[i] = (uint32_t)values[i];
+	}
+#elif defined(__x86_64__) || defined(__i386__)
+	__cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#else
+	registers[0] = registers[1] = registers[2] = registers[3] = 0;
+#endif
+}
+
+// Reads the XCR0 register, which tells which register states the OS saves on context switches
+static uint64_t ReadXCR0() {
+#if defined(_MSC_VER)
+	return _xgetbv(0);
+#elif defined(__x86_64__) || defined(__i386__)
+	uint32_t eax, edx;
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return ((uint64_t)edx << 32) | eax;
+#else
+	return 0;
+#endif
+}
+
+static DetectedFeatures Detect() {
+	DetectedFeatures features;
+
+	uint32_t registers[4] = {};
+	CPUID(0, 0, registers);
+	const uint32_t maxLeaf = registers[0];
+
+	if (maxLeaf < 1) {
+		return features;
+	}
+
+	CPUID(1, 0, registers);
+	const uint32_t ecx1 = registers[2];
+	const uint32_t edx1 = registers[3];
+
+	features.SSE2 = (edx1 & (1u << 26)) != 0;
+
+	const bool osxsave = (ecx1 & (1u << 27)) != 0;
+	const bool fma = (ecx1 & (1u << 12)) != 0;
+	if (!osxsave || maxLeaf < 7) {
+		return features;
+	}
+
+	const uint64_t xcr0 = ReadXCR0();
+	// XMM and YMM state
+	const bool osAVX = (xcr0 & 0x6) == 0x6;
+	// Opmask, upper ZMM0-15 and ZMM16-31 state
+	const bool osAVX512 = osAVX && (xcr0 & 0xE0) == 0xE0;
+
+	CPUID(7, 0, registers);
+	const uint32_t ebx7 = registers[1];
+
+	features.AVX2 = osAVX && fma && (ebx7 & (1u << 5)) != 0;
+	features.AVX512 = osAVX512 && features.AVX2 && (ebx7 & (1u << 16)) != 0;
+
+	return features;
+}
+
+static const DetectedFeatures& GetFeatures() {
+	static const DetectedFeatures features = []() {
+		DetectedFeatures detected = Detect();
+		Log::Info(std::string("CPUFeatures - SSE2: ") + (detected.SSE2 ? "Yes" : "No") + ", AVX2: " + (detected.AVX2 ? "Yes" : "No") + ", AVX-512: " + (detected.AVX512 ? "Yes" : "No"));
+		return detected;
+	}();
+
+	return features;
+}
+
+bool CPUFeatures::Supports(InstructionSet instructionSet) {
+	const auto& features = GetFeatures();
+
+	switch (instructionSet) {
+		case InstructionSet::Auto:
+		case InstructionSet::Scalar:	return true;
+		case InstructionSet::SSE2:		return features.SSE2;
+		case InstructionSet::AVX2:		return features.AVX2;
+		case InstructionSet::AVX512:	return features.AVX512;
+		default:						return false;
+	}
+}
+
+InstructionSet CPUFeatures::GetBestInstructionSet() {
+	if (Supports(InstructionSet::AVX512))	return InstructionSet::AVX512;
+	if (Supports(InstructionSet::AVX2))		return InstructionSet::AVX2;
+	if (Supports(InstructionSet::SSE2))		return InstructionSet::SSE2;
+
+	return InstructionSet::Scalar;
+}
+
+InstructionSet CPUFeatures::Resolve(InstructionSet requested) {
+	if (requested == InstructionSet::Auto) {
+		return GetBestInstructionSet();
+	}
+
+	// Walk down the levels until we find one the processor supports
+	InstructionSet resolved = requested;
+	while (resolved != InstructionSet::Scalar && !Supports(resolved)) {
+		resolved = static_cast<InstructionSet>(static_cast<int>(resolved) - 1);
+	}
+
+	if (resolved != requested) {
+		Log::Warning("CPUFeatures::Resolve - " + Utilities::InstructionSetToString(requested) + " is not supported, falling back to " + Utilities::InstructionSetToString(resolved));
+	}
+
+	return resolved;
+}
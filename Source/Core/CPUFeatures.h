@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Core/Settings/Settings.h"
+
+/**
+ * Queries the processor (through `cpuid`) for the SIMD instruction sets it supports.
+ *
+ * Detection runs once, the first time any of these functions is called, and also checks that the operating system saves the wider vector registers on context switches.
+ */
+class CPUFeatures {
+public:
+	/**
+	 * Checks whether the processor and the operating system support the given instruction set.
+	 *
+	 * @param instructionSet The instruction set to check. `Auto` and `Scalar` are always supported.
+	 * @return `true` if the instruction set can be used, `false` otherwise.
+	 */
+	static bool Supports(InstructionSet instructionSet);
+
+	/**
+	 * Gets the widest instruction set supported by the processor.
+	 *
+	 * @return The best supported instruction set. Never returns `Auto`.
+	 */
+	static InstructionSet GetBestInstructionSet();
+
+	/**
+	 * Resolves a requested instruction set to the one that will actually be used.
+	 *
+	 * `Auto` resolves to the best supported instruction set, and unsupported requests fall back to the widest supported level below them.
+	 *
+	 * @param requested The requested instruction set, usually coming from the settings.
+	 * @return The instruction set to use. Never returns `Auto`.
+	 */
+	static InstructionSet Resolve(InstructionSet requested);
+};
@@ -0,0 +1,56 @@
+#include "CommandLine.h"
+
+#include "Core/Log.h"
+
+CommandLine::CommandLine(int argc, char** argv) {
+	for (int i = 1; i < argc; ++i) {
+		const std::string argument = argv[i];
+
+		if (argument.starts_with("--")) {
+			const size_t separator = argument.find('=');
+
+			if (separator == std::string::npos) {
+				m_Options[argument.substr(2)] = "";
+			} else {
+				m_Options[argument.substr(2, separator - 2)] = argument.substr(separator + 1);
+			}
+		} else if (m_Command.empty()) {
+			m_Command = argument;
+		} else {
+			m_Arguments.push_back(argument);
+		}
+	}
+}
+
+std::string CommandLine::GetOption(const std::string& name, const std::string& fallback) const {
+	const auto it = m_Options.find(name);
+	return it != m_Options.end() ? it->second : fallback;
+}
+
+int CommandLine::GetInt(const std::string& name, int fallback) const {
+	const auto it = m_Options.find(name);
+	if (it == m_Options.end()) {
+		return fallback;
+	}
+
+	try {
+		return std::stoi(it->second);
+	} catch (const std::exception&) {
+		Log::Warning("CommandLine::GetInt - '--" + name + "' expects a number, got '" + it->second + "'");
+		return fallback;
+	}
+}
+
+float CommandLine::GetFloat(const std::string& name, float fallback) const {
+	const auto it = m_Options.find(name);
+	if (it == m_Options.end()) {
+		return fallback;
+	}
+
+	try {
+		return std::stof(it->second);
+	} catch (const std::exception&) {
+		Log::Warning("CommandLine::GetFloat - '--" + name + "' expects a number, got '" + it->second + "'");
+		return fallback;
+	}
+}
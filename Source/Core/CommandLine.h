@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The arguments the application was started with, split into options and positional arguments.
+ *
+ * Options start with `--`: `--name=value` gives an option a value, while `--name` alone is a flag.
+ * The first positional argument is the command, which selects a headless mode of the application (like `render`); without one, the editor starts.
+ */
+class CommandLine {
+public:
+	CommandLine(int argc, char** argv);
+
+	/**
+	 * Gets the command, or an empty string when the application was started without one.
+	 */
+	const std::string& GetCommand() const { return m_Command; }
+
+	/**
+	 * Gets the positional arguments following the command.
+	 */
+	const std::vector<std::string>& GetArguments() const { return m_Arguments; }
+
+	/**
+	 * Checks whether an option was given, with or without a value.
+	 *
+	 * @param name The name of the option, without the leading `--`.
+	 */
+	bool HasOption(const std::string& name) const { return m_Options.contains(name); }
+
+	/**
+	 * Gets the value of an option.
+	 *
+	 * @param name The name of the option, without the leading `--`.
+	 * @param fallback The value returned when the option was not given.
+	 */
+	std::string GetOption(const std::string& name, const std::string& fallback = "") const;
+
+	/**
+	 * Gets the value of an option as an integer, or `fallback` when it was not given or is not a number.
+	 */
+	int GetInt(const std::string& name, int fallback) const;
+
+	/**
+	 * Gets the value of an option as a float, or `fallback` when it was not given or is not a number.
+	 */
+	float GetFloat(const std::string& name, float fallback) const;
+private:
+	std::string m_Command;
+	std::vector<std::string> m_Arguments;
+	std::unordered_map<std::string, std::string> m_Options;
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cmath>
+
+/**
+ * An unevaluated sum of two doubles (`Hi + Lo`, with `|Lo| <= ulp(Hi) / 2`), giving about 106 bits (32 decimal digits) of precision.
+ *
+ * The operations are built on error-free transformations, so they require strict IEEE-754 double arithmetic:
+ * the project must not be compiled with fast-math style floating point options.
+ */
+struct DoubleDouble {
+	double Hi = 0.0;
+	double Lo = 0.0;
+
+	constexpr DoubleDouble() = default;
+	constexpr DoubleDouble(double value) : Hi(value), Lo(0.0) {}
+	constexpr DoubleDouble(double hi, double lo) : Hi(hi), Lo(lo) {}
+
+	explicit operator double() const { return Hi + Lo; }
+
+	/**
+	 * Computes `a + b` exactly, as a rounded sum and its rounding error (Knuth's TwoSum).
+	 */
+	static DoubleDouble TwoSum(double a, double b) {
+		const double sum = a + b;
+		const double bb = sum - a;
+		const double error = (a - (sum - bb)) + (b - bb);
+
+		return DoubleDouble(sum, error);
+	}
+
+	/**
+	 * Computes `a + b` exactly when `|a| >= |b|` (Dekker's FastTwoSum).
+	 */
+	static DoubleDouble QuickTwoSum(double a, double b) {
+		const double sum = a + b;
+
+		return DoubleDouble(sum, b - (sum - a));
+	}
+
+	/**
+	 * Computes `a * b` exactly, as a rounded product and its rounding error, using a fused multiply-add.
+	 */
+	static DoubleDouble TwoProduct(double a, double b) {
+		const double product = a * b;
+
+		return DoubleDouble(product, std::fma(a, b, -product));
+	}
+
+	DoubleDouble operator-() const { return DoubleDouble(-Hi, -Lo); }
+
+	friend DoubleDouble operator+(const DoubleDouble& a, const DoubleDouble& b) {
+		DoubleDouble s = TwoSum(a.Hi, b.Hi);
+		const DoubleDouble t = TwoSum(a.Lo, b.Lo);
+
+		s.Lo += t.Hi;
+		s = QuickTwoSum(s.Hi, s.Lo);
+		s.Lo += t.Lo;
+
+		return QuickTwoSum(s.Hi, s.Lo);
+	}
+
+	friend DoubleDouble operator-(const DoubleDouble& a, const DoubleDouble& b) {
+		return a + (-b);
+	}
+
+	friend DoubleDouble operator*(const DoubleDouble& a, const DoubleDouble& b) {
+		DoubleDouble p = TwoProduct(a.Hi, b.Hi);
+		p.Lo += a.Hi * b.Lo + a.Lo * b.Hi;
+
+		return QuickTwoSum(p.Hi, p.Lo);
+	}
+
+	friend DoubleDouble operator*(const DoubleDouble& a, double b) {
+		DoubleDouble p = TwoProduct(a.Hi, b);
+		p.Lo += a.Lo * b;
+
+		return QuickTwoSum(p.Hi, p.Lo);
+	}
+
+	DoubleDouble& operator+=(const DoubleDouble& other) { return *this = *this + other; }
+	DoubleDouble& operator-=(const DoubleDouble& other) { return *this = *this - other; }
+	DoubleDouble& operator*=(const DoubleDouble& other) { return *this = *this * other; }
+};
@@ -1,13 +1,43 @@
 #pragma once
 
+#include "Core/CommandLine.h"
+#include "Core/Profiler.h"
+
+#include <optional>
+
 extern Application* CreateApplication();
 
+// Runs the headless command given on the command line (like batch rendering) without creating the application, so without a window.
+// Returns the exit code of the command, or nothing when the application should start normally.
+extern std::optional<int> RunHeadless(const CommandLine& commandLine);
+
 int Main(int argc, char** argv) {
-	Application* app = CreateApplication();
-	app->Run();
-	delete app;
+	const CommandLine commandLine(argc, argv);
+
+	// '--trace=<file>' records the whole run, headless commands included, and writes it as a Chrome trace on exit
+	const std::string tracePath = commandLine.GetOption("trace");
+	Profiler::SetThreadName("Main");
+
+	if (!tracePath.empty()) {
+		Profiler::Start();
+	}
+
+	std::optional<int> exitCode = RunHeadless(commandLine);
+
+	if (!exitCode) {
+		Application* app = CreateApplication();
+		app->Run();
+		delete app;
+
+		exitCode = 0;
+	}
+
+	if (!tracePath.empty() && Profiler::IsRecording()) {
+		Profiler::Stop();
+		Profiler::WriteTrace(tracePath);
+	}
 
-	return 0;
+	return *exitCode;
 }
 
 #if defined(MB_PLATFORM_WINDOWS) && defined(MB_DIST)
@@ -0,0 +1,104 @@
+#include "FrameTimings.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+void RollingStatistic::Add(double value) {
+	m_Values[m_Next] = (float)value;
+	m_Next = (m_Next + 1) % Capacity;
+	m_Count = std::min(m_Count + 1, Capacity);
+}
+
+void RollingStatistic::Clear() {
+	m_Next = 0;
+	m_Count = 0;
+}
+
+double RollingStatistic::GetLatest() const {
+	return m_Count > 0 ? m_Values[(m_Next + Capacity - 1) % Capacity] : 0.0;
+}
+
+double RollingStatistic::GetMinimum() const {
+	return m_Count > 0 ? *std::min_element(m_Values.begin(), m_Values.begin() + m_Count) : 0.0;
+}
+
+double RollingStatistic::GetMaximum() const {
+	return m_Count > 0 ? *std::max_element(m_Values.begin(), m_Values.begin() + m_Count) : 0.0;
+}
+
+double RollingStatistic::GetAverage() const {
+	if (m_Count == 0) {
+		return 0.0;
+	}
+
+	double sum = 0.0;
+	for (int i = 0; i < m_Count; ++i) {
+		sum += m_Values[i];
+	}
+
+	return sum / m_Count;
+}
+
+double RollingStatistic::GetPercentile(double p) const {
+	if (m_Count == 0) {
+		return 0.0;
+	}
+
+	// The order of the ring does not matter once sorted, so only the values it holds are copied
+	std::vector<float> sorted(m_Values.begin(), m_Values.begin() + m_Count);
+	std::sort(sorted.begin(), sorted.end());
+
+	// The nearest rank, so the percentile is always one of the values (a single slow frame shows as such)
+	const int rank = std::clamp((int)std::ceil(p * m_Count) - 1, 0, m_Count - 1);
+
+	return sorted[rank];
+}
+
+void FrameTimings::BeginFrame() {
+	const auto now = std::chrono::steady_clock::now();
+
+	if (s_HasFrame) {
+		const std::chrono::duration<double, std::milli> elapsed = now - s_FrameStart;
+		s_FrameTime.Add(elapsed.count());
+	}
+
+	s_FrameStart = now;
+	s_HasFrame = true;
+	s_FrameUITime = 0.0;
+}
+
+void FrameTimings::EndFrame() {
+	const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - s_FrameStart;
+
+	s_CPUTime.Add(elapsed.count());
+	s_UITime.Add(s_FrameUITime);
+}
+
+void FrameTimings::AddUITime(double milliseconds) {
+	s_FrameUITime += milliseconds;
+}
+
+void FrameTimings::ReportRender(double milliseconds, uint64_t pixels, uint64_t iterations) {
+	s_RenderTime.Add(milliseconds);
+
+	if (milliseconds <= 0.0) {
+		return;
+	}
+
+	if (pixels > 0) {
+		s_PixelRate.Add((double)pixels / milliseconds * 1000.0);
+	}
+
+	if (iterations > 0) {
+		s_IterationRate.Add((double)iterations / milliseconds * 1000.0);
+	}
+}
+
+void FrameTimings::ReportGPUTime(double milliseconds, uint64_t pixels) {
+	s_GPUTime.Add(milliseconds);
+
+	if (pixels > 0 && milliseconds > 0.0) {
+		s_PixelRate.Add((double)pixels / milliseconds * 1000.0);
+	}
+}
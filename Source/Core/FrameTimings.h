@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * The last values of a measure, like the time of each frame, kept in a ring to be plotted and summarized.
+ */
+class RollingStatistic {
+public:
+	/// @brief The number of values kept, a few seconds of frames.
+	static constexpr int Capacity = 240;
+
+	void Add(double value);
+	void Clear();
+
+	bool IsEmpty() const { return m_Count == 0; }
+	int GetCount() const { return m_Count; }
+
+	double GetLatest() const;
+	double GetMinimum() const;
+	double GetMaximum() const;
+	double GetAverage() const;
+
+	/// @brief The value below which a fraction `p` of the values fall, like `0.99` for the 99th percentile.
+	double GetPercentile(double p) const;
+
+	/// @brief The values in a ring, the oldest at `GetOffset` once the ring is full (the layout `ImGui::PlotLines` expects).
+	const float* GetValues() const { return m_Values.data(); }
+	int GetOffset() const { return m_Count < Capacity ? 0 : m_Next; }
+private:
+	std::array<float, Capacity> m_Values = {};
+	int m_Next = 0;
+	int m_Count = 0;
+};
+
+/**
+ * Collects where the time of each frame of the application goes, for the Statistics window.
+ *
+ * The main loop measures the whole frame, the time the CPU works on it (until the buffers are swapped, which waits for VSync) and the time spent building the UI.
+ * The renderer reports the frames it actually renders: their time on the CPU and, a few frames later, on the GPU, along with the number of pixels and iterations,
+ * so the throughput of the engine is only averaged over the frames that did render (a static view costs nothing).
+ */
+class FrameTimings {
+public:
+	static void BeginFrame();
+	static void EndFrame();
+
+	/// @brief Adds time spent building or drawing the UI to the current frame, in milliseconds.
+	static void AddUITime(double milliseconds);
+
+	/**
+	 * Reports a frame rendered by the renderer.
+	 *
+	 * @param milliseconds The time the CPU spent submitting the frame (rendering it, for the CPU engine).
+	 * @param pixels The number of pixels rendered by the CPU, or `0` if the GPU rendered them (see `ReportGPUTime`).
+	 * @param iterations The number of iterations of the frame, or `0` if the engine cannot count them.
+	 */
+	static void ReportRender(double milliseconds, uint64_t pixels, uint64_t iterations);
+
+	/// @brief Reports the time the GPU spent on a rendered frame, once it is known, and the number of pixels it rendered (`0` if the CPU rendered them).
+	static void ReportGPUTime(double milliseconds, uint64_t pixels);
+
+	/// @brief The time between the start of the last frames, VSync and the frame-rate cap included.
+	static const RollingStatistic& GetFrameTime() { return s_FrameTime; }
+	static const RollingStatistic& GetCPUTime() { return s_CPUTime; }
+	static const RollingStatistic& GetUITime() { return s_UITime; }
+	static const RollingStatistic& GetRenderTime() { return s_RenderTime; }
+	static const RollingStatistic& GetGPUTime() { return s_GPUTime; }
+
+	/// @brief The pixels per second of the rendered frames, over their GPU time if the GPU rendered them, or their CPU time otherwise.
+	static const RollingStatistic& GetPixelRate() { return s_PixelRate; }
+	static const RollingStatistic& GetIterationRate() { return s_IterationRate; }
+private:
+	inline static std::chrono::steady_clock::time_point s_FrameStart;
+	inline static bool s_HasFrame = false;
+	inline static double s_FrameUITime = 0.0;
+
+	inline static RollingStatistic s_FrameTime;
+	inline static RollingStatistic s_CPUTime;
+	inline static RollingStatistic s_UITime;
+	inline static RollingStatistic s_RenderTime;
+	inline static RollingStatistic s_GPUTime;
+	inline static RollingStatistic s_PixelRate;
+	inline static RollingStatistic s_IterationRate;
+};
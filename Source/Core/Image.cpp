@@ -27,3 +27,44 @@ Image::Image(const std::filesystem::path& filepath) {
         Log::Error("Image::Image - Failed to load image: " + filepath.string());
     }
 }
+
+bool Image::Write(const std::filesystem::path& filepath, uint32_t width, uint32_t height, const uint8_t* pixels, ExportImageFormat format, int quality) {
+    // The rows are flipped to top-down here rather than with 'stbi_flip_vertically_on_write', whose flag is shared by every thread.
+    // JPEG does not support an alpha channel, so it is dropped at the same time.
+    const uint32_t channels = format == ExportImageFormat::JPEG ? 3 : 4;
+    std::vector<uint8_t> rows((size_t)width * height * channels);
+
+    for (uint32_t y = 0; y < height; ++y) {
+        const uint8_t* source = pixels + (size_t)(height - 1 - y) * width * 4;
+        uint8_t* destination = rows.data() + (size_t)y * width * channels;
+
+        for (uint32_t x = 0; x < width; ++x) {
+            for (uint32_t channel = 0; channel < channels; ++channel) {
+                destination[x * channels + channel] = source[x * 4 + channel];
+            }
+        }
+    }
+
+    const std::string path = filepath.string();
+    int result = 0;
+
+    switch (format) {
+        case ExportImageFormat::JPEG:
+            result = stbi_write_jpg(path.c_str(), width, height, 3, rows.data(), quality);
+            break;
+        case ExportImageFormat::BMP:
+            result = stbi_write_bmp(path.c_str(), width, height, 4, rows.data());
+            break;
+        case ExportImageFormat::PNG:
+        default:
+            result = stbi_write_png(path.c_str(), width, height, 4, rows.data(), width * 4);
+            break;
+    }
+
+    if (!result) {
+        Log::Error("Image::Write - Failed to write image: " + path);
+        return false;
+    }
+
+    return true;
+}
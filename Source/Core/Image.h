@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core/Core.h"
+#include "Core/Settings/Settings.h"
 
 #include <filesystem>
 #include <vector>
@@ -55,6 +56,19 @@ public:
      * @return `true` if the image was loaded successfully, `false` otherwise.
      */
     bool IsLoaded() const { return !m_Pixels.empty(); }
+
+    /**
+     * Writes RGBA8 pixels to an image file.
+     * 
+     * @param filepath The path of the image file to write.
+     * @param width The width of the image in pixels.
+     * @param height The height of the image in pixels.
+     * @param pixels The RGBA8 pixels, `width * height * 4` bytes stored bottom-up, the way OpenGL reads them back.
+     * @param format The format of the image file. JPEG drops the alpha channel.
+     * @param quality The compression quality in the range [0, 100], only used by JPEG.
+     * @return `true` if the image was written, `false` otherwise.
+     */
+    static bool Write(const std::filesystem::path& filepath, uint32_t width, uint32_t height, const uint8_t* pixels, ExportImageFormat format, int quality = 90);
 private:
     /// @brief The width of the image in pixels.
     uint32_t m_Width = 0;
@@ -0,0 +1,148 @@
+#include "JsonWriter.h"
+
+#include "Core/Log.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+JsonWriter& JsonWriter::BeginObject() {
+	BeginElement();
+	m_Buffer += '{';
+	m_Scopes.push_back(false);
+
+	return *this;
+}
+
+JsonWriter& JsonWriter::EndObject() {
+	const bool hasElements = m_Scopes.back();
+	m_Scopes.pop_back();
+
+	if (hasElements) {
+		m_Buffer += '\n';
+		WriteIndentation();
+	}
+
+	m_Buffer += '}';
+
+	return *this;
+}
+
+JsonWriter& JsonWriter::BeginArray() {
+	BeginElement();
+	m_Buffer += '[';
+	m_Scopes.push_back(false);
+
+	return *this;
+}
+
+JsonWriter& JsonWriter::EndArray() {
+	const bool hasElements = m_Scopes.back();
+	m_Scopes.pop_back();
+
+	if (hasElements) {
+		m_Buffer += '\n';
+		WriteIndentation();
+	}
+
+	m_Buffer += ']';
+
+	return *this;
+}
+
+JsonWriter& JsonWriter::Key(const std::string& key) {
+	Value(key);
+	m_Buffer += ": ";
+	m_AfterKey = true;
+
+	return *this;
+}
+
+JsonWriter& JsonWriter::Value(const std::string& value) {
+	BeginElement();
+	m_Buffer += '"';
+
+	for (const char c : value) {
+		switch (c) {
+			case '"':	m_Buffer += "\\\"";	break;
+			case '\\':	m_Buffer += "\\\\";	break;
+			case '\n':	m_Buffer += "\\n";	break;
+			case '\r':	m_Buffer += "\\r";	break;
+			case '\t':	m_Buffer += "\\t";	break;
+			default:
+				if ((unsigned char)c < 0x20) {
+					char escaped[8];
+					std::snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned)c);
+					m_Buffer += escaped;
+				} else {
+					m_Buffer += c;
+				}
+				break;
+		}
+	}
+
+	m_Buffer += '"';
+
+	return *this;
+}
+
+bool JsonWriter::Save(const std::filesystem::path& filepath) const {
+	if (!filepath.parent_path().empty()) {
+		std::error_code error;
+		std::filesystem::create_directories(filepath.parent_path(), error);
+	}
+
+	std::ofstream file(filepath, std::ios::out | std::ios::trunc);
+	file << m_Buffer << '\n';
+
+	if (!file) {
+		Log::Error("JsonWriter::Save - Cannot write '" + filepath.string() + "'");
+		return false;
+	}
+
+	return true;
+}
+
+JsonWriter& JsonWriter::WriteRaw(const std::string& text) {
+	BeginElement();
+	m_Buffer += text;
+
+	return *this;
+}
+
+JsonWriter& JsonWriter::WriteNumber(double value) {
+	if (!std::isfinite(value)) {
+		return WriteRaw("null");
+	}
+
+	// The shortest representation that reads back to the same value
+	char text[32];
+	const std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+
+	return WriteRaw(std::string(text, result.ptr));
+}
+
+void JsonWriter::BeginElement() {
+	// A value following its key stays on the line of the key
+	if (m_AfterKey) {
+		m_AfterKey = false;
+		return;
+	}
+
+	if (m_Scopes.empty()) {
+		return;
+	}
+
+	if (m_Scopes.back()) {
+		m_Buffer += ',';
+	}
+
+	m_Scopes.back() = true;
+	m_Buffer += '\n';
+	WriteIndentation();
+}
+
+void JsonWriter::WriteIndentation() {
+	m_Buffer.append(m_Scopes.size() * 2, ' ');
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Writes an indented JSON document one element at a time, for the machine-readable reports of the benchmarks.
+ *
+ * Objects and arrays are opened and closed explicitly, and the members of an object are written as a `Key` followed by a value:
+ *
+ * @example writer.BeginObject().Key("Threads").Value(8).Key("Cases").BeginArray().EndArray().EndObject();
+ */
+class JsonWriter {
+public:
+	JsonWriter& BeginObject();
+	JsonWriter& EndObject();
+
+	JsonWriter& BeginArray();
+	JsonWriter& EndArray();
+
+	/**
+	 * Writes the key of the next member of the current object.
+	 */
+	JsonWriter& Key(const std::string& key);
+
+	JsonWriter& Value(const std::string& value);
+	JsonWriter& Value(const char* value) { return Value(std::string(value)); }
+
+	/**
+	 * Writes a boolean or a number. Floating-point values are written with as many digits as they need to be read back exactly, and NaNs and infinities as `null`.
+	 */
+	template<typename T> requires std::is_arithmetic_v<T>
+	JsonWriter& Value(T value) {
+		if constexpr (std::is_same_v<T, bool>) {
+			return WriteRaw(value ? "true" : "false");
+		} else if constexpr (std::is_integral_v<T>) {
+			return WriteRaw(std::to_string(value));
+		} else {
+			return WriteNumber((double)value);
+		}
+	}
+
+	/**
+	 * Gets the document written so far.
+	 */
+	const std::string& GetString() const { return m_Buffer; }
+
+	/**
+	 * Writes the document to a file, creating its folder if needed.
+	 *
+	 * @return `true` if the file was written.
+	 */
+	bool Save(const std::filesystem::path& filepath) const;
+private:
+	JsonWriter& WriteRaw(const std::string& text);
+	JsonWriter& WriteNumber(double value);
+
+	/// @brief Separates the new element from the previous one of its object or array, and puts it on its own line.
+	void BeginElement();
+
+	void WriteIndentation();
+private:
+	std::string m_Buffer;
+
+	/// @brief Whether each open object or array already has an element.
+	std::vector<bool> m_Scopes;
+
+	/// @brief Set after a key, whose value follows on the same line.
+	bool m_AfterKey = false;
+};
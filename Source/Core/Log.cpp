@@ -105,6 +105,8 @@ void Log::Write(Level level, const std::string& message) {
 		<< "[" << std::setfill('0') << std::right << std::setw(15) << threadIdStream.str() << "] "
 		<< ": " << message << std::endl;
 
+	std::lock_guard<std::mutex> lock(s_Mutex);
+
 	// Output the log message to the console and to the log file if enabled.
 	std::ostream& consoleStream = (level >= Level::Error) ? std::cerr : std::cout;
 	consoleStream << logStream.str();
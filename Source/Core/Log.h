@@ -9,6 +9,7 @@
 #include <ctime>
 #include <iomanip>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <sstream>
 #include <filesystem>
@@ -189,4 +190,7 @@ private:
 
 	/// @brief The log file stream. If `s_UseFile` is true, logs will be written to this file.
 	inline static Scope<std::ofstream> s_LogFile = nullptr;
+
+	/// @brief Serializes the writes of the threads logging at the same time, so their messages never interleave.
+	inline static std::mutex s_Mutex;
 };
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "MappedFile.h"
+
+#include "Core/Log.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() {
+	Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::filesystem::path& filepath, size_t size) {
+	Close();
+
+	HANDLE file = CreateFileW(filepath.wstring().c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		Log::Error("MappedFile::Open - Cannot open '" + filepath.string() + "'");
+		return false;
+	}
+
+	m_File = file;
+
+	LARGE_INTEGER fileSize;
+	fileSize.QuadPart = (LONGLONG)size;
+
+	if (!SetFilePointerEx(file, fileSize, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+		Log::Error("MappedFile::Open - Cannot resize '" + filepath.string() + "'");
+		Close();
+		return false;
+	}
+
+	m_Mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, fileSize.HighPart, fileSize.LowPart, nullptr);
+	if (!m_Mapping) {
+		Log::Error("MappedFile::Open - Cannot map '" + filepath.string() + "'");
+		Close();
+		return false;
+	}
+
+	m_Data = (uint8_t*)MapViewOfFile(m_Mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+	if (!m_Data) {
+		Log::Error("MappedFile::Open - Cannot map a view of '" + filepath.string() + "'");
+		Close();
+		return false;
+	}
+
+	m_Size = size;
+
+	return true;
+}
+
+void MappedFile::Close() {
+	if (m_Data) {
+		FlushViewOfFile(m_Data, 0);
+		UnmapViewOfFile(m_Data);
+		m_Data = nullptr;
+	}
+
+	if (m_Mapping) {
+		CloseHandle((HANDLE)m_Mapping);
+		m_Mapping = nullptr;
+	}
+
+	if (m_File) {
+		CloseHandle((HANDLE)m_File);
+		m_File = nullptr;
+	}
+
+	m_Size = 0;
+}
+
+void MappedFile::Flush() {
+	if (m_Data) {
+		FlushViewOfFile(m_Data, 0);
+	}
+}
+
+#else
+
+bool MappedFile::Open(const std::filesystem::path& filepath, size_t size) {
+	Close();
+
+	m_File = open(filepath.c_str(), O_RDWR | O_CREAT, 0644);
+	if (m_File < 0) {
+		Log::Error("MappedFile::Open - Cannot open '" + filepath.string() + "'");
+		return false;
+	}
+
+	if (ftruncate(m_File, (off_t)size) != 0) {
+		Log::Error("MappedFile::Open - Cannot resize '" + filepath.string() + "'");
+		Close();
+		return false;
+	}
+
+	void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_File, 0);
+	if (data == MAP_FAILED) {
+		Log::Error("MappedFile::Open - Cannot map '" + filepath.string() + "'");
+		Close();
+		return false;
+	}
+
+	m_Data = (uint8_t*)data;
+	m_Size = size;
+
+	return true;
+}
+
+void MappedFile::Close() {
+	if (m_Data) {
+		msync(m_Data, m_Size, MS_SYNC);
+		munmap(m_Data, m_Size);
+		m_Data = nullptr;
+	}
+
+	if (m_File >= 0) {
+		close(m_File);
+		m_File = -1;
+	}
+
+	m_Size = 0;
+}
+
+void MappedFile::Flush() {
+	if (m_Data) {
+		msync(m_Data, m_Size, MS_ASYNC);
+	}
+}
+
+#endif
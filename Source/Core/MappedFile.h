@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+/**
+ * A file mapped into memory for reading and writing, so its contents are accessed in place without copying them through read and write calls.
+ *
+ * The writes reach the file when the operating system writes the pages back, or when `Flush` is called.
+ */
+class MappedFile {
+public:
+	MappedFile() = default;
+
+	/**
+	 * Unmaps and closes the file.
+	 */
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/**
+	 * Opens a file and maps it into memory, creating it if needed. The file is resized to `size` bytes, the bytes added being zero.
+	 *
+	 * @param filepath The path of the file.
+	 * @param size The size of the file, in bytes.
+	 * @return `true` if the file was mapped, `false` otherwise (the file is then closed).
+	 */
+	bool Open(const std::filesystem::path& filepath, size_t size);
+
+	/**
+	 * Writes the pending changes back to the file, unmaps and closes it.
+	 */
+	void Close();
+
+	/**
+	 * Writes the pending changes back to the file.
+	 */
+	void Flush();
+
+	bool IsOpen() const { return m_Data != nullptr; }
+
+	uint8_t* GetData() const { return m_Data; }
+	size_t GetSize() const { return m_Size; }
+private:
+	uint8_t* m_Data = nullptr;
+	size_t m_Size = 0;
+
+#ifdef _WIN32
+	void* m_File = nullptr;
+	void* m_Mapping = nullptr;
+#else
+	int m_File = -1;
+#endif
+};
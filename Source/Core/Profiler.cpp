@@ -0,0 +1,154 @@
+#include "Profiler.h"
+
+#include "Core/JsonWriter.h"
+#include "Core/Log.h"
+
+#include <algorithm>
+
+void Profiler::Start() {
+#ifdef MB_DIST
+	Log::Warning("Profiler::Start - Profiling is compiled out of Dist builds");
+#else
+	{
+		std::lock_guard<std::mutex> lock(s_BuffersMutex);
+
+		for (const auto& buffer : s_Buffers) {
+			std::lock_guard<std::mutex> bufferLock(buffer->Mutex);
+			buffer->Written = 0;
+		}
+	}
+
+	s_Recording.store(true, std::memory_order_relaxed);
+	Log::Info("Profiler::Start - Recording a trace");
+#endif // MB_DIST
+}
+
+void Profiler::Stop() {
+	s_Recording.store(false, std::memory_order_relaxed);
+}
+
+bool Profiler::WriteTrace(const std::filesystem::path& filepath) {
+	JsonWriter writer;
+	writer.BeginObject();
+	writer.Key("displayTimeUnit").Value("ms");
+	writer.Key("traceEvents").BeginArray();
+
+	uint64_t eventCount = 0;
+
+	{
+		std::lock_guard<std::mutex> lock(s_BuffersMutex);
+
+		for (const auto& buffer : s_Buffers) {
+			// The events are copied out, so the thread is only held up for the copy and not for the formatting
+			std::vector<ProfileEvent> events;
+
+			{
+				std::lock_guard<std::mutex> bufferLock(buffer->Mutex);
+
+				const uint64_t count = std::min(buffer->Written, BufferCapacity);
+				events.reserve(count);
+
+				// Oldest first: past the capacity, the oldest event is the one the next would overwrite
+				for (uint64_t i = buffer->Written - count; i < buffer->Written; ++i) {
+					events.push_back(buffer->Events[i % BufferCapacity]);
+				}
+			}
+
+			if (events.empty()) {
+				continue;
+			}
+
+			writer.BeginObject();
+			writer.Key("name").Value("thread_name");
+			writer.Key("ph").Value("M");
+			writer.Key("pid").Value(1);
+			writer.Key("tid").Value(buffer->ThreadID);
+			writer.Key("args").BeginObject().Key("name").Value(buffer->Name).EndObject();
+			writer.EndObject();
+
+			// Complete events, timed in microseconds
+			for (const ProfileEvent& event : events) {
+				writer.BeginObject();
+				writer.Key("name").Value(event.Name);
+				writer.Key("ph").Value("X");
+				writer.Key("ts").Value((double)event.Start * 1e-3);
+				writer.Key("dur").Value((double)event.Duration * 1e-3);
+				writer.Key("pid").Value(1);
+				writer.Key("tid").Value(buffer->ThreadID);
+				writer.EndObject();
+			}
+
+			eventCount += events.size();
+		}
+	}
+
+	writer.EndArray();
+	writer.EndObject();
+
+	if (!writer.Save(filepath)) {
+		Log::Error("Profiler::WriteTrace - Failed to write the trace to " + filepath.string());
+		return false;
+	}
+
+	Log::Info("Profiler::WriteTrace - Wrote " + std::to_string(eventCount) + " events to " + filepath.string());
+
+	return true;
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+	ThreadBuffer& buffer = GetThreadBuffer();
+
+	std::lock_guard<std::mutex> lock(buffer.Mutex);
+	buffer.Name = name;
+}
+
+void Profiler::Record(const char* name, int64_t start, int64_t end) {
+	ThreadBuffer& buffer = GetThreadBuffer();
+
+	std::lock_guard<std::mutex> lock(buffer.Mutex);
+
+	if (buffer.Events.empty()) {
+		buffer.Events.resize(BufferCapacity);
+	}
+
+	buffer.Events[buffer.Written % BufferCapacity] = { name, start, end - start };
+	++buffer.Written;
+}
+
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer() {
+	if (!s_ThreadBuffer) {
+		std::lock_guard<std::mutex> lock(s_BuffersMutex);
+
+		ThreadBuffer* buffer = nullptr;
+
+		if (!s_FreeBuffers.empty()) {
+			buffer = s_FreeBuffers.back();
+			s_FreeBuffers.pop_back();
+		} else {
+			s_Buffers.push_back(CreateScope<ThreadBuffer>());
+			buffer = s_Buffers.back().get();
+			buffer->ThreadID = (uint32_t)s_Buffers.size();
+		}
+
+		{
+			std::lock_guard<std::mutex> bufferLock(buffer->Mutex);
+			buffer->Name = "Thread " + std::to_string(buffer->ThreadID);
+		}
+
+		s_ThreadBuffer = buffer;
+		s_ThreadBufferOwner.Buffer = buffer;
+	}
+
+	return *s_ThreadBuffer;
+}
+
+Profiler::ThreadBufferOwner::~ThreadBufferOwner() {
+	if (!Buffer) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(s_BuffersMutex);
+	s_FreeBuffers.push_back(Buffer);
+
+	s_ThreadBuffer = nullptr;
+}
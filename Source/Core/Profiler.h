@@ -0,0 +1,133 @@
+#pragma once
+
+#include "Core/Core.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * A scope timed by the profiler: its name, when it started and how long it took, in nanoseconds since the profiler was loaded.
+ */
+struct ProfileEvent {
+	/// @brief The name of the scope, which must outlive the profiler (a string literal).
+	const char* Name = nullptr;
+
+	int64_t Start = 0;
+	int64_t Duration = 0;
+};
+
+/**
+ * Records where the time of the application goes, scope by scope, and writes it as a trace for `chrome://tracing` or Perfetto.
+ *
+ * Scopes are timed with `MB_PROFILE_SCOPE`, which compiles to nothing in `Dist` builds. Otherwise a scope costs a single relaxed atomic load
+ * while nothing is being recorded. While recording, every thread writes its scopes into a ring buffer of its own, so worker threads never wait for each other,
+ * and a long recording keeps the last `BufferCapacity` scopes of every thread.
+ *
+ * A recording is started and written with the `F9` key, or by launching the application (or a headless command) with `--trace=<file>`.
+ */
+class Profiler {
+public:
+	/// @brief Starts recording, discarding the scopes of any previous recording.
+	static void Start();
+	static void Stop();
+
+	static bool IsRecording() { return s_Recording.load(std::memory_order_relaxed); }
+
+	/**
+	 * Writes the scopes recorded so far as a Chrome trace (the JSON trace event format), each thread of the application on its own track.
+	 *
+	 * @return `true` if the trace was written.
+	 */
+	static bool WriteTrace(const std::filesystem::path& filepath);
+
+	/// @brief Names the track of the calling thread in the traces.
+	static void SetThreadName(const std::string& name);
+
+	/// @brief The time since the profiler was loaded, in nanoseconds.
+	static int64_t Now() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_Epoch).count(); }
+
+	/// @brief Adds a scope to the ring buffer of the calling thread.
+	static void Record(const char* name, int64_t start, int64_t end);
+
+	/// @brief The number of scopes each thread keeps, the oldest ones being overwritten.
+	static constexpr uint64_t BufferCapacity = 1 << 15;
+private:
+	struct ThreadBuffer {
+		uint32_t ThreadID = 0;
+		std::string Name;
+
+		/// @brief Allocated by the first scope recorded, so threads that are never recorded cost nothing.
+		std::vector<ProfileEvent> Events;
+
+		/// @brief The number of scopes recorded since the recording started, the next one going to `Written % BufferCapacity`.
+		uint64_t Written = 0;
+
+		/// @brief Only ever contended while a trace is being written.
+		std::mutex Mutex;
+	};
+
+	/// @brief Releases the buffer of its thread when the thread exits, for the next new thread to reuse it.
+	struct ThreadBufferOwner {
+		ThreadBuffer* Buffer; // Zero-initialized, as a thread_local
+
+		~ThreadBufferOwner();
+	};
+
+	static ThreadBuffer& GetThreadBuffer();
+private:
+	inline static const std::chrono::steady_clock::time_point s_Epoch = std::chrono::steady_clock::now();
+	inline static std::atomic<bool> s_Recording = false;
+
+	/// @brief Every buffer, and those of the threads that finished. The buffer of a finished thread keeps its scopes, so they can still be written,
+	/// until a new thread takes it over (on the same track), so short-lived threads do not add a buffer each and there are only ever as many buffers as threads alive at once.
+	inline static std::vector<Scope<ThreadBuffer>> s_Buffers;
+	inline static std::vector<ThreadBuffer*> s_FreeBuffers;
+	inline static std::mutex s_BuffersMutex;
+
+	/// @brief The buffer of the calling thread, read by every scope, and its owner, only touched once per thread as it has a destructor to run.
+	inline static thread_local ThreadBuffer* s_ThreadBuffer = nullptr;
+	inline static thread_local ThreadBufferOwner s_ThreadBufferOwner;
+};
+
+/**
+ * Times the scope it lives in, from its construction to its destruction (see `MB_PROFILE_SCOPE`).
+ */
+class ProfileScope {
+public:
+	explicit ProfileScope(const char* name)
+		: m_Name(name)
+	{
+		if (Profiler::IsRecording()) {
+			m_Start = Profiler::Now();
+			m_Recording = true;
+		}
+	}
+
+	~ProfileScope() {
+		if (m_Recording) {
+			Profiler::Record(m_Name, m_Start, Profiler::Now());
+		}
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+private:
+	const char* m_Name;
+	int64_t m_Start = 0;
+	bool m_Recording = false;
+};
+
+#define MB_PROFILE_CONCATENATE_IMPL(a, b) a##b
+#define MB_PROFILE_CONCATENATE(a, b) MB_PROFILE_CONCATENATE_IMPL(a, b)
+
+#ifdef MB_DIST
+	#define MB_PROFILE_SCOPE(name)
+#else
+	/// @brief Times the rest of the enclosing scope under a name, like `MB_PROFILE_SCOPE("Renderer::Submit")`.
+	#define MB_PROFILE_SCOPE(name) ProfileScope MB_PROFILE_CONCATENATE(profileScope, __LINE__)(name)
+#endif // MB_DIST
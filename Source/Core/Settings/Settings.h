@@ -81,7 +81,124 @@ enum class RenderingEngine {
 	DirectX,
 
 	/// @brief A low-overhead, cross-platform 3D graphics and compute API that provides high-efficiency access to modern GPUs, designed to offer better performance and more balanced CPU/GPU usage compared to older APIs like OpenGL and DirectX.
-	Vulkan
+	Vulkan,
+
+	/// @brief A multi-threaded software renderer that computes the fractal on the CPU and uploads the result to the viewport, useful for validating the GPU output and as a base for high-precision techniques.
+	CPU
+};
+
+/**
+ * Represents the SIMD instruction sets the CPU rendering engine can use to iterate several pixels at once.
+ * 
+ * `Auto` selects the widest instruction set supported by the processor at startup; any other value forces that level (falling back to the best supported one below it).
+ */
+enum class InstructionSet {
+	/// @brief Detect the best instruction set supported by the processor using `cpuid`.
+	Auto,
+
+	/// @brief Plain scalar code, one pixel at a time.
+	Scalar,
+
+	/// @brief 128-bit SSE2 vectors, four pixels at a time. Available on every x86-64 processor.
+	SSE2,
+
+	/// @brief 256-bit AVX2 vectors with fused multiply-add, eight pixels at a time.
+	AVX2,
+
+	/// @brief 512-bit AVX-512 vectors with mask registers, sixteen pixels at a time.
+	AVX512
+};
+
+/**
+ * Represents the area-skipping strategies of the CPU rendering engine, which fill uniform regions of the image without iterating their pixels.
+ * 
+ * A region is only filled when its color follows from the iteration count alone: interior regions, and exterior bands with `Step` coloring.
+ */
+enum class AreaSkippingMode {
+	/// @brief Every pixel is iterated.
+	None,
+
+	/// @brief Mariani-Silver subdivision: rectangles whose whole border shares the same iteration count are filled, the others are split in four.
+	MarianiSilver,
+
+	/// @brief Fractint-style solid guessing: a coarse grid is refined pass after pass, and blocks whose corners agree are guessed instead of refined.
+	SolidGuessing
+};
+
+/**
+ * Represents the settings of the multi-threaded CPU rendering engine.
+ */
+struct CPURenderingSettings {
+	/// @brief The SIMD instruction set used by the CPU kernels.
+	InstructionSet SIMD = InstructionSet::Auto;
+
+	/// @brief Whether views deeper than double precision can resolve are rendered with perturbation theory, iterating every pixel as an offset from a high-precision reference orbit. The OpenGL engine hands these views over to the CPU engine.
+	bool Perturbation = true;
+
+	/// @brief Whether perturbation skips the first iterations of every pixel by evaluating a series approximation of its orbit.
+	bool SeriesApproximation = true;
+
+	/// @brief The strategy used to fill uniform regions without iterating them.
+	AreaSkippingMode AreaSkipping = AreaSkippingMode::None;
+
+	/// @brief Whether area skipping checks more pixels before filling a region: the middle row and column of Mariani-Silver rectangles, or the corners of the neighbouring blocks for solid guessing.
+	bool VerifyAreaSkipping = true;
+
+	/// @brief Whether a zoomed or rotated view first shows the previous image resampled to it, then refines it tile by tile over the following frames (see `RenderingSettings::FrameBudget`). Refined tiles are identical to a full render.
+	bool ZoomReprojection = false;
+
+	/// @brief Whether a new view is rendered coarse to fine: a pixel in 16 first, then the interleaved pixels left over the following frames (see `RenderingSettings::FrameBudget`). Only used without area skipping.
+	bool Progressive = false;
+
+	/// @brief Whether the views are sampled from a cache of tiles aligned to the power-of-two zoom levels of the plane, so zooming back in or loading a view again reuses the tiles rendered for it. Views deep enough for perturbation bypass the cache.
+	bool TileCache = false;
+
+	/// @brief The memory the tile cache may take, in megabytes, or `0` to size it from the frame (see `TileCache::GetAutomaticCapacity`).
+	/// The least recently used tiles are evicted past it, and a view whose tiles do not fit is rendered without the cache.
+	int TileCacheSize = 0;
+
+	/// @brief Whether the rendered tiles are also kept in a memory-mapped file that persists across sessions: the tiles of the tile cache, and those of every view rendered in full, deep views included.
+	bool TileStore = false;
+
+	/// @brief The size of the file of the tile store, in megabytes. The least recently used tiles are evicted past it.
+	int TileStoreSize = 2048;
+
+	/// @brief The folder the file of the tile store is kept in.
+	std::filesystem::path TileStoreFolder = "Cache";
+
+	bool operator==(const CPURenderingSettings& other) const = default;
+};
+
+/**
+ * Represents the settings of the OpenGL rendering engine.
+ */
+struct OpenGLRenderingSettings {
+	/// @brief Whether a new view is rendered coarse to fine: a pixel in 64 first, then the interleaved pixels left over the following frames (see `RenderingSettings::FrameBudget`).
+	bool Progressive = false;
+
+	bool operator==(const OpenGLRenderingSettings& other) const = default;
+};
+
+/**
+ * Represents the settings of adaptive supersampling, which antialiases the image by iterating extra samples only for the pixels that need them.
+ *
+ * After the image is rendered, a pixel is supersampled when one of its neighbours differs from it (by the iteration count, the color, or by escaping while it does not)
+ * or when the distance estimate puts it within a pixel of the boundary of the set. The extra samples are jittered inside the pixel and averaged with it.
+ */
+struct SupersamplingSettings {
+	/// @brief Whether adaptive supersampling is enabled.
+	bool Enabled = false;
+
+	/// @brief The extra samples of a supersampled pixel are laid out on a `Grid` by `Grid` grid of cells, one jittered sample per cell.
+	int Grid = 4;
+
+	/// @brief The difference of any color channel, from 0 to 1, past which two neighbouring pixels are supersampled.
+	float ColorThreshold = 0.05f;
+
+	/// @brief The difference of iteration count past which two neighbouring pixels are supersampled.
+	int IterationThreshold = 8;
+
+	bool operator==(const SupersamplingSettings& other) const = default;
 };
 
 /**
@@ -123,6 +240,18 @@ struct RenderingSettings {
 
 	/// @brief The target frame rate cap in frames per second.
 	int TargetFrameRate = 0;
+
+	/// @brief The time, in milliseconds, a frame may spend iterating a view rendered over several frames (progressive rendering, or the refinement of a reprojected view), on either engine.
+	float FrameBudget = 12.0f;
+
+	/// @brief The settings of adaptive supersampling, used by both rendering engines.
+	SupersamplingSettings Supersampling;
+
+	/// @brief The settings of the OpenGL rendering engine, used when `Engine` is `OpenGL`.
+	OpenGLRenderingSettings OpenGL;
+
+	/// @brief The settings of the CPU rendering engine, used when `Engine` is `CPU`.
+	CPURenderingSettings CPU;
 };
 
 /**
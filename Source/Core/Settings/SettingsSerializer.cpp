@@ -1,6 +1,7 @@
 #include "SettingsSerializer.h"
 
 #include "Core/Log.h"
+#include "Core/Profiler.h"
 
 #include "Utilities/Utilities.h"
 
@@ -127,6 +128,8 @@ bool SettingsSerializer::Serialize(const std::filesystem::path& filepath) {
 }
 
 bool SettingsSerializer::Deserialize(const std::filesystem::path& filepath) {
+	MB_PROFILE_SCOPE("SettingsSerializer::Deserialize");
+
 	// Data structure to hold the loaded YAML data from the file.
 	YAML::Node data;
 
@@ -251,6 +254,42 @@ void SettingsSerializer::SerializeRenderingSettings(YAML::Emitter& out) {
 		out << YAML::Key << "VSync" << YAML::Value << rendering.VSync;
 		out << YAML::Key << "LockFramerate" << YAML::Value << rendering.LockFramerate;
 		out << YAML::Key << "TargetFrameRate" << YAML::Value << rendering.TargetFrameRate;
+		out << YAML::Key << "FrameBudget" << YAML::Value << rendering.FrameBudget;
+
+		out << YAML::Key << "Supersampling" << YAML::Value << YAML::BeginMap; // Supersampling
+		{
+			const auto& supersampling = rendering.Supersampling;
+			out << YAML::Key << "Enabled" << YAML::Value << supersampling.Enabled;
+			out << YAML::Key << "Grid" << YAML::Value << supersampling.Grid;
+			out << YAML::Key << "ColorThreshold" << YAML::Value << supersampling.ColorThreshold;
+			out << YAML::Key << "IterationThreshold" << YAML::Value << supersampling.IterationThreshold;
+		}
+		out << YAML::EndMap; // Supersampling
+
+		out << YAML::Key << "OpenGL" << YAML::Value << YAML::BeginMap; // OpenGL
+		{
+			const auto& openGL = rendering.OpenGL;
+			out << YAML::Key << "Progressive" << YAML::Value << openGL.Progressive;
+		}
+		out << YAML::EndMap; // OpenGL
+
+		out << YAML::Key << "CPU" << YAML::Value << YAML::BeginMap; // CPU
+		{
+			const auto& cpu = rendering.CPU;
+			out << YAML::Key << "SIMD" << YAML::Value << Utilities::InstructionSetToString(cpu.SIMD);
+			out << YAML::Key << "Perturbation" << YAML::Value << cpu.Perturbation;
+			out << YAML::Key << "SeriesApproximation" << YAML::Value << cpu.SeriesApproximation;
+			out << YAML::Key << "AreaSkipping" << YAML::Value << Utilities::AreaSkippingModeToString(cpu.AreaSkipping);
+			out << YAML::Key << "VerifyAreaSkipping" << YAML::Value << cpu.VerifyAreaSkipping;
+			out << YAML::Key << "ZoomReprojection" << YAML::Value << cpu.ZoomReprojection;
+			out << YAML::Key << "Progressive" << YAML::Value << cpu.Progressive;
+			out << YAML::Key << "TileCache" << YAML::Value << cpu.TileCache;
+			out << YAML::Key << "TileCacheSize" << YAML::Value << cpu.TileCacheSize;
+			out << YAML::Key << "TileStore" << YAML::Value << cpu.TileStore;
+			out << YAML::Key << "TileStoreSize" << YAML::Value << cpu.TileStoreSize;
+			out << YAML::Key << "TileStoreFolder" << YAML::Value << cpu.TileStoreFolder.string();
+		}
+		out << YAML::EndMap; // CPU
 	}
 	out << YAML::EndMap; // Rendering
 
@@ -417,6 +456,90 @@ void SettingsSerializer::DeserializeRenderingSettings(const YAML::Node& settings
 		if (const auto& targetFrameRateNode = renderingNode["TargetFrameRate"]) {
 			rendering.TargetFrameRate = targetFrameRateNode.as<int>();
 		}
+
+		if (const auto& frameBudgetNode = renderingNode["FrameBudget"]) {
+			rendering.FrameBudget = frameBudgetNode.as<float>();
+		}
+
+		if (const auto& supersamplingNode = renderingNode["Supersampling"]) {
+			auto& supersampling = rendering.Supersampling;
+
+			if (const auto& enabledNode = supersamplingNode["Enabled"]) {
+				supersampling.Enabled = enabledNode.as<bool>();
+			}
+
+			if (const auto& gridNode = supersamplingNode["Grid"]) {
+				supersampling.Grid = gridNode.as<int>();
+			}
+
+			if (const auto& colorThresholdNode = supersamplingNode["ColorThreshold"]) {
+				supersampling.ColorThreshold = colorThresholdNode.as<float>();
+			}
+
+			if (const auto& iterationThresholdNode = supersamplingNode["IterationThreshold"]) {
+				supersampling.IterationThreshold = iterationThresholdNode.as<int>();
+			}
+		}
+
+		if (const auto& openGLNode = renderingNode["OpenGL"]) {
+			auto& openGL = rendering.OpenGL;
+
+			if (const auto& progressiveNode = openGLNode["Progressive"]) {
+				openGL.Progressive = progressiveNode.as<bool>();
+			}
+		}
+
+		if (const auto& cpuNode = renderingNode["CPU"]) {
+			auto& cpu = rendering.CPU;
+
+			if (const auto& simdNode = cpuNode["SIMD"]) {
+				cpu.SIMD = Utilities::StringToInstructionSet(simdNode.as<std::string>());
+			}
+
+			if (const auto& perturbationNode = cpuNode["Perturbation"]) {
+				cpu.Perturbation = perturbationNode.as<bool>();
+			}
+
+			if (const auto& seriesApproximationNode = cpuNode["SeriesApproximation"]) {
+				cpu.SeriesApproximation = seriesApproximationNode.as<bool>();
+			}
+
+			if (const auto& areaSkippingNode = cpuNode["AreaSkipping"]) {
+				cpu.AreaSkipping = Utilities::StringToAreaSkippingMode(areaSkippingNode.as<std::string>());
+			}
+
+			if (const auto& verifyAreaSkippingNode = cpuNode["VerifyAreaSkipping"]) {
+				cpu.VerifyAreaSkipping = verifyAreaSkippingNode.as<bool>();
+			}
+
+			if (const auto& zoomReprojectionNode = cpuNode["ZoomReprojection"]) {
+				cpu.ZoomReprojection = zoomReprojectionNode.as<bool>();
+			}
+
+			if (const auto& progressiveNode = cpuNode["Progressive"]) {
+				cpu.Progressive = progressiveNode.as<bool>();
+			}
+
+			if (const auto& tileCacheNode = cpuNode["TileCache"]) {
+				cpu.TileCache = tileCacheNode.as<bool>();
+			}
+
+			if (const auto& tileCacheSizeNode = cpuNode["TileCacheSize"]) {
+				cpu.TileCacheSize = tileCacheSizeNode.as<int>();
+			}
+
+			if (const auto& tileStoreNode = cpuNode["TileStore"]) {
+				cpu.TileStore = tileStoreNode.as<bool>();
+			}
+
+			if (const auto& tileStoreSizeNode = cpuNode["TileStoreSize"]) {
+				cpu.TileStoreSize = tileStoreSizeNode.as<int>();
+			}
+
+			if (const auto& tileStoreFolderNode = cpuNode["TileStoreFolder"]) {
+				cpu.TileStoreFolder = tileStoreFolderNode.as<std::string>();
+			}
+		}
 	}
 
 	Log::Trace("SettingsSerializer::DeserializeRenderingSettings - Rendering Settings Deserialized");
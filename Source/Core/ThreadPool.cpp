@@ -0,0 +1,107 @@
+#include "ThreadPool.h"
+
+#include "Core/Log.h"
+#include "Core/Profiler.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(uint32_t threadCount) {
+	if (threadCount == 0) {
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	Log::Trace("ThreadPool::ThreadPool - Spawning " + std::to_string(threadCount - 1) + " worker threads");
+
+	// The calling thread takes part in every job, so we only need `threadCount - 1` workers.
+	m_Workers.reserve(threadCount - 1);
+	for (uint32_t i = 1; i < threadCount; ++i) {
+		m_Workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stopping = true;
+	}
+
+	m_JobAvailable.notify_all();
+
+	for (auto& worker : m_Workers) {
+		worker.join();
+	}
+}
+
+void ThreadPool::ParallelFor(uint32_t count, const std::function<void(uint32_t)>& job) {
+	if (count == 0) {
+		return;
+	}
+
+	// Without workers (or with a single index) there is nothing to distribute.
+	if (m_Workers.empty() || count == 1) {
+		for (uint32_t i = 0; i < count; ++i) {
+			job(i);
+		}
+
+		return;
+	}
+
+	std::lock_guard<std::mutex> dispatchLock(m_DispatchMutex);
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Job = &job;
+		m_JobCount = count;
+		m_NextIndex = 0;
+		m_BusyWorkers = static_cast<uint32_t>(m_Workers.size());
+		++m_Generation;
+	}
+
+	m_JobAvailable.notify_all();
+
+	// Help with the work instead of just waiting for it.
+	RunJob();
+
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	m_JobFinished.wait(lock, [this]() { return m_BusyWorkers == 0; });
+	m_Job = nullptr;
+}
+
+void ThreadPool::WorkerLoop(uint32_t index) {
+	Profiler::SetThreadName("Worker " + std::to_string(index));
+
+	uint64_t lastGeneration = 0;
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_JobAvailable.wait(lock, [this, lastGeneration]() { return m_Stopping || m_Generation != lastGeneration; });
+
+			if (m_Stopping) {
+				return;
+			}
+
+			lastGeneration = m_Generation;
+		}
+
+		RunJob();
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (--m_BusyWorkers == 0) {
+				m_JobFinished.notify_one();
+			}
+		}
+	}
+}
+
+void ThreadPool::RunJob() {
+	MB_PROFILE_SCOPE("ThreadPool::RunJob");
+
+	const auto& job = *m_Job;
+
+	uint32_t index;
+	while ((index = m_NextIndex.fetch_add(1, std::memory_order_relaxed)) < m_JobCount) {
+		job(index);
+	}
+}
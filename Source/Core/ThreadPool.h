@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A fixed-size pool of worker threads used to spread data-parallel work (such as the tiles of a CPU render) across every core of the machine.
+ *
+ * Work is submitted as an indexed job through `ParallelFor`, which blocks until every index has been processed.
+ * The calling thread participates in the work, so a pool created with `N` threads spawns `N - 1` workers.
+ */
+class ThreadPool {
+public:
+	/**
+	 * Constructs the thread pool and spawns its worker threads.
+	 *
+	 * @param threadCount The total number of threads that will execute jobs, including the calling thread. A value of `0` uses every hardware thread of the machine.
+	 */
+	ThreadPool(uint32_t threadCount = 0);
+
+	/**
+	 * Stops and joins every worker thread.
+	 */
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/**
+	 * Invokes `job` once for every index in `[0, count)`, distributing the indices dynamically across the pool.
+	 *
+	 * Indices are handed out one at a time through an atomic counter, so uneven jobs (e.g. tiles with very different iteration counts) balance themselves.
+	 * The call returns once every index has been processed. Calls from different threads are serialized.
+	 *
+	 * @param count The number of indices to process.
+	 * @param job The function to invoke for each index. It must be safe to call concurrently from several threads.
+	 *
+	 * @note `job` must not call `ParallelFor` on the same pool, as that would deadlock.
+	 */
+	void ParallelFor(uint32_t count, const std::function<void(uint32_t)>& job);
+
+	/**
+	 * Gets the total number of threads that execute jobs, including the calling thread.
+	 *
+	 * @return The number of threads of the pool.
+	 */
+	uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_Workers.size()) + 1; }
+private:
+	/**
+	 * The main loop of each worker thread, which sleeps until a new job is published and then helps processing it.
+	 *
+	 * @param index The index of the worker, from `1`, which names its thread in the traces of the profiler.
+	 */
+	void WorkerLoop(uint32_t index);
+
+	/**
+	 * Claims and runs indices of the current job until none are left.
+	 */
+	void RunJob();
+private:
+	/// @brief The worker threads owned by the pool.
+	std::vector<std::thread> m_Workers;
+
+	/// @brief Serializes concurrent calls to `ParallelFor`.
+	std::mutex m_DispatchMutex;
+
+	/// @brief Protects the job state shared with the workers.
+	std::mutex m_Mutex;
+
+	/// @brief Signaled when a new job is published or the pool is stopping.
+	std::condition_variable m_JobAvailable;
+
+	/// @brief Signaled when the last worker finishes its share of the current job.
+	std::condition_variable m_JobFinished;
+
+	/// @brief The job currently being processed, or `nullptr` when idle.
+	const std::function<void(uint32_t)>* m_Job = nullptr;
+
+	/// @brief The number of indices of the current job.
+	uint32_t m_JobCount = 0;
+
+	/// @brief The next index of the current job to be claimed.
+	std::atomic<uint32_t> m_NextIndex = 0;
+
+	/// @brief The number of workers that have not finished the current job yet.
+	uint32_t m_BusyWorkers = 0;
+
+	/// @brief Incremented every time a job is published, so workers can tell new jobs apart from spurious wake-ups.
+	uint64_t m_Generation = 0;
+
+	/// @brief Set when the pool is being destroyed.
+	bool m_Stopping = false;
+};
@@ -1,6 +1,7 @@
 #include "ThemeSerializer.h"
 
 #include "Core/Log.h"
+#include "Core/Profiler.h"
 
 #include "Utilities/Utilities.h"
 
@@ -113,6 +114,8 @@ bool ThemeSerializer::Serialize(const std::filesystem::path& filepath) {
 }
 
 bool ThemeSerializer::Deserialize(const std::filesystem::path& filepath) {
+	MB_PROFILE_SCOPE("ThemeSerializer::Deserialize");
+
 	YAML::Node data;
 
 	try {
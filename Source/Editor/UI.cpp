@@ -2,6 +2,7 @@
 
 #include "Core/Log.h"
 #include "Core/Application.h"
+#include "Core/Profiler.h"
 #include "Core/Settings/SettingsManager.h"
 
 #include "Editor/Payload.h"
@@ -66,6 +67,8 @@ void UI::Shutdown() {
 }
 
 void UI::Begin() {
+	MB_PROFILE_SCOPE("UI::Begin");
+
 	ImGui_ImplOpenGL3_NewFrame();
 	ImGui_ImplGlfw_NewFrame();
 	ImGui::NewFrame();
@@ -76,6 +79,8 @@ void UI::Begin() {
 }
 
 void UI::End() {
+	MB_PROFILE_SCOPE("UI::End");
+
 	ImGuiIO& io = ImGui::GetIO();
 	Application& app = Application::Get();
 	io.DisplaySize = ImVec2((float)app.GetWidth(), (float)app.GetHeight());
@@ -198,6 +203,19 @@ bool UI::Vec2(const char* label, glm::vec2& value, float resetValue) {
 	return changedX || changedY;
 }
 
+bool UI::Vec2(const char* label, glm::dvec2& value, double resetValue, float speed) {
+	BeginPropertyGrid(label);
+	ImGui::BeginTable(label, 2);
+
+	ImGui::TableNextColumn(); bool changedX = VecComponent("X", value.x, resetValue, speed, Color::Red);
+	ImGui::TableNextColumn(); bool changedY = VecComponent("Y", value.y, resetValue, speed, Color::Green);
+
+	ImGui::EndTable();
+	EndPropertyGrid();
+
+	return changedX || changedY;
+}
+
 bool UI::Vec3(const char* label, glm::vec3& value, float resetValue) {
 	BeginPropertyGrid(label);
 	ImGui::BeginTable(label, 3);
@@ -329,6 +347,13 @@ bool UI::SliderFloat(float& value, float min, float max) {
 	return ImGui::SliderFloat(s_EmptyLabel, &value, min, max);
 }
 
+bool UI::DragDouble(const char* label, double& value, double min, double max, float speed, const char* format) {
+	BeginPropertyGrid(label);
+	bool changed = ImGui::DragScalar(HiddenLabel(label), ImGuiDataType_Double, &value, speed, &min, &max, format);
+	EndPropertyGrid();
+	return changed;
+}
+
 bool UI::DragInt(const char* label, int& value, int min, int max, float speed) {
 	BeginPropertyGrid(label);
 	bool changed = ImGui::DragInt(HiddenLabel(label), &value, speed, min, max);
@@ -667,6 +692,33 @@ bool UI::VecComponent(const char* label, float& value, float resetValue, const I
 	return changed;
 }
 
+bool UI::VecComponent(const char* label, double& value, double resetValue, float speed, const ImVec4& buttonColor) {
+	bool changed = false;
+
+	ImGui::PushID(label);
+
+	float lineHeight = GImGui->FontSize + GImGui->Style.FramePadding.y * 2.0f;
+	ImVec2 buttonSize = { lineHeight, lineHeight };
+
+	ImGui::PushStyleColor(ImGuiCol_Button, buttonColor);
+	if (ImGui::Button(label, buttonSize)) {
+		value = resetValue;
+		changed = true;
+	}
+	ImGui::PopStyleColor();
+
+	ImGui::SameLine();
+	ImGui::PushItemWidth(-1.0f);
+
+	// Enough digits to edit deep-zoom coordinates
+	changed |= ImGui::DragScalar(HiddenLabel(label), ImGuiDataType_Double, &value, speed, nullptr, nullptr, "%.17g");
+	ImGui::PopItemWidth();
+
+	ImGui::PopID();
+
+	return changed;
+}
+
 bool UI::AssetSlot(const char* label, std::filesystem::path& assetFilepath, Ref<Texture2D> icon, const char* payloadID) {
 	bool changed = false;
 	BeginPropertyGrid(label);
@@ -30,6 +30,7 @@ private:
 public:
 	// Vector widgets with Label
 	static bool Vec2(const char* label, glm::vec2& value, float resetValue = 0.0f);
+	static bool Vec2(const char* label, glm::dvec2& value, double resetValue = 0.0, float speed = 0.1f);
 	static bool Vec3(const char* label, glm::vec3& value, float resetValue = 0.0f);
 	static bool Vec4(const char* label, glm::vec4& value, float resetValue = 0.0f);
 
@@ -62,6 +63,9 @@ public:
 	static bool DragFloat(float& value, float min = 0.0f, float max = 0.0f, float speed = 0.01f);
 	static bool SliderFloat(float& value, float min = 0.0f, float max = 0.0f);
 
+	// Double widgets with Label
+	static bool DragDouble(const char* label, double& value, double min = 0.0, double max = 0.0, float speed = 0.01f, const char* format = "%.6g");
+
 	// Int widgets with Label
 	static bool DragInt(const char* label, int& value, int min = 0, int max = 0, float speed = 0.01f);
 	static bool SliderInt(const char* label, int& value, int min = 0, int max = 0);
@@ -125,6 +129,7 @@ private:
 	static void EndPropertyGrid();
 
 	static bool VecComponent(const char* label, float& value, float resetValue, const ImVec4& buttonColor);
+	static bool VecComponent(const char* label, double& value, double resetValue, float speed, const ImVec4& buttonColor);
 
 	static bool AssetSlot(const char* label, std::filesystem::path& assetFilepath, Ref<Texture2D> icon, const char* payloadID);
 
@@ -6,6 +6,9 @@
 
 #include "Utilities/Utilities.h"
 
+#include <algorithm>
+#include <cmath>
+
 InspectorWindow::InspectorWindow(bool& isOpen, FractalState& fractalState)
 	: BaseWindow(isOpen), m_FractalState(fractalState)
 {}
@@ -22,7 +25,8 @@ void InspectorWindow::OnAttach() {
 	m_ColorAlgorithms = {
 		ColorAlgorithm::Step,
 		ColorAlgorithm::Smooth,
-		ColorAlgorithm::DistanceEstimation
+		ColorAlgorithm::DistanceEstimation,
+		ColorAlgorithm::Histogram
 	};
 
 	m_InteriorColorAlgorithms = {
@@ -63,7 +67,10 @@ void InspectorWindow::OnUIRender() {
 			UI::Tooltip("The exponent 'n' in the formula z = z^n + c.\nCreates different fractal shapes (Multibrot sets).\nCan be controlled using the 'Page Up' and 'Page Down' keys.");
 
 			UI::SliderInt("Max Iterations", mandelbrot.MaxIterations, 32, 8192);
-			UI::Tooltip("The maximum number of calculations per pixel.\nHigher values reveal more detail but are slower.");
+			UI::Tooltip("The maximum number of calculations per pixel.\nHigher values reveal more detail but are slower.\nWith automatic iterations, this is the most the budget can grow to.");
+
+			UI::Bool("Auto Iterations", mandelbrot.AutoIterations);
+			UI::Tooltip("Picks the iteration limit of every frame from the zoom depth and from how the pixels of the previous frame escaped.\nThe limit rises while many pixels escape close to it or never escape, and falls back when they all escape well below it.");
 
 			UI::DragFloat("Bailout Radius", mandelbrot.Bailout, 4.0f, 65536.0f);
 			UI::Tooltip("The escape boundary.\nIf a point's magnitude exceeds this value, it has escaped.\nAffects edge detail.");
@@ -82,32 +89,39 @@ void InspectorWindow::OnUIRender() {
 		}
 
 		if (UI::CollapsingHeader("View")) {
-			UI::DragFloat("Zoom", mandelbrot.Zoom, 0.01f, 10000.0f, 0.1f);
-			UI::Tooltip("Magnification level of the fractal.");
-
 			{
-				// Convert world position to screen space for display.
-				float rotation = glm::radians(mandelbrot.Rotation);
+				// The zoom spans hundreds of orders of magnitude, so its exponent is edited instead, at the same speed at any depth
+				double zoomExponent = std::log10(mandelbrot.Zoom);
 
-				glm::mat2 worldToScreen = {
-					{ cos(rotation), -sin(rotation) },
-					{ sin(rotation),  cos(rotation) }
-				};
+				if (UI::DragDouble("Zoom", zoomExponent, -2.0, 300.0, 0.01f, "10^%.3f")) {
+					mandelbrot.Zoom = std::pow(10.0, zoomExponent);
+				}
 
-				glm::vec2 screenPosition = worldToScreen * mandelbrot.Position;
-				glm::vec2 originalScreenPosition = screenPosition;
+				UI::Tooltip("Magnification level of the fractal, as a power of ten.\nPast the limits of single precision, rendering switches to double precision automatically,\nand past the limits of double precision, to perturbation on the CPU engine.");
+			}
 
-				UI::Vec2("Position", screenPosition);
-				UI::Tooltip("Pans the view across the complex plane.");
+			{
+				// The center carries more digits than a double, so it is only displayed, to the digits the zoom resolves
+				const uint32_t positionDigits = (uint32_t)std::ceil(std::log10(std::max(mandelbrot.Zoom, 1.0))) + 8;
+				UI::DisabledText("Center", mandelbrot.Position.x.ToString(positionDigits) + ", " + mandelbrot.Position.y.ToString(positionDigits));
+				UI::Tooltip("The point of the complex plane at the center of the view.");
+
+				// The pan is dragged as an offset in view units (the height of the view is 2), which starts from zero every frame
+				glm::dvec2 offset(0.0);
 
-				if (screenPosition != originalScreenPosition) {
-					glm::mat2 screenToWorld = {
+				if (UI::Vec2("Pan", offset, 0.0, 0.01f)) {
+					double rotation = glm::radians((double)mandelbrot.Rotation);
+
+					glm::dmat2 screenToWorld = {
 						{  cos(rotation), sin(rotation) },
 						{ -sin(rotation), cos(rotation) }
 					};
 
-					mandelbrot.Position = screenToWorld * screenPosition;
+					// Scaled to the plane in arbitrary precision, so the edit keeps every digit of the center at any depth
+					mandelbrot.Position += BigVec2(screenToWorld * offset) * (1.0 / mandelbrot.Zoom);
 				}
+
+				UI::Tooltip("Pans the view across the complex plane, by a fraction of its size.");
 			}
 
 			UI::SliderFloat("Rotation", mandelbrot.Rotation, 0.0f, 360.0f);
@@ -118,7 +132,7 @@ void InspectorWindow::OnUIRender() {
 
 		if (UI::CollapsingHeader("Coloring")) {
 			UI::Dropdown("Exterior", m_ColorAlgorithms, mandelbrot.ExteriorColoring, Utilities::ColorAlgorithmToString);
-			UI::Tooltip("Algorithm for coloring the area outside the set.");
+			UI::Tooltip("Algorithm for coloring the area outside the set.\n'Histogram' spreads the palette evenly over the pixels of the view, so deep views need no frequency tuning.");
 
 			UI::Dropdown("Interior", m_InteriorColorAlgorithms, mandelbrot.InteriorColoring, Utilities::InteriorColorAlgorithmToString);
 			UI::Tooltip("Algorithm for coloring the area inside the set.");
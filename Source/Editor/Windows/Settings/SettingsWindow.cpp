@@ -81,7 +81,22 @@ void SettingsWindow::OnAttach() {
 	m_RenderingEngines = {
 		RenderingEngine::OpenGL,
 		RenderingEngine::DirectX,
-		RenderingEngine::Vulkan
+		RenderingEngine::Vulkan,
+		RenderingEngine::CPU
+	};
+
+	m_InstructionSets = {
+		InstructionSet::Auto,
+		InstructionSet::Scalar,
+		InstructionSet::SSE2,
+		InstructionSet::AVX2,
+		InstructionSet::AVX512
+	};
+
+	m_AreaSkippingModes = {
+		AreaSkippingMode::None,
+		AreaSkippingMode::MarianiSilver,
+		AreaSkippingMode::SolidGuessing
 	};
 
 	m_WindowModes = {
@@ -297,7 +312,7 @@ void SettingsWindow::DrawNavigationSettings(NavigationSettings& navigation) {
 
 void SettingsWindow::DrawRenderingSettings(RenderingSettings& rendering) {
 	UI::Dropdown("Engine", m_RenderingEngines, rendering.Engine, Utilities::RenderingEngineToString);
-	UI::Tooltip("Select a Rendering API.\nCurrently, only OpenGL is supported.");
+	UI::Tooltip("Select a Rendering API.\nCurrently, only OpenGL and the multi-threaded CPU renderer are supported.");
 
 	UI::Dropdown("Window Mode", m_WindowModes, rendering.Mode, Utilities::WindowModeToString);
 	UI::Tooltip("Windowed: standard window.\nFullscreen: exclusive fullscreen.\nBorderless: borderless window covering the screen.");
@@ -330,7 +345,80 @@ void SettingsWindow::DrawRenderingSettings(RenderingSettings& rendering) {
 		UI::Tooltip("Frame rate cap in FPS. Set to 0 for uncapped rendering.");
 	}
 
+	UI::DragFloat("Frame Budget", rendering.FrameBudget, 1.0f, 100.0f, 0.1f);
+	UI::Tooltip("The time in milliseconds a frame may spend iterating a view rendered over several frames\n(progressive rendering on either engine, or the refinement of a reprojected view on the CPU engine).\nOn the CPU engine, every thread still iterates at least one tile per frame.\nOn the OpenGL engine, the passes are timed on the GPU a few frames later, and at least one runs per frame.");
+
+	auto& supersampling = rendering.Supersampling;
+
+	UI::Bool("Supersampling", supersampling.Enabled);
+	UI::Tooltip("Antialiases the image by iterating extra samples only for the pixels that need them:\nthose whose neighbours differ from them, and those the distance estimate puts near the boundary.");
+
+	if (supersampling.Enabled) {
+		UI::DragInt("Supersampling Grid", supersampling.Grid, 2, 8);
+		UI::Tooltip("A supersampled pixel gets Grid x Grid extra jittered samples, averaged with it.");
+
+		UI::DragFloat("Color Threshold", supersampling.ColorThreshold, 0.0f, 1.0f, 0.005f);
+		UI::Tooltip("The difference of any color channel (from 0 to 1) past which two neighbouring pixels are supersampled.");
+
+		UI::DragInt("Iteration Threshold", supersampling.IterationThreshold, 0, 1000, 0.1f);
+		UI::Tooltip("The difference of iteration count past which two neighbouring pixels are supersampled.");
+	}
+
 	UI::Separator();
+
+	if (UI::CollapsingHeader("OpenGL Engine")) {
+		auto& openGL = rendering.OpenGL;
+
+		UI::Bool("Progressive", openGL.Progressive);
+		UI::Tooltip("Renders a new view coarse to fine: one pixel in 64 in the first frame,\nthen the interleaved pixels left over the following frames, within the frame budget.\nThe finished image is identical to a full render.");
+
+		UI::Separator();
+	}
+
+	if (UI::CollapsingHeader("CPU Engine")) {
+		auto& cpu = rendering.CPU;
+
+		UI::Dropdown("SIMD", m_InstructionSets, cpu.SIMD, Utilities::InstructionSetToString);
+		UI::Tooltip("The vector instruction set used by the CPU engine.\nAuto picks the widest one supported by this processor.\nForcing an unsupported level falls back to the best available one.");
+
+		UI::Bool("Perturbation", cpu.Perturbation);
+		UI::Tooltip("Renders views deeper than double precision can resolve with perturbation theory.\nEvery pixel is iterated as an offset from a high-precision reference orbit of the view center.\nOnly the quadratic Mandelbrot set supports it; the OpenGL engine hands these views over to the CPU engine.");
+
+		UI::Bool("Series Approximation", cpu.SeriesApproximation);
+		UI::Tooltip("Skips the first iterations of every pixel by evaluating a series approximation of its orbit.\nDisabled automatically when an orbit trap is active.");
+
+		UI::Dropdown("Area Skipping", m_AreaSkippingModes, cpu.AreaSkipping, Utilities::AreaSkippingModeToString);
+		UI::Tooltip("Fills uniform regions of the image without iterating their pixels.\nMariani-Silver fills rectangles whose border has a single iteration count, and splits the others.\nSolid Guessing refines a coarse grid and guesses the blocks whose corners agree.\nOnly regions whose color follows from the iteration count are filled (interior, or Step coloring).");
+
+		UI::Bool("Verify Area Skipping", cpu.VerifyAreaSkipping);
+		UI::Tooltip("Checks more pixels before filling a region, which catches thin details crossing it.");
+
+		UI::Bool("Zoom Reprojection", cpu.ZoomReprojection);
+		UI::Tooltip("While zooming or rotating, shows the previous image resampled to the new view straight away,\nthen refines it tile by tile over the following frames, starting from the center.\nRefined tiles are identical to a full render.");
+
+		UI::Bool("Progressive", cpu.Progressive);
+		UI::Tooltip("Renders a new view coarse to fine: one pixel in 16 in the first frame,\nthen the interleaved pixels left over the following frames, within the frame budget.\nOnly used without area skipping. The finished image is identical to a full render.");
+
+		UI::Bool("Tile Cache", cpu.TileCache);
+		UI::Tooltip("Samples the views from tiles aligned to the power-of-two zoom levels, kept in memory once rendered.\nZooming back in or loading a view again only renders the tiles missing from the cache.\nThe tiles are at most a pixel apart, so the image is slightly resampled.\nViews deep enough for perturbation bypass the cache.");
+
+		UI::DragInt("Tile Cache Size (MB)", cpu.TileCacheSize, 0, 16384, 1.0f);
+		UI::Tooltip("The memory the tile cache may take, or 0 to size it from the viewport (a few views worth of tiles).\nThe least recently used tiles are evicted past it, and views needing more tiles than it holds are rendered without the cache.");
+
+		UI::Bool("Tile Store", cpu.TileStore);
+		UI::Tooltip("Also keeps the rendered tiles in a memory-mapped file that persists across sessions,\nso the views rendered before (deep ones included) load from disk instead of being iterated again.\nEvery tile is checked against its checksum before use.");
+
+		UI::DragInt("Tile Store Size (MB)", cpu.TileStoreSize, 16, 262144, 1.0f);
+		UI::Tooltip("The size of the file of the tile store.\nThe least recently used tiles are evicted past it.");
+
+		std::string tileStoreFolder = cpu.TileStoreFolder.string();
+		if (UI::InputText("Tile Store Folder", tileStoreFolder)) {
+			cpu.TileStoreFolder = tileStoreFolder;
+		}
+		UI::Tooltip("The folder the file of the tile store is kept in.");
+
+		UI::Separator();
+	}
 }
 
 void SettingsWindow::DrawWIP() {
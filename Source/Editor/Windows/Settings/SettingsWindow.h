@@ -34,4 +34,6 @@ private:
 	std::vector<RenderingEngine> m_RenderingEngines;
 	std::vector<WindowMode> m_WindowModes;
 	std::vector<ExportImageFormat> m_ExportImageFormats;
+	std::vector<InstructionSet> m_InstructionSets;
+	std::vector<AreaSkippingMode> m_AreaSkippingModes;
 };
\ No newline at end of file
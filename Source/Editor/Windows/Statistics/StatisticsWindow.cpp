@@ -1,6 +1,14 @@
 #include "StatisticsWindow.h"
 
 #include "Core/Log.h"
+#include "Core/Settings/SettingsManager.h"
+
+#include "Renderer/Renderer.h"
+
+#include "Utilities/Utilities.h"
+
+#include <algorithm>
+#include <cstdio>
 
 StatisticsWindow::StatisticsWindow(bool& isOpen)
 	: BaseWindow(isOpen)
@@ -23,10 +31,135 @@ void StatisticsWindow::OnUIRender() {
 
 	ImGui::Begin("Statistics", &m_IsOpen);
 
-	ImGuiIO& io = ImGui::GetIO();
-	ImGui::Text("WantCaptureMouse: %d", io.WantCaptureMouse);
-	ImGui::Text("WantCaptureKeyboard: %d", io.WantCaptureKeyboard);
-	ImGui::Text("Mouse Position: (%.1f, %.1f)", io.MousePos.x, io.MousePos.y);
+	DrawPerformance();
+
+	const CPURenderer* cpuRenderer = Renderer::GetCPURenderer();
+	if (Renderer::GetActiveEngine() == RenderingEngine::CPU && cpuRenderer) {
+		DrawCPUEngine();
+	}
 
 	ImGui::End();
 }
+
+void StatisticsWindow::DrawPerformance() {
+	const auto& resolution = SettingsManager::Get().Rendering.Resolution;
+	const Ref<Framebuffer> framebuffer = Renderer::GetFramebuffer();
+
+	const uint32_t width = framebuffer ? framebuffer->GetWidth() : 0;
+	const uint32_t height = framebuffer ? framebuffer->GetHeight() : 0;
+
+	ImGui::Text("Engine: %s", Utilities::RenderingEngineToString(Renderer::GetActiveEngine()).c_str());
+	ImGui::Text("Render Resolution: %u x %u (%.2f MP, Scale %.2f)", width, height, (double)width * height * 1e-6, resolution.Scale);
+	ImGui::Text("Iteration Limit: %d (%s)", IterationBudget::GetLimit(), IterationBudget::IsAutomatic() ? "Automatic" : "Manual");
+
+	const RollingStatistic& frameTime = FrameTimings::GetFrameTime();
+	ImGui::Text("Frame Rate: %.1f FPS", frameTime.GetAverage() > 0.0 ? 1000.0 / frameTime.GetAverage() : 0.0);
+
+	ImGui::Separator();
+
+	// Frames that do not render (a static view) do not count towards the render timings, so these are averaged over the rendered frames only
+	if (ImGui::BeginTable("##StatisticsTimings", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp)) {
+		ImGui::TableSetupColumn("Timing (ms)");
+		ImGui::TableSetupColumn("Last");
+		ImGui::TableSetupColumn("Min");
+		ImGui::TableSetupColumn("Avg");
+		ImGui::TableSetupColumn("P99");
+		ImGui::TableHeadersRow();
+
+		DrawTimingRow("Frame", frameTime);
+		DrawTimingRow("CPU", FrameTimings::GetCPUTime());
+		DrawTimingRow("UI", FrameTimings::GetUITime());
+		DrawTimingRow("Render", FrameTimings::GetRenderTime());
+		DrawTimingRow("GPU", FrameTimings::GetGPUTime());
+
+		ImGui::EndTable();
+	}
+
+	DrawTimingGraph("Frame", frameTime);
+	DrawTimingGraph("CPU", FrameTimings::GetCPUTime());
+	DrawTimingGraph("Render", FrameTimings::GetRenderTime());
+	DrawTimingGraph("GPU", FrameTimings::GetGPUTime());
+
+	ImGui::Separator();
+
+	const RollingStatistic& pixelRate = FrameTimings::GetPixelRate();
+	const RollingStatistic& iterationRate = FrameTimings::GetIterationRate();
+
+	ImGui::Text("Pixels: %.1f MP/s (min %.1f, avg %.1f)", pixelRate.GetLatest() * 1e-6, pixelRate.GetMinimum() * 1e-6, pixelRate.GetAverage() * 1e-6);
+
+	// The shader cannot count the iterations of its pixels
+	if (Renderer::GetActiveEngine() == RenderingEngine::CPU) {
+		ImGui::Text("Iterations: %.3f Giter/s (min %.3f, avg %.3f)", iterationRate.GetLatest() * 1e-9, iterationRate.GetMinimum() * 1e-9, iterationRate.GetAverage() * 1e-9);
+	} else {
+		ImGui::TextDisabled("Iterations: not counted by the OpenGL engine");
+	}
+}
+
+void StatisticsWindow::DrawCPUEngine() {
+	const CPURenderer* cpuRenderer = Renderer::GetCPURenderer();
+	const auto& stats = cpuRenderer->GetStatistics();
+
+	ImGui::Separator();
+	ImGui::Text("CPU Engine");
+	ImGui::Text("Kernel: %s", stats.UsedSIMD ? Utilities::InstructionSetToString(stats.SIMD).c_str() : "Scalar");
+	ImGui::Text("Threads: %u", stats.ThreadCount);
+	ImGui::Text("Frame Time: %.2f ms", stats.FrameTime);
+	ImGui::Text("Orbits: %s (%.2f ms)", stats.ReusedOrbits ? "Reused" : "Iterated", stats.IterationTime);
+	ImGui::Text("Iterations: %llu", (unsigned long long)stats.Iterations);
+	ImGui::Text("Throughput: %.3f Giter/s", stats.GigaIterationsPerSecond);
+
+	const uint64_t pixelCount = std::max<uint64_t>((uint64_t)cpuRenderer->GetWidth() * cpuRenderer->GetHeight(), 1);
+	ImGui::Text("Interior Rejected: %llu pixels (%.1f%%)", (unsigned long long)stats.RejectedPixels, 100.0 * (double)stats.RejectedPixels / (double)pixelCount);
+	ImGui::Text("Area Skipped: %llu pixels (%.1f%%)", (unsigned long long)stats.SkippedPixels, 100.0 * (double)stats.SkippedPixels / (double)pixelCount);
+	ImGui::Text("Panned: %llu pixels (%.1f%%)", (unsigned long long)stats.PannedPixels, 100.0 * (double)stats.PannedPixels / (double)pixelCount);
+	ImGui::Text("Pending Refinement: %u tiles", stats.PendingTiles);
+	ImGui::Text("Tile Cache: %u tiles, %u rendered (%.1f MB)", stats.CachedTiles, stats.RenderedTiles, (double)stats.TileCacheSize / (1024.0 * 1024.0));
+	ImGui::Text("Tile Store: %u tiles loaded (%u stored)", stats.LoadedTiles, stats.StoredTiles);
+	ImGui::Text("Supersampled: %llu pixels (%.1f%%, %.2f ms)", (unsigned long long)stats.SupersampledPixels, 100.0 * (double)stats.SupersampledPixels / (double)pixelCount, stats.SupersamplingTime);
+
+	if (stats.Perturbation) {
+		ImGui::Separator();
+		ImGui::Text("Perturbation");
+		ImGui::Text("Reference Orbit: %u iterations", stats.ReferenceIterations);
+		ImGui::Text("Skipped Iterations: %d", stats.SkippedIterations);
+		ImGui::Text("Rebases: %llu", (unsigned long long)stats.Rebases);
+	}
+}
+
+void StatisticsWindow::DrawTimingRow(const char* label, const RollingStatistic& statistic) {
+	ImGui::TableNextRow();
+
+	ImGui::TableNextColumn();
+	ImGui::TextUnformatted(label);
+
+	if (statistic.IsEmpty()) {
+		for (int column = 0; column < 4; ++column) {
+			ImGui::TableNextColumn();
+			ImGui::TextDisabled("-");
+		}
+
+		return;
+	}
+
+	ImGui::TableNextColumn();
+	ImGui::Text("%.2f", statistic.GetLatest());
+	ImGui::TableNextColumn();
+	ImGui::Text("%.2f", statistic.GetMinimum());
+	ImGui::TableNextColumn();
+	ImGui::Text("%.2f", statistic.GetAverage());
+	ImGui::TableNextColumn();
+	ImGui::Text("%.2f", statistic.GetPercentile(0.99));
+}
+
+void StatisticsWindow::DrawTimingGraph(const char* label, const RollingStatistic& statistic) {
+	if (statistic.IsEmpty()) {
+		return;
+	}
+
+	char overlay[64];
+	std::snprintf(overlay, sizeof(overlay), "%s: %.2f ms avg, %.2f ms p99", label, statistic.GetAverage(), statistic.GetPercentile(0.99));
+
+	ImGui::PushID(label);
+	ImGui::PlotLines("##TimingGraph", statistic.GetValues(), statistic.GetCount(), statistic.GetOffset(), overlay, 0.0f, std::max((float)statistic.GetMaximum() * 1.1f, 1.0f), ImVec2(-1.0f, 48.0f));
+	ImGui::PopID();
+}
@@ -2,6 +2,8 @@
 
 #include "Editor/BaseWindow.h"
 
+#include "Core/FrameTimings.h"
+
 class StatisticsWindow : public BaseWindow {
 public:
 	StatisticsWindow(bool& isOpen);
@@ -10,4 +12,13 @@ public:
 	virtual void OnDetach() override;
 	virtual void OnUpdate(Timestep ts) override;
 	virtual void OnUIRender() override;
-};
\ No newline at end of file
+private:
+	void DrawPerformance();
+	void DrawCPUEngine();
+
+	// A row of the timings table: the latest value, then the minimum, average and 99th percentile of the last frames
+	void DrawTimingRow(const char* label, const RollingStatistic& statistic);
+
+	// The last values of a timing, from zero to the slowest of them
+	void DrawTimingGraph(const char* label, const RollingStatistic& statistic);
+};
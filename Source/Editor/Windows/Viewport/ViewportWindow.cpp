@@ -45,16 +45,17 @@ void ViewportWindow::OnUpdate(Timestep ts) {
 		if (glm::length(moveDirection) > 0.0f) {
 			moveDirection = glm::normalize(moveDirection);
 
-			float rotationRadians = glm::radians(m_FractalState.Target.Rotation);
+			double rotationRadians = glm::radians((double)m_FractalState.Target.Rotation);
 
-			glm::mat2 rotationMatrix = {
+			glm::dmat2 rotationMatrix = {
 				{ cos(rotationRadians), -sin(rotationRadians) },
 				{ sin(rotationRadians),  cos(rotationRadians) }
 			};
 
-			glm::vec2 rotatedMoveDirection = rotationMatrix * moveDirection;
+			// Navigate in double precision, otherwise small steps are lost at deep zooms
+			glm::dvec2 rotatedMoveDirection = rotationMatrix * glm::dvec2(moveDirection);
 
-			m_FractalState.Target.Position += rotatedMoveDirection * nav.MovementSpeed * (float)ts / m_FractalState.Target.Zoom;
+			m_FractalState.Target.Position += BigVec2(rotatedMoveDirection * ((double)nav.MovementSpeed * (double)ts / m_FractalState.Target.Zoom));
 		}
 
 		const auto& scrollOffset = Input::GetScrollOffset();
@@ -98,9 +99,13 @@ void ViewportWindow::OnUpdate(Timestep ts) {
 		}
 	}
 
+	// An unchanged view is still in the framebuffer, so a static view costs no rendering at all
+	if (Renderer::IsUpToDate(m_FractalState.Current)) {
+		return;
+	}
+
 	Renderer::Begin();
-	m_FractalState.Current.ColorPalette.PrepareForShader();
-	Renderer::Submit(m_FractalState.Current);
+	Renderer::Submit(m_FractalState.Current, m_FractalState.IsSettled());
 	Renderer::End();
 }
 
@@ -0,0 +1,240 @@
+#include "BatchRenderer.h"
+
+#include "Core/Image.h"
+#include "Core/Log.h"
+#include "Core/Settings/SettingsManager.h"
+
+#include "Layers/Mandelbrot/MandelbrotSerializer.h"
+
+#include "Renderer/IterationBudget.h"
+
+#include "Utilities/Utilities.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+// The file extension of each image format
+static std::string GetImageExtension(ExportImageFormat format) {
+	switch (format) {
+		case ExportImageFormat::JPEG:	return ".jpg";
+		case ExportImageFormat::BMP:	return ".bmp";
+		case ExportImageFormat::PNG:
+		default:						return ".png";
+	}
+}
+
+int BatchRenderer::Run(const CommandLine& commandLine) {
+	if (commandLine.HasOption("help")) {
+		PrintUsage();
+		return 0;
+	}
+
+	if (commandLine.GetArguments().empty()) {
+		PrintUsage();
+		return 1;
+	}
+
+	const Settings& settings = SettingsManager::Get();
+
+	// The options default to the settings of the application
+	const int width = commandLine.GetInt("width", settings.Rendering.Resolution.Width);
+	const int height = commandLine.GetInt("height", settings.Rendering.Resolution.Height);
+
+	if (width <= 0 || height <= 0) {
+		Log::Error("BatchRenderer::Run - The size of the images must be positive");
+		return 1;
+	}
+
+	SupersamplingSettings supersampling = settings.Rendering.Supersampling;
+	if (commandLine.HasOption("supersampling")) {
+		supersampling.Grid = commandLine.GetInt("supersampling", 0);
+		supersampling.Enabled = supersampling.Grid > 0;
+	}
+
+	std::string formatName = commandLine.GetOption("format", Utilities::ExportImageFormatToString(settings.Export.ImageFormat));
+	std::transform(formatName.begin(), formatName.end(), formatName.begin(), [](unsigned char c) { return (char)std::toupper(c); });
+
+	const ExportImageFormat format = Utilities::StringToExportImageFormat(formatName == "JPG" ? "JPEG" : formatName);
+	const int quality = commandLine.GetInt("quality", settings.Export.ImageQuality);
+	const std::filesystem::path outputFolder = commandLine.GetOption("output", (settings.Export.Folder / "Batch").string());
+
+	std::vector<std::filesystem::path> inputs;
+	for (const std::string& argument : commandLine.GetArguments()) {
+		inputs.emplace_back(argument);
+	}
+
+	const std::vector<BatchFile> files = CollectFiles(inputs);
+	if (files.empty()) {
+		Log::Error("BatchRenderer::Run - No .fractal file to render");
+		return 1;
+	}
+
+	// Small batches give every worker more threads, large ones render a file per thread, which scales best
+	const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+	const uint32_t requestedWorkers = (uint32_t)std::max(commandLine.GetInt("workers", 0), 0);
+	const uint32_t workerCount = std::min(requestedWorkers > 0 ? requestedWorkers : hardwareThreads, (uint32_t)files.size());
+	const uint32_t threadsPerWorker = std::max(1u, hardwareThreads / workerCount);
+
+	const CPURenderingSettings cpuSettings = GetFrameSettings(settings.Rendering.CPU);
+	const std::string extension = GetImageExtension(format);
+
+	std::printf("Rendering %zu fractals at %dx%d with %u workers of %u threads\n", files.size(), width, height, workerCount, threadsPerWorker);
+
+	std::atomic<size_t> nextFile = 0;
+	std::atomic<size_t> renderedFiles = 0;
+	std::atomic<uint64_t> totalIterations = 0;
+	std::mutex outputMutex;
+
+	const auto start = std::chrono::steady_clock::now();
+
+	const auto work = [&]() {
+		CPURenderer renderer(threadsPerWorker);
+
+		for (size_t index = nextFile++; index < files.size(); index = nextFile++) {
+			const BatchFile& file = files[index];
+
+			Mandelbrot mandelbrot;
+			MandelbrotSerializer serializer(mandelbrot);
+
+			if (!serializer.Deserialize(file.Filepath)) {
+				std::lock_guard<std::mutex> lock(outputMutex);
+				std::printf("[%zu/%zu] %s: cannot load the file\n", index + 1, files.size(), file.Filepath.string().c_str());
+				continue;
+			}
+
+			const auto renderStart = std::chrono::steady_clock::now();
+			const int iterations = RenderFrame(renderer, mandelbrot, (uint32_t)width, (uint32_t)height, cpuSettings, supersampling);
+			const std::chrono::duration<double, std::milli> renderTime = std::chrono::steady_clock::now() - renderStart;
+
+			const std::filesystem::path output = outputFolder / (file.Name.string() + extension);
+
+			std::error_code error;
+			std::filesystem::create_directories(output.parent_path(), error);
+
+			const bool written = Image::Write(output, (uint32_t)width, (uint32_t)height, renderer.GetPixels().data(), format, quality);
+
+			if (written) {
+				++renderedFiles;
+				totalIterations += renderer.GetStatistics().Iterations;
+			}
+
+			std::lock_guard<std::mutex> lock(outputMutex);
+			std::printf("[%zu/%zu] %s: %.1f ms, iteration limit %d%s\n", index + 1, files.size(), file.Filepath.string().c_str(), renderTime.count(), iterations, written ? "" : ", cannot write the image");
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (uint32_t i = 1; i < workerCount; ++i) {
+		workers.emplace_back(work);
+	}
+
+	work();
+
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	const double seconds = std::max(elapsed.count(), 1e-9);
+	const double pixels = (double)renderedFiles.load() * width * height;
+
+	std::printf("Rendered %zu of %zu fractals in %.2f s: %.2f images/s, %.1f Mpixels/s, %.2f Giter/s\n",
+		renderedFiles.load(), files.size(), seconds, (double)renderedFiles.load() / seconds, pixels / seconds * 1e-6, (double)totalIterations.load() / seconds * 1e-9);
+
+	return renderedFiles.load() == files.size() ? 0 : 1;
+}
+
+std::vector<BatchFile> BatchRenderer::CollectFiles(const std::vector<std::filesystem::path>& inputs) {
+	std::vector<BatchFile> files;
+
+	for (const std::filesystem::path& input : inputs) {
+		std::error_code error;
+
+		if (std::filesystem::is_directory(input, error)) {
+			std::vector<BatchFile> folderFiles;
+
+			for (const auto& entry : std::filesystem::recursive_directory_iterator(input, error)) {
+				if (entry.is_regular_file() && entry.path().extension() == ".fractal") {
+					folderFiles.push_back({ entry.path(), std::filesystem::relative(entry.path(), input).replace_extension() });
+				}
+			}
+
+			// The order of a directory listing depends on the file system, so the batch is sorted to always run in the same order
+			std::sort(folderFiles.begin(), folderFiles.end(), [](const BatchFile& a, const BatchFile& b) { return a.Filepath < b.Filepath; });
+			files.insert(files.end(), folderFiles.begin(), folderFiles.end());
+		} else if (std::filesystem::is_regular_file(input, error)) {
+			files.push_back({ input, input.stem() });
+		} else {
+			Log::Warning("BatchRenderer::CollectFiles - Skipping '" + input.string() + "', which is neither a file nor a folder");
+		}
+	}
+
+	return files;
+}
+
+CPURenderingSettings BatchRenderer::GetFrameSettings(const CPURenderingSettings& settings) {
+	CPURenderingSettings frameSettings = settings;
+	frameSettings.ZoomReprojection = false;
+	frameSettings.Progressive = false;
+	frameSettings.TileCache = false;
+	frameSettings.TileStore = false;
+
+	return frameSettings;
+}
+
+int BatchRenderer::RenderFrame(CPURenderer& renderer, const Mandelbrot& mandelbrot, uint32_t width, uint32_t height, const CPURenderingSettings& settings, const SupersamplingSettings& supersampling) {
+	// The orbits of the previous file would be panned or reused for a view close enough to it
+	renderer.Invalidate();
+
+	Mandelbrot frame = mandelbrot;
+
+	if (!mandelbrot.AutoIterations) {
+		renderer.Render(frame, width, height, settings, 0.0f, supersampling);
+		return frame.MaxIterations;
+	}
+
+	// The budget only goes up: a lower limit would render the same image
+	frame.MaxIterations = IterationBudget::Estimate(mandelbrot);
+
+	for (int budgetFrame = 1; ; ++budgetFrame) {
+		renderer.Render(frame, width, height, settings);
+
+		const int limit = IterationBudget::Adjust(mandelbrot, renderer.GetStatistics().Escapes);
+		if (limit <= frame.MaxIterations || budgetFrame == MaximumBudgetFrames) {
+			break;
+		}
+
+		frame.MaxIterations = limit;
+	}
+
+	// The orbits of the last frame are reused, so supersampling only shades them again and iterates the extra samples
+	if (supersampling.Enabled) {
+		renderer.Render(frame, width, height, settings, 0.0f, supersampling);
+	}
+
+	return frame.MaxIterations;
+}
+
+void BatchRenderer::PrintUsage() {
+	std::printf(
+		"Usage: Mandelbrot render <files or folders...> [options]\n"
+		"\n"
+		"Renders .fractal files to images without opening a window. Folders are searched recursively.\n"
+		"The options default to Settings.yaml.\n"
+		"\n"
+		"Options:\n"
+		"  --width=<pixels>       The width of the images\n"
+		"  --height=<pixels>      The height of the images\n"
+		"  --supersampling=<n>    Adaptive supersampling with n x n extra samples (0 disables it)\n"
+		"  --format=<format>      PNG, JPEG or BMP\n"
+		"  --quality=<0-100>      The quality of JPEG images\n"
+		"  --output=<folder>      The folder the images are written to\n"
+		"  --workers=<n>          The number of files rendered at once (defaults to one per thread, at most)\n"
+		"  --verbose              Logs every message, not only the warnings and errors\n"
+	);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Core/CommandLine.h"
+#include "Core/Settings/Settings.h"
+
+#include "Layers/Mandelbrot/Mandelbrot.h"
+
+#include "Renderer/CPU/CPURenderer.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * A `.fractal` file to render, and the name of its image: its path relative to the folder it was found in, without extension.
+ */
+struct BatchFile {
+	std::filesystem::path Filepath;
+	std::filesystem::path Name;
+};
+
+/**
+ * Renders `.fractal` files to images from the command line, without creating a window or an OpenGL context (the `render` command).
+ *
+ * The files are rendered by the CPU engine, several at once: each worker of the pool renders a file at a time with a renderer of its own,
+ * the threads of the machine being shared among the workers. The render time of every file and the throughput of the whole batch are reported on the standard output.
+ */
+class BatchRenderer {
+public:
+	/**
+	 * Runs the `render` command.
+	 *
+	 * @return The exit code of the application: `0` when every file was rendered, `1` otherwise.
+	 */
+	static int Run(const CommandLine& commandLine);
+
+	/**
+	 * Gets the `.fractal` files among a list of files and folders, the folders being searched recursively.
+	 *
+	 * The files of a folder are named after their path within it, so files of the same name in different subfolders get different images.
+	 */
+	static std::vector<BatchFile> CollectFiles(const std::vector<std::filesystem::path>& inputs);
+
+	/**
+	 * Gets the settings of the CPU engine for renders of a single frame: every view is rendered in full, in one frame,
+	 * and without the tile store, whose file cannot be shared by several renderers.
+	 */
+	static CPURenderingSettings GetFrameSettings(const CPURenderingSettings& settings);
+
+	/**
+	 * Renders a fractal in a single frame, from scratch (nothing of the previous frames of the renderer is reused). An automatic iteration budget starts from its depth estimate and is raised, frame after frame,
+	 * until the pixels stop escaping close to the limit or reaching it (see `IterationBudget::Adjust`).
+	 *
+	 * @return The iteration limit the fractal was rendered with.
+	 */
+	static int RenderFrame(CPURenderer& renderer, const Mandelbrot& mandelbrot, uint32_t width, uint32_t height, const CPURenderingSettings& settings, const SupersamplingSettings& supersampling);
+private:
+	static void PrintUsage();
+
+	/// @brief The number of frames an automatic iteration budget may take to settle.
+	static constexpr int MaximumBudgetFrames = 8;
+};
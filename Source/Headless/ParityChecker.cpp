@@ -0,0 +1,682 @@
+#include "ParityChecker.h"
+
+#include "Core/CPUFeatures.h"
+#include "Core/Image.h"
+#include "Core/Log.h"
+
+#include "Headless/BatchRenderer.h"
+
+#include "Renderer/IterationBudget.h"
+
+#include "Layers/Mandelbrot/MandelbrotSerializer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+static constexpr char GoldenMagic[8] = { 'M', 'B', 'G', 'O', 'L', 'D', 'E', 'N' };
+static constexpr uint32_t GoldenVersion = 1;
+
+struct GoldenHeader {
+	char Magic[8];
+	uint32_t Version;
+	uint32_t Width;
+	uint32_t Height;
+	int32_t IterationLimit;
+};
+
+static constexpr ParityPath AllPaths[] = {
+	ParityPath::Reference,
+	ParityPath::SSE2, ParityPath::AVX2, ParityPath::AVX512,
+	ParityPath::MarianiSilver, ParityPath::SolidGuessing,
+	ParityPath::Progressive, ParityPath::Reprojection, ParityPath::Panning,
+	ParityPath::TileCache, ParityPath::TileStore
+};
+
+#pragma region - GoldenImage -
+
+bool GoldenImage::Load(const std::filesystem::path& filepath) {
+	std::ifstream file(filepath, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+
+	GoldenHeader header;
+	file.read((char*)&header, sizeof(header));
+
+	if (!file || std::memcmp(header.Magic, GoldenMagic, sizeof(GoldenMagic)) != 0 || header.Version != GoldenVersion) {
+		Log::Error("GoldenImage::Load - '" + filepath.string() + "' is not a golden image of this version");
+		return false;
+	}
+
+	Width = header.Width;
+	Height = header.Height;
+	IterationLimit = header.IterationLimit;
+
+	const size_t pixelCount = (size_t)Width * Height;
+	Iterations.resize(pixelCount);
+	Pixels.resize(pixelCount * 4);
+
+	file.read((char*)Iterations.data(), (std::streamsize)(pixelCount * sizeof(int32_t)));
+	file.read((char*)Pixels.data(), (std::streamsize)Pixels.size());
+
+	if (!file) {
+		Log::Error("GoldenImage::Load - '" + filepath.string() + "' is truncated");
+		return false;
+	}
+
+	return true;
+}
+
+bool GoldenImage::Save(const std::filesystem::path& filepath) const {
+	std::error_code error;
+	std::filesystem::create_directories(filepath.parent_path(), error);
+
+	std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+
+	GoldenHeader header;
+	std::memcpy(header.Magic, GoldenMagic, sizeof(GoldenMagic));
+	header.Version = GoldenVersion;
+	header.Width = Width;
+	header.Height = Height;
+	header.IterationLimit = IterationLimit;
+
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)Iterations.data(), (std::streamsize)(Iterations.size() * sizeof(int32_t)));
+	file.write((const char*)Pixels.data(), (std::streamsize)Pixels.size());
+
+	if (!file) {
+		Log::Error("GoldenImage::Save - Cannot write '" + filepath.string() + "'");
+		return false;
+	}
+
+	return true;
+}
+
+#pragma endregion
+
+int ParityChecker::Run(const CommandLine& commandLine) {
+	if (commandLine.HasOption("help")) {
+		PrintUsage();
+		return 0;
+	}
+
+	const int width = commandLine.GetInt("width", 320);
+	const int height = commandLine.GetInt("height", 180);
+
+	if (width <= 0 || height <= 0) {
+		Log::Error("ParityChecker::Run - The size of the images must be positive");
+		return 1;
+	}
+
+	const bool update = commandLine.HasOption("update");
+	const int tolerance = std::max(commandLine.GetInt("tolerance", 2), 0);
+	const double maximumMismatches = std::max((double)commandLine.GetFloat("max-mismatches", 0.05f), 0.0);
+	const double maximumColorDelta = std::max((double)commandLine.GetFloat("max-color-delta", 16.0f), 0.0);
+	const std::filesystem::path goldenFolder = commandLine.GetOption("goldens", "Goldens");
+	const std::filesystem::path diffFolder = commandLine.GetOption("output", "ParityDiffs");
+
+	// The paths to check, all of them by default
+	std::vector<ParityPath> paths;
+	const std::string pathList = "," + commandLine.GetOption("paths") + ",";
+
+	for (const ParityPath path : AllPaths) {
+		const bool requested = pathList == ",," || pathList.find("," + std::string(GetPathName(path)) + ",") != std::string::npos;
+
+		if (requested && IsSupported(path)) {
+			paths.push_back(path);
+		}
+	}
+
+	if (paths.empty()) {
+		Log::Error("ParityChecker::Run - None of the requested paths is supported");
+		return 1;
+	}
+
+	std::vector<std::filesystem::path> inputs;
+	for (const std::string& argument : commandLine.GetArguments()) {
+		inputs.emplace_back(argument);
+	}
+
+	if (inputs.empty()) {
+		inputs.emplace_back("Internal/Configurations/Presets");
+	}
+
+	const std::vector<BatchFile> files = BatchRenderer::CollectFiles(inputs);
+	if (files.empty()) {
+		Log::Error("ParityChecker::Run - No .fractal file to check");
+		return 1;
+	}
+
+	// The tile store path writes its tiles to a file of its own, removed once the checks are done
+	const std::filesystem::path tileStoreFolder = std::filesystem::temp_directory_path() / "MandelbrotParity";
+
+	std::string pathNames;
+	for (const ParityPath path : paths) {
+		pathNames += (pathNames.empty() ? "" : ", ") + std::string(GetPathName(path));
+	}
+
+	if (update) {
+		std::printf("Rendering the goldens of %zu fractals at %dx%d into '%s', through %s\n", files.size(), width, height, goldenFolder.string().c_str(), pathNames.c_str());
+	} else {
+		std::printf("Checking %zu fractals through %zu paths: %s\n", files.size(), paths.size(), pathNames.c_str());
+	}
+
+	// The budget and the decimal positions do not depend on the goldens, so they are only checked along with them
+	const bool budgetKept = update || CheckIterationBudget((uint32_t)width, (uint32_t)height);
+	const bool decimalsKept = update || CheckDecimalRoundTrip();
+
+	uint32_t failures = 0;
+
+	for (size_t index = 0; index < files.size(); ++index) {
+		const BatchFile& file = files[index];
+		const std::string name = file.Name.generic_string();
+
+		Mandelbrot mandelbrot;
+		MandelbrotSerializer serializer(mandelbrot);
+
+		if (!serializer.Deserialize(file.Filepath)) {
+			std::printf("[%zu/%zu] %s: cannot load the file\n", index + 1, files.size(), file.Filepath.string().c_str());
+			++failures;
+			continue;
+		}
+
+		// The golden of the reference path sets the size and the iteration limit of every path
+		GoldenImage reference;
+
+		if (update) {
+			CPURenderer renderer;
+			const int iterationLimit = BatchRenderer::RenderFrame(renderer, mandelbrot, (uint32_t)width, (uint32_t)height, GetReferenceSettings(), {});
+			reference = CreateGolden(renderer, iterationLimit);
+		} else if (!reference.Load(GetGoldenPath(goldenFolder, file.Name, ParityPath::Reference))) {
+			std::printf("[%zu/%zu] %s: no golden, render them with --update first\n", index + 1, files.size(), name.c_str());
+			++failures;
+			continue;
+		}
+
+		// Every path renders with the iteration limit of the golden, so only the paths themselves can change the image
+		Mandelbrot frame = mandelbrot;
+		frame.AutoIterations = false;
+		frame.MaxIterations = reference.IterationLimit;
+
+		std::ostringstream report;
+		uint32_t failedPaths = 0;
+
+		for (const ParityPath path : paths) {
+			// Only the reference and the inexact paths have goldens
+			if (update && path != ParityPath::Reference && IsExact(path)) {
+				continue;
+			}
+
+			CPURenderer renderer;
+			const bool rendered = RenderPath(path, renderer, frame, reference.Width, reference.Height, tileStoreFolder);
+
+			if (!rendered) {
+				++failedPaths;
+				report << "\n    " << GetPathName(path) << ": the image never became final";
+				continue;
+			}
+
+			const std::filesystem::path goldenPath = GetGoldenPath(goldenFolder, file.Name, path);
+
+			// The images are written next to the goldens, so the goldens can be reviewed before they are committed
+			if (update) {
+				const GoldenImage golden = CreateGolden(renderer, reference.IterationLimit);
+				std::filesystem::path imagePath = goldenPath;
+				imagePath.replace_extension(".png");
+
+				if (!golden.Save(goldenPath) || !Image::Write(imagePath, golden.Width, golden.Height, golden.Pixels.data(), ExportImageFormat::PNG)) {
+					++failedPaths;
+					report << "\n    " << GetPathName(path) << ": cannot save the golden";
+				}
+
+				continue;
+			}
+
+			GoldenImage ownGolden;
+			if (!IsExact(path) && !ownGolden.Load(goldenPath)) {
+				++failedPaths;
+				report << "\n    " << GetPathName(path) << ": no golden, render them with --update first";
+				continue;
+			}
+
+			const GoldenImage& golden = IsExact(path) ? reference : ownGolden;
+			const PathResult result = Compare(golden, renderer, tolerance);
+			const double pixelCount = (double)golden.Width * golden.Height;
+
+			bool failed = false;
+
+			if (result.IterationMismatches > 0 || result.ColorMismatches > 0) {
+				const std::filesystem::path heatMapPath = diffFolder / file.Name / (std::string(GetPathName(path)) + ".png");
+				WriteHeatMap(heatMapPath, golden, renderer);
+
+				char text[256];
+				std::snprintf(text, sizeof(text), "\n    %s: %llu iteration mismatches (%.3f%%), %llu pixels off by more than %d (at most %d), heat map in '%s'",
+					GetPathName(path),
+					(unsigned long long)result.IterationMismatches, 100.0 * (double)result.IterationMismatches / pixelCount,
+					(unsigned long long)result.ColorMismatches, tolerance, result.MaximumColorDifference,
+					heatMapPath.string().c_str());
+
+				report << text;
+				failed = true;
+			}
+
+			// The own goldens of the inexact paths only catch changes, so the images must also stay close to the reference
+			if (!IsExact(path)) {
+				const ReferenceResult referenceResult = CompareWithReference(reference, renderer);
+				const double mismatches = (double)referenceResult.IterationMismatches / pixelCount;
+
+				if (mismatches > maximumMismatches || referenceResult.AverageColorDifference > maximumColorDelta) {
+					const std::filesystem::path heatMapPath = diffFolder / file.Name / (std::string(GetPathName(path)) + " vs Reference.png");
+					WriteHeatMap(heatMapPath, reference, renderer);
+
+					char text[256];
+					std::snprintf(text, sizeof(text), "\n    %s: %.3f%% of the pixels out of range of the reference (at most %.3f%%), average color difference %.2f (at most %.2f), heat map in '%s'",
+						GetPathName(path),
+						100.0 * mismatches, 100.0 * maximumMismatches,
+						referenceResult.AverageColorDifference, maximumColorDelta,
+						heatMapPath.string().c_str());
+
+					report << text;
+					failed = true;
+				}
+			}
+
+			failedPaths += failed ? 1 : 0;
+		}
+
+		failures += failedPaths > 0 ? 1 : 0;
+
+		const std::string outcome = failedPaths > 0 ? std::to_string(failedPaths) + " paths failed" : (update ? "saved" : "every path matches");
+		std::printf("[%zu/%zu] %s: %s, iteration limit %d%s\n", index + 1, files.size(), name.c_str(), outcome.c_str(), reference.IterationLimit, report.str().c_str());
+	}
+
+	std::error_code error;
+	std::filesystem::remove_all(tileStoreFolder, error);
+
+	std::printf("%s: %u of %zu fractals failed\n", update ? "Goldens rendered" : "Parity checked", failures, files.size());
+
+	return failures == 0 && budgetKept && decimalsKept ? 0 : 1;
+}
+
+const char* ParityChecker::GetPathName(ParityPath path) {
+	switch (path) {
+		case ParityPath::Reference:		return "Reference";
+		case ParityPath::SSE2:			return "SSE2";
+		case ParityPath::AVX2:			return "AVX2";
+		case ParityPath::AVX512:		return "AVX-512";
+		case ParityPath::MarianiSilver:	return "Mariani-Silver";
+		case ParityPath::SolidGuessing:	return "Solid Guessing";
+		case ParityPath::Progressive:	return "Progressive";
+		case ParityPath::Reprojection:	return "Reprojection";
+		case ParityPath::Panning:		return "Panning";
+		case ParityPath::TileCache:		return "Tile Cache";
+		case ParityPath::TileStore:		return "Tile Store";
+		default:						return "Unknown";
+	}
+}
+
+bool ParityChecker::IsExact(ParityPath path) {
+	switch (path) {
+		case ParityPath::AVX2:
+		case ParityPath::AVX512:
+		case ParityPath::MarianiSilver:
+		case ParityPath::SolidGuessing:
+		case ParityPath::Panning:
+		case ParityPath::TileCache:
+			return false;
+		default:
+			return true;
+	}
+}
+
+bool ParityChecker::IsSupported(ParityPath path) {
+	switch (path) {
+		case ParityPath::SSE2:		return CPUFeatures::Supports(InstructionSet::SSE2);
+		case ParityPath::AVX2:		return CPUFeatures::Supports(InstructionSet::AVX2);
+		case ParityPath::AVX512:	return CPUFeatures::Supports(InstructionSet::AVX512);
+		default:					return true;
+	}
+}
+
+CPURenderingSettings ParityChecker::GetReferenceSettings() {
+	CPURenderingSettings settings;
+	settings.SIMD = InstructionSet::Scalar;
+	settings.Perturbation = true;
+	settings.SeriesApproximation = true;
+	settings.AreaSkipping = AreaSkippingMode::None;
+	settings.ZoomReprojection = false;
+	settings.Progressive = false;
+	settings.TileCache = false;
+	settings.TileStore = false;
+
+	return settings;
+}
+
+bool ParityChecker::RenderPath(ParityPath path, CPURenderer& renderer, const Mandelbrot& mandelbrot, uint32_t width, uint32_t height, const std::filesystem::path& tileStoreFolder) {
+	CPURenderingSettings settings = GetReferenceSettings();
+
+	// The multi-frame paths are given a budget of a millisecond per frame, so they really spread the image over several frames
+	const auto renderUntilComplete = [&](const CPURenderingSettings& frameSettings) {
+		for (int frame = 0; frame < MaximumFrames; ++frame) {
+			renderer.Render(mandelbrot, width, height, frameSettings, 1.0f);
+
+			if (renderer.IsComplete()) {
+				return true;
+			}
+		}
+
+		return false;
+	};
+
+	switch (path) {
+		case ParityPath::SSE2:			settings.SIMD = InstructionSet::SSE2;						break;
+		case ParityPath::AVX2:			settings.SIMD = InstructionSet::AVX2;						break;
+		case ParityPath::AVX512:		settings.SIMD = InstructionSet::AVX512;						break;
+		case ParityPath::MarianiSilver:	settings.AreaSkipping = AreaSkippingMode::MarianiSilver;	break;
+		case ParityPath::SolidGuessing:	settings.AreaSkipping = AreaSkippingMode::SolidGuessing;	break;
+
+		case ParityPath::Progressive: {
+			settings.Progressive = true;
+			return renderUntilComplete(settings);
+		}
+
+		case ParityPath::Reprojection: {
+			// The view is reached by zooming in and rotating from a view rendered first
+			Mandelbrot previous = mandelbrot;
+			previous.Zoom /= 1.5;
+			previous.Rotation -= 10.0f;
+
+			settings.ZoomReprojection = true;
+			renderer.Render(previous, width, height, settings);
+
+			return renderUntilComplete(settings);
+		}
+
+		case ParityPath::Panning: {
+			// The view is reached by panning from a view rendered first, a few pixels away
+			Mandelbrot previous = mandelbrot;
+			previous.Position = mandelbrot.Position + BigVec2(glm::dvec2(37.0, -23.0) * mandelbrot.GetPixelSpacing(height));
+
+			renderer.Render(previous, width, height, settings);
+
+			return renderUntilComplete(settings);
+		}
+
+		case ParityPath::TileCache: {
+			settings.TileCache = true;
+			settings.TileCacheSize = 64;
+			break;
+		}
+
+		case ParityPath::TileStore: {
+			// The first render stores the tiles, the second one reads them back from the file
+			settings.TileStore = true;
+			settings.TileStoreSize = 64;
+			settings.TileStoreFolder = tileStoreFolder;
+
+			renderer.Render(mandelbrot, width, height, settings);
+			renderer.Invalidate();
+			break;
+		}
+
+		default:
+			break;
+	}
+
+	renderer.Render(mandelbrot, width, height, settings);
+
+	return true;
+}
+
+std::filesystem::path ParityChecker::GetGoldenPath(const std::filesystem::path& goldenFolder, const std::filesystem::path& name, ParityPath path) {
+	return goldenFolder / name / (std::string(GetPathName(path)) + ".golden");
+}
+
+GoldenImage ParityChecker::CreateGolden(const CPURenderer& renderer, int iterationLimit) {
+	GoldenImage golden;
+	golden.Width = renderer.GetWidth();
+	golden.Height = renderer.GetHeight();
+	golden.IterationLimit = iterationLimit;
+	golden.Pixels = renderer.GetPixels();
+
+	golden.Iterations.reserve(renderer.GetOrbits().size());
+	for (const OrbitResult& orbit : renderer.GetOrbits()) {
+		golden.Iterations.push_back(orbit.Iterations);
+	}
+
+	return golden;
+}
+
+ParityChecker::PathResult ParityChecker::Compare(const GoldenImage& golden, const CPURenderer& renderer, int tolerance) {
+	PathResult result;
+
+	const std::vector<OrbitResult>& orbits = renderer.GetOrbits();
+	const std::vector<uint8_t>& pixels = renderer.GetPixels();
+
+	for (size_t i = 0; i < golden.Iterations.size(); ++i) {
+		if (orbits[i].Iterations != golden.Iterations[i]) {
+			++result.IterationMismatches;
+		}
+
+		int difference = 0;
+		for (size_t channel = 0; channel < 3; ++channel) {
+			difference = std::max(difference, std::abs((int)pixels[i * 4 + channel] - (int)golden.Pixels[i * 4 + channel]));
+		}
+
+		result.MaximumColorDifference = std::max(result.MaximumColorDifference, difference);
+
+		if (difference > tolerance) {
+			++result.ColorMismatches;
+		}
+	}
+
+	return result;
+}
+
+ParityChecker::ReferenceResult ParityChecker::CompareWithReference(const GoldenImage& reference, const CPURenderer& renderer) {
+	ReferenceResult result;
+
+	const std::vector<OrbitResult>& orbits = renderer.GetOrbits();
+	const std::vector<uint8_t>& pixels = renderer.GetPixels();
+	const int width = (int)reference.Width;
+	const int height = (int)reference.Height;
+
+	uint64_t totalColorDifference = 0;
+
+	for (int y = 0; y < height; ++y) {
+		for (int x = 0; x < width; ++x) {
+			const size_t i = (size_t)y * width + x;
+
+			int lowest = INT32_MAX, highest = INT32_MIN;
+			int colorDifference = 255;
+
+			for (int ny = std::max(y - 1, 0); ny <= std::min(y + 1, height - 1); ++ny) {
+				for (int nx = std::max(x - 1, 0); nx <= std::min(x + 1, width - 1); ++nx) {
+					const size_t n = (size_t)ny * width + nx;
+
+					lowest = std::min(lowest, (int)reference.Iterations[n]);
+					highest = std::max(highest, (int)reference.Iterations[n]);
+
+					int difference = 0;
+					for (size_t channel = 0; channel < 3; ++channel) {
+						difference = std::max(difference, std::abs((int)pixels[i * 4 + channel] - (int)reference.Pixels[n * 4 + channel]));
+					}
+
+					colorDifference = std::min(colorDifference, difference);
+				}
+			}
+
+			if (orbits[i].Iterations < lowest || orbits[i].Iterations > highest) {
+				++result.IterationMismatches;
+			}
+
+			totalColorDifference += (uint64_t)colorDifference;
+		}
+	}
+
+	result.AverageColorDifference = reference.Iterations.empty() ? 0.0 : (double)totalColorDifference / (double)reference.Iterations.size();
+
+	return result;
+}
+
+bool ParityChecker::CheckIterationBudget(uint32_t width, uint32_t height) {
+	// Inside the main cardioid, with a ceiling far above the estimate
+	Mandelbrot mandelbrot;
+	mandelbrot.Position = BigVec2(-0.1, 0.1);
+	mandelbrot.Zoom = 20.0;
+	mandelbrot.AutoIterations = true;
+	mandelbrot.MaxIterations = 1 << 16;
+
+	bool kept = true;
+
+	for (const bool interiorTest : { true, false }) {
+		Mandelbrot view = mandelbrot;
+		view.Trap.Type = interiorTest ? OrbitTrapType::None : OrbitTrapType::Point;
+
+		Mandelbrot frame = view;
+		frame.MaxIterations = IterationBudget::Estimate(view);
+
+		CPURenderer renderer;
+		renderer.Render(frame, width, height, GetReferenceSettings());
+
+		const EscapeStatistics& escapes = renderer.GetStatistics().Escapes;
+		const int limit = IterationBudget::Adjust(view, escapes);
+
+		std::printf("Iteration budget of a view of interior, %s: %d iterations, then %d (%llu of %llu pixels unresolved)\n",
+			interiorTest ? "with the interior test" : "with the periodicity check alone",
+			frame.MaxIterations, limit,
+			(unsigned long long)escapes.Unescaped, (unsigned long long)escapes.Pixels);
+
+		kept = kept && limit == frame.MaxIterations;
+	}
+
+	if (!kept) {
+		std::printf("Iteration budget: the limit rose on pixels proven interior\n");
+	}
+
+	return kept;
+}
+
+bool ParityChecker::CheckDecimalRoundTrip() {
+	struct RoundingCase {
+		const char* Value;
+		uint32_t Digits;
+		const char* Expected;
+	};
+
+	// Exact in binary, so the digit past the requested ones is exactly the one that rounds
+	static constexpr RoundingCase RoundingCases[] = {
+		{ "0.125", 2, "0.13" },
+		{ "-0.125", 2, "-0.13" },
+		{ "1.5", 1, "2" },
+		{ "9.99609375", 3, "10" },
+		{ "999999.5", 6, "1000000" },
+		{ "0.6666666666", 3, "0.667" },
+		{ "1.25e-40", 2, "1.3e-40" },
+		{ "123.4", 3, "123" }
+	};
+
+	bool kept = true;
+
+	for (const RoundingCase& rounding : RoundingCases) {
+		BigReal value;
+		BigReal::FromString(rounding.Value, value);
+
+		const std::string text = value.ToString(rounding.Digits);
+		if (text != rounding.Expected) {
+			std::printf("Decimal rounding: %s to %u digits gave %s instead of %s\n", rounding.Value, rounding.Digits, text.c_str(), rounding.Expected);
+			kept = false;
+		}
+	}
+
+	// Scaled by a third, which fills the low bits of the mantissa the decimal text must keep
+	static constexpr const char* RoundTripValues[] = {
+		"-0.743643887037158704752191506114774", "0.1", "-1.99999999999999999999", "3", "123456789.987654321", "1.25e-40", "1e-300"
+	};
+
+	for (const char* text : RoundTripValues) {
+		BigReal value;
+		BigReal::FromString(text, value);
+		value = value * BigReal(1.0 / 3.0);
+
+		const std::string printed = value.ToString();
+
+		BigReal parsed;
+		if (!BigReal::FromString(printed, parsed) || !(parsed == value)) {
+			std::printf("Decimal round trip: %s times a third printed as %s does not parse back to itself\n", text, printed.c_str());
+			kept = false;
+		}
+	}
+
+	std::printf("Decimal round trip: %zu roundings and %zu round trips %s\n", std::size(RoundingCases), std::size(RoundTripValues), kept ? "kept" : "failed");
+
+	return kept;
+}
+
+bool ParityChecker::WriteHeatMap(const std::filesystem::path& filepath, const GoldenImage& golden, const CPURenderer& renderer) {
+	const std::vector<OrbitResult>& orbits = renderer.GetOrbits();
+	const std::vector<uint8_t>& pixels = renderer.GetPixels();
+
+	std::vector<uint8_t> heatMap(golden.Pixels.size(), 0);
+
+	for (size_t i = 0; i < golden.Iterations.size(); ++i) {
+		uint8_t* heat = &heatMap[i * 4];
+		heat[3] = 255;
+
+		if (orbits[i].Iterations != golden.Iterations[i]) {
+			heat[0] = heat[1] = heat[2] = 255;
+			continue;
+		}
+
+		int difference = 0;
+		for (size_t channel = 0; channel < 3; ++channel) {
+			difference = std::max(difference, std::abs((int)pixels[i * 4 + channel] - (int)golden.Pixels[i * 4 + channel]));
+		}
+
+		// Any difference shows up, saturating to yellow at 32 levels
+		if (difference > 0) {
+			const float t = std::min((float)difference / 32.0f, 1.0f);
+			heat[0] = (uint8_t)(128.0f + 127.0f * t);
+			heat[1] = (uint8_t)(255.0f * t);
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::create_directories(filepath.parent_path(), error);
+
+	return Image::Write(filepath, golden.Width, golden.Height, heatMap.data(), ExportImageFormat::PNG);
+}
+
+void ParityChecker::PrintUsage() {
+	std::printf(
+		"Usage: Mandelbrot parity [files or folders...] [options]\n"
+		"\n"
+		"Renders every preset (or the given .fractal files) through every path of the CPU engine (the SIMD kernels,\n"
+		"area skipping, progressive rendering, reprojection, panning, the tile cache and the tile store), and compares\n"
+		"the images with stored goldens, to the iteration count of every pixel. The exact paths are compared with the\n"
+		"goldens of the scalar kernel; the FMA kernels, area skipping, panning and the tile cache, which round, guess or\n"
+		"sample differently, with goldens of their own, and with those of the scalar kernel within bounds: every pixel\n"
+		"is compared with its 3x3 neighbourhood there. A heat map of the differences is written for every failure.\n"
+		"The automatic iteration budget is checked too: it must keep its limit on a view filled with interior.\n"
+		"Decimal positions are checked too: they must round to the requested digits and parse back unchanged.\n"
+		"The goldens depend on the compiler and its floating-point flags, so record them with the build being checked.\n"
+		"\n"
+		"Options:\n"
+		"  --update               Renders the goldens instead of checking them\n"
+		"  --goldens=<folder>     The folder of the goldens (default Goldens)\n"
+		"  --output=<folder>      The folder the heat maps are written to (default ParityDiffs)\n"
+		"  --width=<pixels>       The width of the goldens (default 320)\n"
+		"  --height=<pixels>      The height of the goldens (default 180)\n"
+		"  --paths=<list>         The paths to check or render, like 'AVX2,Progressive' (default: every path the processor supports)\n"
+		"  --tolerance=<0-255>    The color difference a pixel may have on any channel (default 2)\n"
+		"  --max-mismatches=<f>   The fraction of the pixels of an inexact path whose iteration count may fall outside\n"
+		"                         the range of their neighbourhood in the scalar golden (default 0.05)\n"
+		"  --max-color-delta=<d>  The average color difference an inexact path may have with the closest color of the\n"
+		"                         neighbourhood of each pixel in the scalar golden, from 0 to 255 (default 16)\n"
+		"  --verbose              Logs every message, not only the warnings and errors\n"
+	);
+}
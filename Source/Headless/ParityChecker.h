@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Core/CommandLine.h"
+#include "Core/Settings/Settings.h"
+
+#include "Layers/Mandelbrot/Mandelbrot.h"
+
+#include "Renderer/CPU/CPURenderer.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+/**
+ * The reference image of a fractal rendered by one path of the CPU engine: the iteration count and the color of every pixel.
+ */
+struct GoldenImage {
+	uint32_t Width = 0, Height = 0;
+
+	/// @brief The iteration limit the fractal was rendered with, which every path renders it with too (an automatic budget could settle differently on another path).
+	int IterationLimit = 0;
+
+	/// @brief The iteration count of every pixel, and its RGBA8 color, in bottom-up rows.
+	std::vector<int32_t> Iterations;
+	std::vector<uint8_t> Pixels;
+
+	bool Load(const std::filesystem::path& filepath);
+	bool Save(const std::filesystem::path& filepath) const;
+};
+
+/**
+ * The ways the CPU engine can reach an image.
+ */
+enum class ParityPath {
+	/// @brief The scalar kernel, every pixel iterated in a single frame. The exact paths are compared with its goldens.
+	Reference,
+
+	/// @brief The SIMD kernels, one path per instruction set the processor supports.
+	SSE2,
+	AVX2,
+	AVX512,
+
+	/// @brief The area skipping strategies, which fill the regions they find uniform instead of iterating them.
+	MarianiSilver,
+	SolidGuessing,
+
+	/// @brief Rendered over several frames: coarse to fine, refined from a zoomed out view, or shifted from a panned view.
+	Progressive,
+	Reprojection,
+	Panning,
+
+	/// @brief Sampled from the tiles of the tile cache, or read back from the tile store.
+	TileCache,
+	TileStore
+};
+
+/**
+ * Checks that every render path of the CPU engine keeps producing the images it should (the `parity` command).
+ *
+ * Every fast path (SIMD kernels, area skipping, multi-frame rendering, caches) risks changing the image silently, so each one renders the same fractals as the stored goldens,
+ * which they must match to the iteration count of every pixel, and to its color within a tolerance. A heat map of the differences is written for every path that fails.
+ *
+ * The exact paths are compared with the golden of the reference path, so they are checked against the scalar kernel itself. The others round or sample differently by design
+ * (see `IsExact`), so they are compared with goldens of their own, which still catches any change to them, and with the golden of the reference path within bounds
+ * (see `CompareWithReference`), which catches goldens recorded from a path that was already wrong.
+ *
+ * The automatic iteration budget, which picks the limit of the frames from the pixels of the engine, is checked on views of its own (see `CheckIterationBudget`),
+ * and the decimal positions the fractal files are saved with are checked to load back unchanged (see `CheckDecimalRoundTrip`).
+ *
+ * The OpenGL engine needs a window and a context, so it is not covered: the CPU engine is the reference it is compared with in the editor.
+ */
+class ParityChecker {
+public:
+	/**
+	 * Runs the `parity` command.
+	 *
+	 * @return The exit code of the application: `0` when every path matched every golden, `1` otherwise.
+	 */
+	static int Run(const CommandLine& commandLine);
+private:
+	struct PathResult {
+		uint64_t IterationMismatches = 0;
+		uint64_t ColorMismatches = 0;
+		int MaximumColorDifference = 0;
+		bool Rendered = true;
+	};
+
+	struct ReferenceResult {
+		/// @brief The pixels whose iteration count is outside the range of the iteration counts around them in the reference.
+		uint64_t IterationMismatches = 0;
+
+		/// @brief The average difference between the color of a pixel and the closest color around it in the reference.
+		double AverageColorDifference = 0.0;
+	};
+
+	static const char* GetPathName(ParityPath path);
+
+	/// @brief Whether a path reproduces the image of the reference path. The FMA kernels round differently, area skipping guesses the regions it finds uniform,
+	/// panning maps the pixels from the origin of the previous view, and the tile cache samples a grid of its own, so their images only match goldens rendered by the same path.
+	static bool IsExact(ParityPath path);
+
+	/// @brief Whether the processor can run a path.
+	static bool IsSupported(ParityPath path);
+
+	/// @brief The settings of the reference path, which do not depend on the settings of the application so the goldens can be shared.
+	static CPURenderingSettings GetReferenceSettings();
+
+	/**
+	 * Renders a fractal through a path, until its image is final. The renderer must be new, so the caches only hold the tiles of the path.
+	 *
+	 * @return `false` if the image never became final.
+	 */
+	static bool RenderPath(ParityPath path, CPURenderer& renderer, const Mandelbrot& mandelbrot, uint32_t width, uint32_t height, const std::filesystem::path& tileStoreFolder);
+
+	/// @brief The file of the golden of a fractal rendered by a path.
+	static std::filesystem::path GetGoldenPath(const std::filesystem::path& goldenFolder, const std::filesystem::path& name, ParityPath path);
+
+	/// @brief Builds the golden of the image of a renderer.
+	static GoldenImage CreateGolden(const CPURenderer& renderer, int iterationLimit);
+
+	static PathResult Compare(const GoldenImage& golden, const CPURenderer& renderer, int tolerance);
+
+	/**
+	 * Compares the image of an inexact path with the golden of the reference path.
+	 *
+	 * The inexact paths move the pixels they sample by up to half a pixel, or round the orbits differently, which changes the pixels of the chaotic regions outright,
+	 * so each pixel is compared with its 3x3 neighbourhood in the reference: its iteration count must lie within theirs, and its color is measured against the closest of theirs.
+	 */
+	static ReferenceResult CompareWithReference(const GoldenImage& reference, const CPURenderer& renderer);
+
+	/**
+	 * Checks that the automatic iteration budget only rises for the pixels a higher limit could resolve: a view filled with interior must keep the limit it starts from,
+	 * whether its pixels are proven interior by the interior test or by the periodicity check alone (the orbit trap turns the interior test off).
+	 *
+	 * @return `false` if the budget rose on either view.
+	 */
+	static bool CheckIterationBudget(uint32_t width, uint32_t height);
+
+	/**
+	 * Checks that `BigReal::ToString` rounds half-up to the requested digits, carrying into the leading digit, and that a number printed with every digit
+	 * its precision resolves parses back to the very same number, as the positions of the fractal files must.
+	 *
+	 * @return `false` if any number was printed wrong or did not parse back to itself.
+	 */
+	static bool CheckDecimalRoundTrip();
+
+	/// @brief Writes an image of the differences: black where the pixels match, from red to yellow as their colors drift apart, white where the iteration counts differ.
+	static bool WriteHeatMap(const std::filesystem::path& filepath, const GoldenImage& golden, const CPURenderer& renderer);
+
+	static void PrintUsage();
+
+	/// @brief The number of frames a multi-frame path may take before its image is considered stuck.
+	static constexpr int MaximumFrames = 10000;
+};
@@ -0,0 +1,334 @@
+#include "PresetBenchmark.h"
+
+#include "Core/CPUFeatures.h"
+#include "Core/Log.h"
+#include "Core/Settings/SettingsManager.h"
+
+#include "Headless/BatchRenderer.h"
+
+#include "Layers/Mandelbrot/MandelbrotSerializer.h"
+
+#include "Utilities/Utilities.h"
+
+#include <yaml-cpp/yaml.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+std::string PresetTiming::GetKey() const {
+	return Name + "@" + std::to_string(Width) + "x" + std::to_string(Height);
+}
+
+int PresetBenchmark::Run(const CommandLine& commandLine) {
+	if (commandLine.HasOption("help")) {
+		PrintUsage();
+		return 0;
+	}
+
+	const Settings& settings = SettingsManager::Get();
+
+	const std::vector<std::pair<uint32_t, uint32_t>> resolutions = ParseResolutions(commandLine.GetOption("resolutions", "640x360,1280x720"));
+	if (resolutions.empty()) {
+		Log::Error("PresetBenchmark::Run - The resolutions must be given as a list like '640x360,1920x1080'");
+		return 1;
+	}
+
+	const int repetitions = std::max(commandLine.GetInt("repetitions", 5), 1);
+	const int warmup = std::max(commandLine.GetInt("warmup", 1), 0);
+	const float threshold = commandLine.GetFloat("threshold", 10.0f);
+	const float tolerance = commandLine.GetFloat("tolerance", 1.0f);
+
+	SupersamplingSettings supersampling = settings.Rendering.Supersampling;
+	if (commandLine.HasOption("supersampling")) {
+		supersampling.Grid = commandLine.GetInt("supersampling", 0);
+		supersampling.Enabled = supersampling.Grid > 0;
+	}
+
+	std::vector<std::filesystem::path> inputs;
+	for (const std::string& argument : commandLine.GetArguments()) {
+		inputs.emplace_back(argument);
+	}
+
+	// Without files, the presets shipped with the application are measured
+	if (inputs.empty()) {
+		inputs.emplace_back("Internal/Configurations/Presets");
+	}
+
+	const std::vector<BatchFile> files = BatchRenderer::CollectFiles(inputs);
+	if (files.empty()) {
+		Log::Error("PresetBenchmark::Run - No .fractal file to benchmark");
+		return 1;
+	}
+
+	std::unordered_map<std::string, double> baseline;
+	const bool hasBaseline = commandLine.HasOption("baseline");
+
+	if (hasBaseline && !LoadBaseline(commandLine.GetOption("baseline"), baseline)) {
+		return 1;
+	}
+
+	// The presets are rendered one at a time with every thread, like the editor renders them
+	const uint32_t threads = (uint32_t)std::max(commandLine.GetInt("threads", 0), 0);
+	CPURenderer renderer(threads);
+
+	const CPURenderingSettings cpuSettings = BatchRenderer::GetFrameSettings(settings.Rendering.CPU);
+	const std::string instructionSet = Utilities::InstructionSetToString(CPUFeatures::Resolve(cpuSettings.SIMD));
+
+	std::printf("Benchmarking %zu presets at %zu resolutions, %d repetitions each, with %u threads and %s kernels\n",
+		files.size(), resolutions.size(), repetitions, renderer.GetThreadCount(), instructionSet.c_str());
+
+	std::vector<PresetTiming> timings;
+	uint32_t failures = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (size_t index = 0; index < files.size(); ++index) {
+		const BatchFile& file = files[index];
+
+		Mandelbrot mandelbrot;
+		MandelbrotSerializer serializer(mandelbrot);
+
+		if (!serializer.Deserialize(file.Filepath)) {
+			std::printf("[%zu/%zu] %s: cannot load the file\n", index + 1, files.size(), file.Filepath.string().c_str());
+			++failures;
+			continue;
+		}
+
+		for (const auto& [width, height] : resolutions) {
+			PresetTiming timing;
+			timing.Name = file.Name.generic_string();
+			timing.Width = width;
+			timing.Height = height;
+
+			// The first renders fill the caches of the processor and settle the memory of the renderer, so they are not measured
+			for (int i = 0; i < warmup; ++i) {
+				BatchRenderer::RenderFrame(renderer, mandelbrot, width, height, cpuSettings, supersampling);
+			}
+
+			for (int i = 0; i < repetitions; ++i) {
+				const auto renderStart = std::chrono::steady_clock::now();
+				timing.IterationLimit = BatchRenderer::RenderFrame(renderer, mandelbrot, width, height, cpuSettings, supersampling);
+				const std::chrono::duration<double, std::milli> renderTime = std::chrono::steady_clock::now() - renderStart;
+
+				timing.Samples.push_back(renderTime.count());
+			}
+
+			timing.Iterations = renderer.GetStatistics().Iterations;
+
+			std::vector<double> sorted = timing.Samples;
+			std::sort(sorted.begin(), sorted.end());
+
+			timing.Median = GetPercentile(sorted, 0.5);
+			timing.P95 = GetPercentile(sorted, 0.95);
+			timing.Minimum = sorted.front();
+			timing.Maximum = sorted.back();
+
+			std::string comparison;
+
+			if (const auto it = baseline.find(timing.GetKey()); it != baseline.end()) {
+				timing.BaselineMedian = it->second;
+
+				// Both a relative and an absolute margin are needed: a few percent of a render of a few milliseconds is noise
+				const double change = timing.Median / timing.BaselineMedian - 1.0;
+				timing.Regressed = change * 100.0 > threshold && timing.Median - timing.BaselineMedian > tolerance;
+
+				char text[96];
+				std::snprintf(text, sizeof(text), ", baseline %.2f ms (%+.1f%%)%s", timing.BaselineMedian, change * 100.0, timing.Regressed ? " REGRESSED" : "");
+				comparison = text;
+			} else if (hasBaseline) {
+				comparison = ", not in the baseline";
+			}
+
+			std::printf("[%zu/%zu] %s: median %.2f ms, p95 %.2f ms, iteration limit %d%s\n",
+				index + 1, files.size(), timing.GetKey().c_str(), timing.Median, timing.P95, timing.IterationLimit, comparison.c_str());
+
+			timings.push_back(std::move(timing));
+		}
+	}
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	if (commandLine.HasOption("output")) {
+		JsonWriter writer;
+		writer.BeginObject();
+
+		writer.Key("Machine").BeginObject();
+		writer.Key("HardwareThreads").Value(std::thread::hardware_concurrency());
+		writer.Key("RenderThreads").Value(renderer.GetThreadCount());
+		writer.Key("InstructionSet").Value(instructionSet);
+		writer.EndObject();
+
+		writer.Key("Settings").BeginObject();
+		writer.Key("Repetitions").Value(repetitions);
+		writer.Key("Warmup").Value(warmup);
+		writer.Key("Supersampling").Value(supersampling.Enabled ? supersampling.Grid : 0);
+		writer.Key("AreaSkipping").Value(Utilities::AreaSkippingModeToString(cpuSettings.AreaSkipping));
+		writer.Key("Perturbation").Value(cpuSettings.Perturbation);
+		writer.EndObject();
+
+		writer.Key("Presets").BeginArray();
+		for (const PresetTiming& timing : timings) {
+			WriteTiming(writer, timing);
+		}
+		writer.EndArray();
+
+		writer.EndObject();
+
+		if (!writer.Save(commandLine.GetOption("output"))) {
+			++failures;
+		}
+	}
+
+	const size_t regressions = std::count_if(timings.begin(), timings.end(), [](const PresetTiming& timing) { return timing.Regressed; });
+
+	std::printf("Benchmarked %zu of %zu presets in %.1f s\n", timings.size() / resolutions.size(), files.size(), elapsed.count());
+
+	if (hasBaseline) {
+		std::printf("%zu of %zu measurements are more than %.1f%% (and %.1f ms) slower than the baseline\n", regressions, timings.size(), threshold, tolerance);
+
+		for (const PresetTiming& timing : timings) {
+			if (timing.Regressed) {
+				std::printf("  %s: %.2f ms -> %.2f ms\n", timing.GetKey().c_str(), timing.BaselineMedian, timing.Median);
+			}
+		}
+	}
+
+	return failures == 0 && regressions == 0 ? 0 : 1;
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> PresetBenchmark::ParseResolutions(const std::string& text) {
+	std::vector<std::pair<uint32_t, uint32_t>> resolutions;
+
+	size_t begin = 0;
+	while (begin <= text.size()) {
+		const size_t end = std::min(text.find(',', begin), text.size());
+		const std::string resolution = text.substr(begin, end - begin);
+
+		unsigned width = 0, height = 0;
+		char trailing = 0;
+
+		if (std::sscanf(resolution.c_str(), "%ux%u%c", &width, &height, &trailing) != 2 || width == 0 || height == 0) {
+			return {};
+		}
+
+		resolutions.emplace_back(width, height);
+		begin = end + 1;
+	}
+
+	return resolutions;
+}
+
+bool PresetBenchmark::LoadBaseline(const std::filesystem::path& filepath, std::unordered_map<std::string, double>& baseline) {
+	// JSON is a subset of YAML, so the reports are read back with the YAML parser
+	YAML::Node data;
+	try {
+		data = YAML::LoadFile(filepath.string());
+	} catch (YAML::Exception e) {
+		Log::Error("PresetBenchmark::LoadBaseline - Failed to load file: " + std::string(e.what()));
+		return false;
+	}
+
+	const YAML::Node presetsNode = data["Presets"];
+	if (!presetsNode || !presetsNode.IsSequence()) {
+		Log::Error("PresetBenchmark::LoadBaseline - '" + filepath.string() + "' is not a benchmark report");
+		return false;
+	}
+
+	for (const YAML::Node& presetNode : presetsNode) {
+		PresetTiming timing;
+
+		if (const auto& nameNode = presetNode["Name"]) {
+			timing.Name = nameNode.as<std::string>();
+		}
+
+		if (const auto& widthNode = presetNode["Width"]) {
+			timing.Width = widthNode.as<uint32_t>();
+		}
+
+		if (const auto& heightNode = presetNode["Height"]) {
+			timing.Height = heightNode.as<uint32_t>();
+		}
+
+		if (const auto& medianNode = presetNode["Median"]) {
+			const double median = medianNode.as<double>();
+
+			if (median > 0.0) {
+				baseline[timing.GetKey()] = median;
+			}
+		}
+	}
+
+	Log::Info("PresetBenchmark::LoadBaseline - Loaded " + std::to_string(baseline.size()) + " measurements from '" + filepath.string() + "'");
+
+	return true;
+}
+
+void PresetBenchmark::WriteTiming(JsonWriter& writer, const PresetTiming& timing) {
+	writer.BeginObject();
+
+	writer.Key("Name").Value(timing.Name);
+	writer.Key("Width").Value(timing.Width);
+	writer.Key("Height").Value(timing.Height);
+	writer.Key("IterationLimit").Value(timing.IterationLimit);
+	writer.Key("Iterations").Value(timing.Iterations);
+
+	writer.Key("Median").Value(timing.Median);
+	writer.Key("P95").Value(timing.P95);
+	writer.Key("Minimum").Value(timing.Minimum);
+	writer.Key("Maximum").Value(timing.Maximum);
+
+	const double seconds = std::max(timing.Median, 1e-6) * 1e-3;
+	writer.Key("PixelsPerSecond").Value((double)timing.Width * timing.Height / seconds);
+
+	writer.Key("Samples").BeginArray();
+	for (const double sample : timing.Samples) {
+		writer.Value(sample);
+	}
+	writer.EndArray();
+
+	if (timing.BaselineMedian > 0.0) {
+		writer.Key("BaselineMedian").Value(timing.BaselineMedian);
+		writer.Key("Change").Value(timing.Median / timing.BaselineMedian - 1.0);
+		writer.Key("Regressed").Value(timing.Regressed);
+	}
+
+	writer.EndObject();
+}
+
+double PresetBenchmark::GetPercentile(const std::vector<double>& sorted, double p) {
+	if (sorted.empty()) {
+		return 0.0;
+	}
+
+	const double position = p * (double)(sorted.size() - 1);
+	const size_t below = (size_t)std::floor(position);
+	const size_t above = std::min(below + 1, sorted.size() - 1);
+
+	return sorted[below] + (sorted[above] - sorted[below]) * (position - (double)below);
+}
+
+void PresetBenchmark::PrintUsage() {
+	std::printf(
+		"Usage: Mandelbrot benchmark [files or folders...] [options]\n"
+		"\n"
+		"Renders every preset (or the given .fractal files) from scratch at fixed resolutions, several times each,\n"
+		"and reports the median and 95th percentile time of every preset. Folders are searched recursively.\n"
+		"With a baseline (the report of a previous run), the presets whose median got slower are reported,\n"
+		"and the command fails. The CPU engine settings come from Settings.yaml, so keep them the same between runs.\n"
+		"\n"
+		"Options:\n"
+		"  --resolutions=<list>   The resolutions to render, like 640x360,1920x1080 (default 640x360,1280x720)\n"
+		"  --repetitions=<n>      The number of measured renders of each preset (default 5)\n"
+		"  --warmup=<n>           The number of renders of each preset before measuring it (default 1)\n"
+		"  --threads=<n>          The number of render threads (default: every hardware thread)\n"
+		"  --supersampling=<n>    Adaptive supersampling with n x n extra samples (0 disables it)\n"
+		"  --output=<file>        The JSON file the report is written to\n"
+		"  --baseline=<file>      A previous report to compare the medians with\n"
+		"  --threshold=<percent>  The slowdown from the baseline above which a preset regressed (default 10)\n"
+		"  --tolerance=<ms>       The slowdown below which a preset never regressed, whatever the percentage (default 1)\n"
+		"  --verbose              Logs every message, not only the warnings and errors\n"
+	);
+}
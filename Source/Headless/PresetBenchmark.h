@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Core/CommandLine.h"
+#include "Core/JsonWriter.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The timings of a preset rendered at one resolution.
+ */
+struct PresetTiming {
+	/// @brief The path of the preset within its folder, without extension, like `The Classics/Elephant Valley`.
+	std::string Name;
+
+	uint32_t Width = 0, Height = 0;
+
+	int IterationLimit = 0;
+	uint64_t Iterations = 0;
+
+	/// @brief The time of every repetition, in milliseconds, in the order they ran.
+	std::vector<double> Samples;
+
+	double Median = 0.0, P95 = 0.0, Minimum = 0.0, Maximum = 0.0;
+
+	/// @brief The median of the baseline, in milliseconds, or `0` if the baseline does not have the preset at this resolution.
+	double BaselineMedian = 0.0;
+
+	bool Regressed = false;
+
+	/// @brief Identifies the preset and its resolution in the reports, like `The Classics/Elephant Valley@1280x720`.
+	std::string GetKey() const;
+};
+
+/**
+ * Measures the end-to-end render time of every preset, and catches the presets that got slower than a stored baseline (the `benchmark` command).
+ *
+ * Each preset stresses a different path of the CPU engine (orbit traps, distance estimation, Julia sets, perturbation...), so the presets are compared one by one rather than on average.
+ * A preset is rendered from scratch at every resolution, once to warm up and then `--repetitions` times, and its median and 95th percentile times are reported.
+ * The report is written as JSON, which is also the format of the baseline: the report of a previous run.
+ */
+class PresetBenchmark {
+public:
+	/**
+	 * Runs the `benchmark` command.
+	 *
+	 * @return The exit code of the application: `0` when every preset was rendered and none regressed, `1` otherwise.
+	 */
+	static int Run(const CommandLine& commandLine);
+private:
+	/**
+	 * Parses a list of resolutions like `640x360,1920x1080`.
+	 *
+	 * @return The resolutions, or an empty list if one of them is invalid.
+	 */
+	static std::vector<std::pair<uint32_t, uint32_t>> ParseResolutions(const std::string& text);
+
+	/**
+	 * Loads the median time of every preset of a report.
+	 *
+	 * @param baseline The map receiving the medians, by key (see `PresetTiming::GetKey`).
+	 * @return `true` if the report was loaded.
+	 */
+	static bool LoadBaseline(const std::filesystem::path& filepath, std::unordered_map<std::string, double>& baseline);
+
+	static void WriteTiming(JsonWriter& writer, const PresetTiming& timing);
+
+	/// @brief The value below which a fraction `p` of the sorted samples fall, interpolated between the two closest samples.
+	static double GetPercentile(const std::vector<double>& sorted, double p);
+
+	static void PrintUsage();
+};
@@ -35,8 +35,8 @@ struct FractalState {
 		// We interpolate each of the parameters
 		Current.Power = glm::lerp(Current.Power, Target.Power, alpha);
 		Current.Bailout = glm::lerp(Current.Bailout, Target.Bailout, alpha);
-		Current.Zoom = glm::lerp(Current.Zoom, Target.Zoom, alpha);
-		Current.Position = glm::mix(Current.Position, Target.Position, alpha);
+		Current.Zoom = glm::mix(Current.Zoom, Target.Zoom, (double)alpha);
+		Current.Position += (Target.Position - Current.Position) * (double)alpha;
 		Current.Rotation = glm::lerp(Current.Rotation, Target.Rotation, alpha);
 		Current.JuliaC = glm::mix(Current.JuliaC, Target.JuliaC, alpha);
 
@@ -50,15 +50,72 @@ struct FractalState {
 		Current.Trap.Color = glm::mix(Current.Trap.Color, Target.Trap.Color, alpha);
 		Current.Trap.Blend = glm::lerp(Current.Trap.Blend, Target.Trap.Blend, alpha);
 
+		// The interpolation only ever gets closer to the target, so each parameter is snapped onto it once the rest is negligible.
+		// A view at rest then stays exactly the same from frame to frame, and is not rendered again.
+		Converge(Current.Power, Target.Power);
+		Converge(Current.Bailout, Target.Bailout);
+		Converge(Current.Rotation, Target.Rotation);
+		Converge(Current.JuliaC, Target.JuliaC);
+		Converge(Current.ColorFrequency, Target.ColorFrequency);
+		Converge(Current.ColorOffset, Target.ColorOffset);
+		Converge(Current.DistanceScale, Target.DistanceScale);
+		Converge(Current.InteriorColor, Target.InteriorColor);
+		Converge(Current.Trap.P1, Target.Trap.P1);
+		Converge(Current.Trap.P2, Target.Trap.P2);
+		Converge(Current.Trap.Color, Target.Trap.Color);
+		Converge(Current.Trap.Blend, Target.Trap.Blend);
+
+		// The view is compared with its own scale: the zoom relatively, and the position in units of the view height
+		if (std::abs(Current.Zoom / Target.Zoom - 1.0) < ViewTolerance) {
+			Current.Zoom = Target.Zoom;
+		}
+
+		if (glm::length(glm::dvec2(Target.Position - Current.Position)) * Target.Zoom < ViewTolerance) {
+			Current.Position = Target.Position;
+		}
+
 		// Discrete values ​​(enums, bools) are changed instantly
 		// to avoid strange behavior during the transition.
 		Current.Algorithm = Target.Algorithm;
 		Current.OrbitColoring = Target.OrbitColoring;
 		Current.JuliaMode = Target.JuliaMode;
 		Current.MaxIterations = Target.MaxIterations;
+		Current.AutoIterations = Target.AutoIterations;
 		Current.ExteriorColoring = Target.ExteriorColoring;
 		Current.InteriorColoring = Target.InteriorColoring;
 		Current.ColorPalette = Target.ColorPalette;
 		Current.Trap.Type = Target.Trap.Type;
 	}
+
+	/**
+	 * Checks whether the view reached its target, so its orbits stop changing from frame to frame.
+	 *
+	 * The parameters that only affect the coloring may still be interpolating.
+	 */
+	bool IsSettled() const {
+		return Current.HasSameOrbits(Target);
+	}
+private:
+	/// @brief The relative distance below which a parameter is snapped onto its target.
+	static constexpr float Tolerance = 1e-5f;
+
+	/// @brief The relative zoom, and the offset in view heights, below which the view is snapped onto its target: well under a hundredth of a pixel.
+	static constexpr double ViewTolerance = 1e-6;
+
+	static void Converge(float& current, float target) {
+		if (std::abs(current - target) <= Tolerance * std::max(1.0f, std::abs(target))) {
+			current = target;
+		}
+	}
+
+	static void Converge(glm::vec2& current, const glm::vec2& target) {
+		Converge(current.x, target.x);
+		Converge(current.y, target.y);
+	}
+
+	static void Converge(glm::vec3& current, const glm::vec3& target) {
+		Converge(current.x, target.x);
+		Converge(current.y, target.y);
+		Converge(current.z, target.z);
+	}
 };
\ No newline at end of file
@@ -3,8 +3,15 @@
 #include "Palette.h"
 #include "OrbitTrap.h"
 
+#include "Core/BigFloat.h"
+
 #include <glm/glm.hpp>
 
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+
 enum class FractalAlgorithm {
 	Mandelbrot,
 	BurningShip,
@@ -14,9 +21,13 @@ enum class FractalAlgorithm {
 enum class ColorAlgorithm {
 	Step,
 	Smooth,
-	DistanceEstimation
+	DistanceEstimation,
+	Histogram // Equalizes the smooth iteration counts of the frame, so every band of the palette covers as many pixels
 };
 
+// The resolution of the iteration histogram of 'ColorAlgorithm::Histogram' (see 'Histogram.comp')
+constexpr int MAX_HISTOGRAM_BINS = 4096;
+
 enum class InteriorColorAlgorithm {
 	Black,
 	White,
@@ -29,10 +40,13 @@ struct Mandelbrot {
 	float Power = 2.0f; // Power 'n' in z = z^n + c
 	float Bailout = 16.0f; // Bailout radius (larger = more detail on the edges)
 	int MaxIterations = 256;
+	bool AutoIterations = false; // Picks the iteration limit from the view, 'MaxIterations' being its ceiling (see 'IterationBudget')
 
 	// View Parameters
-	float Zoom = 1.0f;
-	glm::vec2 Position = { -0.5f, 0.0f };
+	// The zoom is a double, whose range covers every depth the renderers reach.
+	// The center needs as many digits as the zoom has, so it is kept in arbitrary precision.
+	double Zoom = 1.0;
+	BigVec2 Position = { -0.5, 0.0 };
 	float Rotation = 0.0f;
 
 	// Julia Parameters
@@ -51,4 +65,113 @@ struct Mandelbrot {
 
 	// Orbit Trap
 	OrbitTrap Trap;
+
+	// The largest coordinate of the center, which sets the resolution of a floating-point type around it (at least 1)
+	double GetPositionMagnitude() const {
+		const glm::dvec2 position(Position);
+
+		return std::max({ 1.0, std::abs(position.x), std::abs(position.y) });
+	}
+
+	// The distance between two adjacent pixels on the complex plane, for a view 'height' pixels tall
+	double GetPixelSpacing(uint32_t height) const {
+		return 2.0 / ((double)std::max(height, 1u) * Zoom);
+	}
+
+	// Whether single precision can no longer tell adjacent pixels apart around the current position.
+	// The renderers stay on float at shallow zooms and switch to their double-precision paths past this point.
+	bool RequiresDoublePrecision(uint32_t height) const {
+		const double magnitude = GetPositionMagnitude();
+
+		// Keep at least 16 float ulps between neighbouring pixels, as iterating amplifies rounding errors
+		return GetPixelSpacing(height) < magnitude * 16.0 * FLT_EPSILON;
+	}
+
+	// Whether double precision can no longer tell adjacent pixels apart either.
+	// Past this point, deep views are rendered with perturbation (see 'SupportsPerturbation').
+	bool RequiresPerturbation(uint32_t height) const {
+		return GetPixelSpacing(height) < GetPositionMagnitude() * 16.0 * DBL_EPSILON;
+	}
+
+	// Perturbation iterates the pixels as offsets from a reference orbit, which is only implemented for the quadratic Mandelbrot set
+	bool SupportsPerturbation() const {
+		return Algorithm == FractalAlgorithm::Mandelbrot && !JuliaMode && Power == 2.0f;
+	}
+
+	// Whether pixels inside the main cardioid and the period-2 bulb can be classified as interior without iterating them.
+	// Only the quadratic Mandelbrot set has these regions in closed form, and the orbit trap still needs the orbits of interior pixels.
+	bool SupportsInteriorRejection() const {
+		return Algorithm == FractalAlgorithm::Mandelbrot && !JuliaMode && Power == 2.0f && Trap.Type == OrbitTrapType::None;
+	}
+
+	// Whether the orbits track their derivative, which only distance estimation and the orbit trap use
+	bool NeedsDerivative() const {
+		return ExteriorColoring == ColorAlgorithm::DistanceEstimation || Trap.Type != OrbitTrapType::None;
+	}
+
+	// The number of bins of the iteration histogram, one per iteration until the limit outgrows 'MAX_HISTOGRAM_BINS'
+	int GetHistogramBinCount() const {
+		return std::clamp(MaxIterations, 1, MAX_HISTOGRAM_BINS);
+	}
+
+	// Whether two fractals render the same image, every parameter being equal. The renderers skip the frames that would redraw the same image (see 'Renderer::IsUpToDate').
+	bool operator==(const Mandelbrot& other) const = default;
+
+	// Whether two fractals give every pixel the same orbit, so an image of one can be recolored into the other without iterating again.
+	// They may only differ by their coloring: the palette, the coloring algorithms (as long as the derivative is tracked either way), and the color and blend of the trap.
+	bool HasSameOrbits(const Mandelbrot& other) const {
+		return Position == other.Position && HasSameOrbitsAnywhere(other);
+	}
+
+	// Like 'HasSameOrbits', except that the views may be centered anywhere: panning one view gives the orbits of the other.
+	bool HasSameOrbitsAnywhere(const Mandelbrot& other) const {
+		return Zoom == other.Zoom
+			&& Rotation == other.Rotation
+			&& IsSameFractal(other);
+	}
+
+	// Like 'HasSameOrbitsAnywhere', except that the views may also be zoomed and rotated: every point of the plane has the same orbit in both.
+	bool IsSameFractal(const Mandelbrot& other) const {
+		return Algorithm == other.Algorithm
+			&& Power == other.Power
+			&& Bailout == other.Bailout
+			&& MaxIterations == other.MaxIterations
+			&& JuliaMode == other.JuliaMode
+			&& JuliaC == other.JuliaC
+			&& NeedsDerivative() == other.NeedsDerivative()
+			&& Trap.Type == other.Trap.Type
+			&& Trap.P1 == other.Trap.P1
+			&& Trap.P2 == other.Trap.P2;
+	}
+
+	// Snaps the position of a view being panned onto the pixel grid of 'rendered', the previous frame, so the image of that frame only needs shifting by whole pixels.
+	// 'requested' is the position the previous frame was asked for, before it was snapped itself. Once the position stops moving, it is left alone,
+	// so a view at rest is always rendered at its exact position, at most half a pixel away from the snapped one.
+	// On success, the pixel (x, y) of the snapped view is the pixel (x, y) + 'offset' of the previous frame.
+	bool SnapToPixelGrid(const Mandelbrot& rendered, const BigVec2& requested, uint32_t width, uint32_t height, glm::ivec2& offset) {
+		if (Position == requested || !HasSameOrbitsAnywhere(rendered)) {
+			return false;
+		}
+
+		// The rotation is rounded to float like the renderers do, so the offset maps onto their pixels exactly
+		const float rotation = glm::radians(Rotation);
+		const double cosR = (double)std::cos(rotation);
+		const double sinR = (double)std::sin(rotation);
+		const double spacing = GetPixelSpacing(height);
+
+		const glm::dvec2 delta(Position - rendered.Position);
+		const glm::dvec2 pixels = glm::dvec2(cosR * delta.x - sinR * delta.y, sinR * delta.x + cosR * delta.y) / spacing;
+
+		// Nothing of the previous frame is left on screen
+		if (std::abs(pixels.x) >= (double)width || std::abs(pixels.y) >= (double)height) {
+			return false;
+		}
+
+		offset = glm::ivec2((int)std::round(pixels.x), (int)std::round(pixels.y));
+
+		const glm::dvec2 snapped((double)offset.x * cosR + (double)offset.y * sinR, -(double)offset.x * sinR + (double)offset.y * cosR);
+		Position = rendered.Position + BigVec2(snapped * spacing);
+
+		return true;
+	}
 };
\ No newline at end of file
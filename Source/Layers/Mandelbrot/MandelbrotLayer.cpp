@@ -2,6 +2,7 @@
 
 #include "Core/Application.h"
 #include "Core/Log.h"
+#include "Core/Profiler.h"
 #include "Core/Settings/SettingsManager.h"
 #include "Core/Input/Input.h"
 
@@ -179,6 +180,14 @@ void MandelbrotLayer::DrawMenuBar() {
 
 			UI::Tooltip("Export the current fractal configuration to the 'Export/Configuration' folder.");
 
+#ifndef MB_DIST
+			if (ImGui::MenuItem(Profiler::IsRecording() ? "Stop Trace (.json)" : "Start Trace", "F9")) {
+				ToggleTrace();
+			}
+
+			UI::Tooltip("Record where the time of each frame goes, then export it as a Chrome trace to the 'Export/Trace' folder (open it in Perfetto or chrome://tracing).");
+#endif // MB_DIST
+
 			ImGui::EndMenu();
 		}
 
@@ -333,6 +342,18 @@ void MandelbrotLayer::ExportConfiguration() {
 	SaveConfiguration(BuildExportPath(exportConfigFolder, ".fractal"));
 }
 
+void MandelbrotLayer::ToggleTrace() {
+	if (!Profiler::IsRecording()) {
+		Profiler::Start();
+		return;
+	}
+
+	Profiler::Stop();
+
+	const std::filesystem::path exportTraceFolder = SettingsManager::Get().Export.Folder / "Trace";
+	Profiler::WriteTrace(BuildExportPath(exportTraceFolder, ".json"));
+}
+
 void MandelbrotLayer::CheckOrCreateFolder(const std::filesystem::path& filepath) {
 	if (!std::filesystem::exists(filepath)) {
 		std::filesystem::create_directory(filepath);
@@ -373,6 +394,12 @@ void MandelbrotLayer::HandleKeyboardShortcuts() {
 	if (Input::IsKeyDown(KeyCode::F1)) {
 		SettingsManager::Get().Editor.Windows.ShowAbout = !SettingsManager::Get().Editor.Windows.ShowAbout;
 	}
+
+#ifndef MB_DIST
+	if (Input::IsKeyDown(KeyCode::F9)) {
+		ToggleTrace();
+	}
+#endif // MB_DIST
 }
 
 void MandelbrotLayer::UpdateWindowTitle(const std::filesystem::path& filepath) {
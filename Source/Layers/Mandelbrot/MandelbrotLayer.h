@@ -30,6 +30,9 @@ private:
 	void ExportFrameAsImage();
 	void ExportConfiguration();
 
+	// Starts recording a trace of the profiler, or writes the one being recorded to the 'Export/Trace' folder.
+	void ToggleTrace();
+
 	std::filesystem::path BuildExportPath(const std::filesystem::path& folder, const std::string& extension);
 	void CheckOrCreateFolder(const std::filesystem::path& filepath);
 
@@ -1,11 +1,15 @@
 #include "MandelbrotSerializer.h"
 
 #include "Core/Log.h"
+#include "Core/Profiler.h"
 
 #include "Utilities/Utilities.h"
 
 #include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <limits>
 
 namespace YAML {
 	template<>
@@ -26,6 +30,23 @@ namespace YAML {
 		}
 	};
 
+	template<>
+	struct convert<BigVec2> {
+		static Node encode(const BigVec2& rhs) {
+			Node node;
+			node.push_back(rhs.x.ToString());
+			node.push_back(rhs.y.ToString());
+			node.SetStyle(EmitterStyle::Flow);
+			return node;
+		}
+
+		// The coordinates are parsed from their decimal text, so no digit is lost to an intermediate double
+		static bool decode(const Node& node, BigVec2& rhs) {
+			if (!node.IsSequence() || node.size() != 2) return false;
+			return BigReal::FromString(node[0].as<std::string>(), rhs.x) && BigReal::FromString(node[1].as<std::string>(), rhs.y);
+		}
+	};
+
 	template<>
 	struct convert<glm::vec3> {
 		static Node encode(const glm::vec3& rhs) {
@@ -59,6 +80,11 @@ namespace YAML {
 	}
 }
 
+// The number of significant digits needed to locate the view center at the given zoom, plus a margin for the pixels of very large images
+static uint32_t GetPositionDigits(double zoom) {
+	return (uint32_t)std::ceil(std::log10(std::max(zoom, 1.0))) + 20;
+}
+
 MandelbrotSerializer::MandelbrotSerializer(Mandelbrot& mandelbrot)
 	: m_Mandelbrot(mandelbrot)
 {}
@@ -67,6 +93,8 @@ bool MandelbrotSerializer::Serialize(const std::filesystem::path& filepath) {
 	Log::Trace("MandelbrotSerializer::Serialize - Serializing Mandelbrot settings to " + filepath.string());
 
 	YAML::Emitter out;
+	// Deep views need every digit of the double-precision zoom to round-trip
+	out.SetDoublePrecision(std::numeric_limits<double>::max_digits10);
 	out << YAML::BeginMap; // Root
 	{
 		out << YAML::Key << "Mandelbrot" << YAML::Value << YAML::BeginMap; // Mandelbrot
@@ -77,13 +105,18 @@ bool MandelbrotSerializer::Serialize(const std::filesystem::path& filepath) {
 				out << YAML::Key << "Power" << YAML::Value << m_Mandelbrot.Power;
 				out << YAML::Key << "Bailout" << YAML::Value << m_Mandelbrot.Bailout;
 				out << YAML::Key << "MaxIterations" << YAML::Value << m_Mandelbrot.MaxIterations;
+				out << YAML::Key << "AutoIterations" << YAML::Value << m_Mandelbrot.AutoIterations;
 			}
 			out << YAML::EndMap; // FractalParameters
 
 			out << YAML::Key << "ViewParameters" << YAML::Value << YAML::BeginMap; // ViewParameters
 			{
 				out << YAML::Key << "Zoom" << YAML::Value << m_Mandelbrot.Zoom;
-				out << YAML::Key << "Position" << YAML::Value << m_Mandelbrot.Position;
+				// Only the digits the zoom can resolve are written, so shallow views stay readable
+				const uint32_t positionDigits = GetPositionDigits(m_Mandelbrot.Zoom);
+				out << YAML::Key << "Position" << YAML::Value << YAML::Flow << YAML::BeginSeq;
+				out << m_Mandelbrot.Position.x.ToString(positionDigits) << m_Mandelbrot.Position.y.ToString(positionDigits);
+				out << YAML::EndSeq;
 				out << YAML::Key << "Rotation" << YAML::Value << m_Mandelbrot.Rotation;
 			}
 			out << YAML::EndMap; // ViewParameters
@@ -143,6 +176,8 @@ bool MandelbrotSerializer::Serialize(const std::filesystem::path& filepath) {
 }
 
 bool MandelbrotSerializer::Deserialize(const std::filesystem::path& filepath) {
+	MB_PROFILE_SCOPE("MandelbrotSerializer::Deserialize");
+
 	Log::Trace("MandelbrotSerializer::Deserialize - Deserializing Mandelbrot settings from " + filepath.string());
 
 	YAML::Node data;
@@ -173,15 +208,19 @@ bool MandelbrotSerializer::Deserialize(const std::filesystem::path& filepath) {
 			if (const auto& maxIterationsNode = fractalParametersNode["MaxIterations"]) {
 				m_Mandelbrot.MaxIterations = maxIterationsNode.as<int>();
 			}
+
+			if (const auto& autoIterationsNode = fractalParametersNode["AutoIterations"]) {
+				m_Mandelbrot.AutoIterations = autoIterationsNode.as<bool>();
+			}
 		}
 
 		if (const auto& viewParametersNode = mandelbrotNode["ViewParameters"]) {
 			if (const auto& zoomNode = viewParametersNode["Zoom"]) {
-				m_Mandelbrot.Zoom = zoomNode.as<float>();
+				m_Mandelbrot.Zoom = zoomNode.as<double>();
 			}
 
 			if (const auto& positionNode = viewParametersNode["Position"]) {
-				m_Mandelbrot.Position = positionNode.as<glm::vec2>();
+				m_Mandelbrot.Position = positionNode.as<BigVec2>();
 			}
 
 			if (const auto& rotationNode = viewParametersNode["Rotation"]) {
@@ -22,4 +22,6 @@ struct OrbitTrap {
 
 	glm::vec3 Color = { 1.0f, 1.0f, 0.0f }; // Trap color
 	float Blend = 0.5f; // Blending factor with the fractal color
+
+	bool operator==(const OrbitTrap& other) const = default;
 };
\ No newline at end of file
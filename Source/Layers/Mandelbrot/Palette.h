@@ -1,22 +1,15 @@
 #pragma once
 
 #include <glm/glm.hpp>
-#include <vector>
 
-// The maximum number of colors that our Shader will support
-constexpr int MAX_PALETTE_COLORS = 16;
+#include <algorithm>
+#include <vector>
 
 /// @brief Represents a color palette for the Mandelbrot set.
 struct Palette {
-    // The `Colors` vector can be any size on the CPU for UI flexibility.
+    // The colors of the gradient, spread evenly between 0.0 and 1.0. There can be any number of them.
     std::vector<glm::vec3> Colors;
 
-    // These arrays are the ones we will actually send to the shader.
-    // They have a fixed size and we prepare them before rendering.
-    glm::vec3 ColorData[MAX_PALETTE_COLORS] = {};
-    float ColorPositions[MAX_PALETTE_COLORS] = {};
-    int ColorCount = 0;
-
     Palette() {
         // We initialize with a default palette (blue and yellow)
         Colors.push_back({ 0.0f, 0.0f, 0.5f }); // Dark blue
@@ -25,18 +18,19 @@ struct Palette {
         Colors.push_back({ 0.0f, 0.0f, 0.0f }); // Black (for the interior)
     }
 
-    // This function prepares the data to be sent to the GPU.
-    void PrepareForShader() {
-        ColorCount = static_cast<int>(Colors.size());
+    // Interpolates the gradient at 't', between 0.0 and 1.0.
+    // The renderers bake it into a lookup table once (see 'PaletteLUT') instead of evaluating it for every pixel.
+    glm::vec3 Evaluate(float t) const {
+        const int count = static_cast<int>(Colors.size());
 
-        if (ColorCount > MAX_PALETTE_COLORS) {
-            ColorCount = MAX_PALETTE_COLORS; // Truncate if there are too many colors
-        }
+        // If the color count is invalid, return an error color
+        if (count < 2) return { 1.0f, 0.0f, 1.0f };
 
-        for (int i = 0; i < ColorCount; ++i) {
-            ColorData[i] = Colors[i];
-            // Distribute the color positions evenly between 0.0 and 1.0
-            ColorPositions[i] = static_cast<float>(i) / static_cast<float>(ColorCount - 1);
-        }
+        const float position = std::clamp(t, 0.0f, 1.0f) * static_cast<float>(count - 1);
+        const int i = std::min(static_cast<int>(position), count - 2);
+
+        return glm::mix(Colors[i], Colors[i + 1], position - static_cast<float>(i));
     }
+
+    bool operator==(const Palette& other) const = default;
 };
\ No newline at end of file
@@ -21,7 +21,7 @@ void OpenGLFramebuffer::Invalidate() {
 	if (m_Handle) {
 		glDeleteFramebuffers(1, &m_Handle);
 
-		m_ColorAttachment = nullptr;
+		m_ColorAttachments.clear();
 		m_DepthAttachment = nullptr;
 	}
 
@@ -32,8 +32,27 @@ void OpenGLFramebuffer::Invalidate() {
 	if (m_Specification.ColorAttachmentSpecification.Format != TextureFormat::None) {
 		m_Specification.ColorAttachmentSpecification.Width = m_Specification.Width;
 		m_Specification.ColorAttachmentSpecification.Height = m_Specification.Height;
-		m_ColorAttachment = Texture2D::Create(m_Specification.ColorAttachmentSpecification);
-		glNamedFramebufferTexture(m_Handle, GL_COLOR_ATTACHMENT0, m_ColorAttachment->GetHandle(), 0);
+		m_ColorAttachments.push_back(Texture2D::Create(m_Specification.ColorAttachmentSpecification));
+		glNamedFramebufferTexture(m_Handle, GL_COLOR_ATTACHMENT0, m_ColorAttachments[0]->GetHandle(), 0);
+
+		// The additional attachments follow the first one, and every one of them is drawn to
+		for (TextureSpecification& specification : m_Specification.AdditionalColorAttachmentSpecifications) {
+			specification.Width = m_Specification.Width;
+			specification.Height = m_Specification.Height;
+
+			const GLenum attachment = GL_COLOR_ATTACHMENT0 + (GLenum)m_ColorAttachments.size();
+			m_ColorAttachments.push_back(Texture2D::Create(specification));
+			glNamedFramebufferTexture(m_Handle, attachment, m_ColorAttachments.back()->GetHandle(), 0);
+		}
+
+		if (m_ColorAttachments.size() > 1) {
+			std::vector<GLenum> drawBuffers;
+			for (size_t i = 0; i < m_ColorAttachments.size(); ++i) {
+				drawBuffers.push_back(GL_COLOR_ATTACHMENT0 + (GLenum)i);
+			}
+
+			glNamedFramebufferDrawBuffers(m_Handle, (GLsizei)drawBuffers.size(), drawBuffers.data());
+		}
 	}
 
 	// Create the Depth attachment only if there is one
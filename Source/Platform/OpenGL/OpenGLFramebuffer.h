@@ -13,7 +13,7 @@ public:
 
 	virtual void Resize(uint32_t width, uint32_t height) override;
 
-	virtual Ref<Texture2D> GetColorAttachment() const override { return m_ColorAttachment; }
+	virtual Ref<Texture2D> GetColorAttachment(uint32_t index = 0) const override { return index < m_ColorAttachments.size() ? m_ColorAttachments[index] : nullptr; }
 	virtual Ref<Texture2D> GetDepthAttachment() const override { return m_DepthAttachment; }
 
 	virtual uint32_t GetHandle() const override { return m_Handle; }
@@ -23,7 +23,7 @@ public:
 	virtual const uint32_t GetWidth() const { return m_Specification.Width; }
 	virtual const uint32_t GetHeight() const { return m_Specification.Height; }
 	
-	virtual uint64_t GetColorAttachmentRendererID() const override { return m_ColorAttachment->GetHandle(); }
+	virtual uint64_t GetColorAttachmentRendererID() const override { return m_ColorAttachments[0]->GetHandle(); }
 	virtual uint64_t GetDepthAttachmentRendererID() const override { return m_DepthAttachment->GetHandle(); }
 private:
 	void Invalidate();
@@ -32,6 +32,6 @@ private:
 
 	FramebufferSpecification m_Specification;
 
-	Ref<Texture2D> m_ColorAttachment;
+	std::vector<Ref<Texture2D>> m_ColorAttachments;
 	Ref<Texture2D> m_DepthAttachment;
 };
\ No newline at end of file
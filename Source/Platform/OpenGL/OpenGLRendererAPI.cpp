@@ -94,7 +94,7 @@ void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_
 
 void OpenGLRendererAPI::DispatchCompute(uint32_t groupX, uint32_t groupY, uint32_t groupZ) {
 	glDispatchCompute(groupX, groupY, groupZ);
-	glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+	glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT);
 }
 
 void OpenGLRendererAPI::BlitFramebufferToSwapchain(uint32_t fbo, uint32_t width, uint32_t height) {
@@ -132,6 +132,11 @@ void OpenGLShader::UploadUniformFloat(const std::string& name, float value) {
 	glProgramUniform1f(m_Handle, location, value);
 }
 
+void OpenGLShader::UploadUniformDouble(const std::string& name, double value) {
+	GLint location = glGetUniformLocation(m_Handle, name.c_str());
+	glProgramUniform1d(m_Handle, location, value);
+}
+
 void OpenGLShader::UploadUniformBool(const std::string& name, bool value) {
 	GLint location = glGetUniformLocation(m_Handle, name.c_str());
 	glProgramUniform1i(m_Handle, location, value);
@@ -142,6 +147,16 @@ void OpenGLShader::UploadUniformVec2(const std::string& name, const glm::vec2& v
 	glProgramUniform2fv(m_Handle, location, 1, glm::value_ptr(value));
 }
 
+void OpenGLShader::UploadUniformIVec2(const std::string& name, const glm::ivec2& value) {
+	GLint location = glGetUniformLocation(m_Handle, name.c_str());
+	glProgramUniform2iv(m_Handle, location, 1, glm::value_ptr(value));
+}
+
+void OpenGLShader::UploadUniformDVec2(const std::string& name, const glm::dvec2& value) {
+	GLint location = glGetUniformLocation(m_Handle, name.c_str());
+	glProgramUniform2dv(m_Handle, location, 1, glm::value_ptr(value));
+}
+
 void OpenGLShader::UploadUniformVec3(const std::string& name, const glm::vec3& value) {
 	GLint location = glGetUniformLocation(m_Handle, name.c_str());
 	glProgramUniform3fv(m_Handle, location, 1, glm::value_ptr(value));
@@ -17,8 +17,11 @@ public:
 private:
 	virtual void UploadUniformInt(const std::string& name, int value) override;
 	virtual void UploadUniformFloat(const std::string& name, float value) override;
+	virtual void UploadUniformDouble(const std::string& name, double value) override;
 	virtual void UploadUniformBool(const std::string& name, bool value) override;
 	virtual void UploadUniformVec2(const std::string& name, const glm::vec2& value) override;
+	virtual void UploadUniformIVec2(const std::string& name, const glm::ivec2& value) override;
+	virtual void UploadUniformDVec2(const std::string& name, const glm::dvec2& value) override;
 	virtual void UploadUniformVec3(const std::string& name, const glm::vec3& value) override;
 	virtual void UploadUniformVec4(const std::string& name, const glm::vec4& value) override;
 	virtual void UploadUniformMat4(const std::string& name, const glm::mat4& value) override;
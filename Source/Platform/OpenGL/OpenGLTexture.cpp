@@ -13,6 +13,9 @@ static GLenum TextureFormatToGLInternalFormat(TextureFormat format) {
 		case TextureFormat::RGB8:				return GL_RGB8;
 		case TextureFormat::RGBA8:				return GL_RGBA8;
 		case TextureFormat::RGBA16F:			return GL_RGBA16F;
+		case TextureFormat::R32F:				return GL_R32F;
+		case TextureFormat::RGBA32F:			return GL_RGBA32F;
+		case TextureFormat::R32UI:				return GL_R32UI;
 		case TextureFormat::Depth24Stencil8:	return GL_DEPTH24_STENCIL8;
 		default:								return 0;
 	}
@@ -24,6 +27,9 @@ static GLenum TextureFormatToGLDataFormat(TextureFormat format) {
 		case TextureFormat::RGB8:				return GL_RGB;
 		case TextureFormat::RGBA8:				return GL_RGBA;
 		case TextureFormat::RGBA16F:			return GL_RGBA;
+		case TextureFormat::R32F:				return GL_RED;
+		case TextureFormat::RGBA32F:			return GL_RGBA;
+		case TextureFormat::R32UI:				return GL_RED_INTEGER;
 		case TextureFormat::Depth24Stencil8:	return GL_DEPTH_STENCIL;
 		default:								return 0;
 	}
@@ -34,7 +40,10 @@ static GLenum TextureFormatToGLDataType(TextureFormat format) {
 		case TextureFormat::R8:
 		case TextureFormat::RGB8:
 		case TextureFormat::RGBA8:				return GL_UNSIGNED_BYTE;
-		case TextureFormat::RGBA16F:			return GL_FLOAT;
+		case TextureFormat::RGBA16F:
+		case TextureFormat::R32F:
+		case TextureFormat::RGBA32F:			return GL_FLOAT;
+		case TextureFormat::R32UI:				return GL_UNSIGNED_INT;
 		case TextureFormat::Depth24Stencil8:	return GL_UNSIGNED_INT_24_8;
 		default:								return 0;
 	}
@@ -202,5 +211,19 @@ void OpenGLTexture2D::BindToImageUnit(uint32_t unit, bool read, bool write) {
 	if (read && write) access = GL_READ_WRITE;
 	else if (write) access = GL_WRITE_ONLY;
 
-	glBindImageTexture(unit, m_Handle, 0, GL_FALSE, 0, access, GL_RGBA32F);
+	glBindImageTexture(unit, m_Handle, 0, GL_FALSE, 0, access, TextureFormatToGLInternalFormat(m_Specification.Format));
+}
+
+void OpenGLTexture2D::SetData(const void* data, TextureFormat dataFormat) {
+	if (!m_Handle || !data) {
+		Log::Error("OpenGLTexture2D::SetData - Cannot upload data to an invalid texture");
+		return;
+	}
+
+	GLenum glDataFormat = TextureFormatToGLDataFormat(dataFormat);
+	GLenum glDataType = TextureFormatToGLDataType(dataFormat);
+
+	// The rows of the CPU buffers are tightly packed
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTextureSubImage2D(m_Handle, 0, 0, 0, m_Width, m_Height, glDataFormat, glDataType, data);
 }
\ No newline at end of file
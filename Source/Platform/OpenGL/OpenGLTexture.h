@@ -19,6 +19,8 @@ public:
 
 	virtual void Bind(uint32_t slot = 0) const override;
 	virtual void BindToImageUnit(uint32_t unit, bool read, bool write) override;
+
+	virtual void SetData(const void* data, TextureFormat dataFormat) override;
 private:
 	GLuint m_Handle = 0;
 	uint32_t m_Width = 0, m_Height = 0;
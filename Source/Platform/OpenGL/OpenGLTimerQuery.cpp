@@ -0,0 +1,36 @@
+#include "OpenGLTimerQuery.h"
+
+#include "Core/Log.h"
+
+OpenGLTimerQuery::OpenGLTimerQuery() {
+	Log::Trace("OpenGLTimerQuery::OpenGLTimerQuery - Creating OpenGL Timer Query");
+
+	glCreateQueries(GL_TIME_ELAPSED, 1, &m_Handle);
+}
+
+OpenGLTimerQuery::~OpenGLTimerQuery() {
+	glDeleteQueries(1, &m_Handle);
+}
+
+void OpenGLTimerQuery::Begin() {
+	glBeginQuery(GL_TIME_ELAPSED, m_Handle);
+}
+
+void OpenGLTimerQuery::End() {
+	glEndQuery(GL_TIME_ELAPSED);
+}
+
+bool OpenGLTimerQuery::IsAvailable() const {
+	GLint available = GL_FALSE;
+	glGetQueryObjectiv(m_Handle, GL_QUERY_RESULT_AVAILABLE, &available);
+
+	return available == GL_TRUE;
+}
+
+double OpenGLTimerQuery::GetElapsedTime() const {
+	// In nanoseconds
+	GLuint64 elapsed = 0;
+	glGetQueryObjectui64v(m_Handle, GL_QUERY_RESULT, &elapsed);
+
+	return (double)elapsed * 1e-6;
+}
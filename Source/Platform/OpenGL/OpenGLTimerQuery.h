@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Renderer/TimerQuery.h"
+
+#include <glad/glad.h>
+
+class OpenGLTimerQuery : public TimerQuery {
+public:
+	OpenGLTimerQuery();
+	virtual ~OpenGLTimerQuery();
+
+	virtual void Begin() override;
+	virtual void End() override;
+
+	virtual bool IsAvailable() const override;
+	virtual double GetElapsedTime() const override;
+
+	GLuint GetHandle() const { return m_Handle; }
+private:
+	GLuint m_Handle = 0;
+};
@@ -0,0 +1,290 @@
+#include "AreaSkipping.h"
+
+#include <algorithm>
+
+// Rectangles with fewer interior pixels are iterated directly, as subdividing them would iterate most of their pixels anyway
+static constexpr uint32_t MinimumSubdivisionArea = 16;
+
+// The spacing of the coarsest grid of solid guessing
+static constexpr uint32_t GuessStep = 8;
+
+// Whether every pixel of a run has the given iteration count
+static bool IsUniformRun(OrbitTile& tile, uint32_t x, uint32_t y, uint32_t count, uint32_t strideX, uint32_t strideY, int iterations) {
+	for (uint32_t i = 0; i < count; ++i) {
+		if (tile.GetOrbit(x + i * strideX, y + i * strideY).Iterations != iterations) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// The coordinate of the grid line 'index' of a grid of spacing 'step', the last line being clamped to the edge of the tile
+static uint32_t GetGridLine(uint32_t index, uint32_t step, uint32_t size) {
+	return std::min(index * step, size - 1);
+}
+
+// The number of blocks between the grid lines of a grid of spacing 'step'
+static uint32_t GetGridBlockCount(uint32_t step, uint32_t size) {
+	return (size - 1 + step - 1) / step;
+}
+
+void OrbitTile::Reset(uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+	X = x;
+	Y = y;
+	Width = width;
+	Height = height;
+
+	Orbits.resize((size_t)width * height);
+	States.assign((size_t)width * height, PixelState::Pending);
+}
+
+void AreaSkipping::Render(AreaSkippingMode mode, bool verify, const KernelParameters& params, OrbitTile& tile, const IteratePixelsFunction& iteratePixels) {
+	switch (mode) {
+		case AreaSkippingMode::MarianiSilver:
+			MarianiSilver(verify, params, tile, iteratePixels);
+			break;
+		case AreaSkippingMode::SolidGuessing:
+			SolidGuessing(verify, params, tile, iteratePixels);
+			break;
+		default:
+			for (uint32_t y = 0; y < tile.Height; ++y) {
+				QueueRun(tile, 0, y, tile.Width, 1, 0);
+			}
+
+			Flush(tile, iteratePixels);
+			break;
+	}
+}
+
+bool AreaSkipping::CanFill(const KernelParameters& params, const OrbitResult& orbit) {
+	// The orbit trap colors every pixel by its own orbit
+	if (params.Trap.Type != OrbitTrapType::None) {
+		return false;
+	}
+
+	if (orbit.Iterations >= params.MaxIterations) {
+		return true;
+	}
+
+	return params.ExteriorColoring == ColorAlgorithm::Step && !params.OrbitColoring;
+}
+
+void AreaSkipping::Queue(OrbitTile& tile, uint32_t x, uint32_t y) {
+	OrbitTile::PixelState& state = tile.GetState(x, y);
+
+	// A queued pixel counts as computed already, so it is neither queued twice nor filled before its batch is flushed
+	if (state == OrbitTile::PixelState::Pending) {
+		state = OrbitTile::PixelState::Computed;
+		tile.m_Queue.emplace_back(tile.X + x, tile.Y + y);
+	}
+}
+
+void AreaSkipping::QueueRun(OrbitTile& tile, uint32_t x, uint32_t y, uint32_t count, uint32_t strideX, uint32_t strideY) {
+	for (uint32_t i = 0; i < count; ++i) {
+		Queue(tile, x + i * strideX, y + i * strideY);
+	}
+}
+
+void AreaSkipping::Flush(OrbitTile& tile, const IteratePixelsFunction& iteratePixels) {
+	const uint32_t count = (uint32_t)tile.m_Queue.size();
+	if (count == 0) {
+		return;
+	}
+
+	tile.m_Results.resize(count);
+	iteratePixels(tile.m_Queue.data(), count, tile.m_Results.data());
+
+	for (uint32_t i = 0; i < count; ++i) {
+		const glm::uvec2& pixel = tile.m_Queue[i];
+		tile.GetOrbit(pixel.x - tile.X, pixel.y - tile.Y) = tile.m_Results[i];
+	}
+
+	tile.m_Queue.clear();
+}
+
+void AreaSkipping::Fill(OrbitTile& tile, uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1, const OrbitResult& orbit) {
+	OrbitResult filled = orbit;
+	filled.ExecutedIterations = 0;
+
+	for (uint32_t y = y0; y <= y1; ++y) {
+		for (uint32_t x = x0; x <= x1; ++x) {
+			OrbitTile::PixelState& state = tile.GetState(x, y);
+
+			if (state == OrbitTile::PixelState::Pending) {
+				tile.GetOrbit(x, y) = filled;
+				state = OrbitTile::PixelState::Filled;
+			}
+		}
+	}
+}
+
+#pragma region - Mariani-Silver -
+
+void AreaSkipping::MarianiSilver(bool verify, const KernelParameters& params, OrbitTile& tile, const IteratePixelsFunction& iteratePixels) {
+	const uint32_t right = tile.Width - 1;
+	const uint32_t top = tile.Height - 1;
+
+	QueueRun(tile, 0, 0, tile.Width, 1, 0);
+	QueueRun(tile, 0, top, tile.Width, 1, 0);
+	QueueRun(tile, 0, 0, tile.Height, 0, 1);
+	QueueRun(tile, right, 0, tile.Height, 0, 1);
+	Flush(tile, iteratePixels);
+
+	std::vector<OrbitTile::Region>& regions = tile.m_Regions;
+	std::vector<OrbitTile::Region>& nextRegions = tile.m_NextRegions;
+
+	regions.clear();
+	regions.push_back({ 0, 0, right, top, false });
+
+	// The regions are subdivided one level at a time, so the lines of every region of a level are iterated in the same batch
+	while (!regions.empty()) {
+		nextRegions.clear();
+
+		for (OrbitTile::Region& region : regions) {
+			region.UniformBorder = IsUniformBorder(params, tile, region);
+
+			// The middle row and column are the borders of the next subdivision, so checking them is free when the region ends up split
+			if (region.UniformBorder && verify) {
+				QueueMiddleLines(tile, region);
+			}
+		}
+
+		if (verify) {
+			Flush(tile, iteratePixels);
+		}
+
+		for (const OrbitTile::Region& region : regions) {
+			const uint32_t interiorWidth = region.GetInteriorWidth();
+			const uint32_t interiorHeight = region.GetInteriorHeight();
+
+			if (interiorWidth == 0 || interiorHeight == 0) {
+				continue;
+			}
+
+			if (interiorWidth * interiorHeight <= MinimumSubdivisionArea) {
+				for (uint32_t y = region.Y0 + 1; y < region.Y1; ++y) {
+					QueueRun(tile, region.X0 + 1, y, interiorWidth, 1, 0);
+				}
+
+				continue;
+			}
+
+			if (region.UniformBorder && (!verify || AreMiddleLinesUniform(tile, region))) {
+				Fill(tile, region.X0 + 1, region.Y0 + 1, region.X1 - 1, region.Y1 - 1, tile.GetOrbit(region.X0, region.Y0));
+				continue;
+			}
+
+			QueueMiddleLines(tile, region);
+
+			const uint32_t midX = (region.X0 + region.X1) / 2;
+			const uint32_t midY = (region.Y0 + region.Y1) / 2;
+
+			nextRegions.push_back({ region.X0, region.Y0, midX, midY, false });
+			nextRegions.push_back({ midX, region.Y0, region.X1, midY, false });
+			nextRegions.push_back({ region.X0, midY, midX, region.Y1, false });
+			nextRegions.push_back({ midX, midY, region.X1, region.Y1, false });
+		}
+
+		Flush(tile, iteratePixels);
+		std::swap(regions, nextRegions);
+	}
+}
+
+void AreaSkipping::QueueMiddleLines(OrbitTile& tile, const OrbitTile::Region& region) {
+	const uint32_t midX = (region.X0 + region.X1) / 2;
+	const uint32_t midY = (region.Y0 + region.Y1) / 2;
+
+	QueueRun(tile, region.X0 + 1, midY, region.GetInteriorWidth(), 1, 0);
+	QueueRun(tile, midX, region.Y0 + 1, region.GetInteriorHeight(), 0, 1);
+}
+
+bool AreaSkipping::IsUniformBorder(const KernelParameters& params, OrbitTile& tile, const OrbitTile::Region& region) {
+	const OrbitResult& corner = tile.GetOrbit(region.X0, region.Y0);
+	if (!CanFill(params, corner)) {
+		return false;
+	}
+
+	const uint32_t width = region.X1 - region.X0 + 1;
+	const uint32_t height = region.Y1 - region.Y0 + 1;
+
+	return IsUniformRun(tile, region.X0, region.Y0, width, 1, 0, corner.Iterations)
+		&& IsUniformRun(tile, region.X0, region.Y1, width, 1, 0, corner.Iterations)
+		&& IsUniformRun(tile, region.X0, region.Y0, height, 0, 1, corner.Iterations)
+		&& IsUniformRun(tile, region.X1, region.Y0, height, 0, 1, corner.Iterations);
+}
+
+bool AreaSkipping::AreMiddleLinesUniform(OrbitTile& tile, const OrbitTile::Region& region) {
+	const int iterations = tile.GetOrbit(region.X0, region.Y0).Iterations;
+	const uint32_t midX = (region.X0 + region.X1) / 2;
+	const uint32_t midY = (region.Y0 + region.Y1) / 2;
+
+	return IsUniformRun(tile, region.X0 + 1, midY, region.GetInteriorWidth(), 1, 0, iterations)
+		&& IsUniformRun(tile, midX, region.Y0 + 1, region.GetInteriorHeight(), 0, 1, iterations);
+}
+
+#pragma endregion
+
+#pragma region - Solid Guessing -
+
+void AreaSkipping::SolidGuessing(bool verify, const KernelParameters& params, OrbitTile& tile, const IteratePixelsFunction& iteratePixels) {
+	uint32_t step = GuessStep;
+	QueueGrid(tile, step);
+	Flush(tile, iteratePixels);
+
+	while (step > 1) {
+		const uint32_t blocksX = GetGridBlockCount(step, tile.Width);
+		const uint32_t blocksY = GetGridBlockCount(step, tile.Height);
+
+		for (uint32_t blockY = 0; blockY < blocksY; ++blockY) {
+			for (uint32_t blockX = 0; blockX < blocksX; ++blockX) {
+				const uint32_t x0 = GetGridLine(blockX, step, tile.Width);
+				const uint32_t y0 = GetGridLine(blockY, step, tile.Height);
+				const uint32_t x1 = GetGridLine(blockX + 1, step, tile.Width);
+				const uint32_t y1 = GetGridLine(blockY + 1, step, tile.Height);
+
+				const OrbitResult& corner = tile.GetOrbit(x0, y0);
+				if (!CanFill(params, corner)) {
+					continue;
+				}
+
+				// The corners of the block, or with verification the corners of the 3x3 blocks around it, must agree
+				const uint32_t margin = verify ? 1 : 0;
+				const uint32_t firstX = blockX >= margin ? blockX - margin : 0;
+				const uint32_t firstY = blockY >= margin ? blockY - margin : 0;
+				const uint32_t lastX = std::min(blockX + 1 + margin, blocksX);
+				const uint32_t lastY = std::min(blockY + 1 + margin, blocksY);
+
+				bool uniform = true;
+				for (uint32_t lineY = firstY; lineY <= lastY && uniform; ++lineY) {
+					for (uint32_t lineX = firstX; lineX <= lastX && uniform; ++lineX) {
+						uniform = tile.GetOrbit(GetGridLine(lineX, step, tile.Width), GetGridLine(lineY, step, tile.Height)).Iterations == corner.Iterations;
+					}
+				}
+
+				if (uniform) {
+					Fill(tile, x0, y0, x1, y1, corner);
+				}
+			}
+		}
+
+		step /= 2;
+		QueueGrid(tile, step);
+		Flush(tile, iteratePixels);
+	}
+}
+
+void AreaSkipping::QueueGrid(OrbitTile& tile, uint32_t step) {
+	const uint32_t lines = GetGridBlockCount(step, tile.Height) + 1;
+	const uint32_t columns = GetGridBlockCount(step, tile.Width) + 1;
+
+	for (uint32_t line = 0; line < lines; ++line) {
+		const uint32_t y = GetGridLine(line, step, tile.Height);
+
+		for (uint32_t column = 0; column < columns; ++column) {
+			Queue(tile, GetGridLine(column, step, tile.Width), y);
+		}
+	}
+}
+
+#pragma endregion
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Core/Settings/Settings.h"
+
+#include "Renderer/CPU/FractalKernel.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * The orbits of a tile of the image, along with how each pixel got its orbit.
+ *
+ * Coordinates are relative to the tile, and rows are stored bottom-up like the image.
+ */
+struct OrbitTile {
+	enum class PixelState : uint8_t {
+		/// @brief The pixel has no orbit yet.
+		Pending,
+
+		/// @brief The pixel was iterated.
+		Computed,
+
+		/// @brief The pixel was filled with the orbit of its region, without being iterated.
+		Filled
+	};
+
+	/// @brief The position of the tile in the image, in pixels.
+	uint32_t X = 0, Y = 0;
+
+	/// @brief The size of the tile, in pixels.
+	uint32_t Width = 0, Height = 0;
+
+	std::vector<OrbitResult> Orbits;
+	std::vector<PixelState> States;
+
+	/**
+	 * Moves the tile and marks all its pixels as pending, keeping the allocations.
+	 */
+	void Reset(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+	OrbitResult& GetOrbit(uint32_t x, uint32_t y) { return Orbits[(size_t)y * Width + x]; }
+	PixelState& GetState(uint32_t x, uint32_t y) { return States[(size_t)y * Width + x]; }
+private:
+	friend class AreaSkipping;
+
+	/// @brief An inclusive rectangle of the tile, whose border is known.
+	struct Region {
+		uint32_t X0, Y0, X1, Y1;
+		bool UniformBorder;
+
+		uint32_t GetInteriorWidth() const { return X1 - X0 > 1 ? X1 - X0 - 1 : 0; }
+		uint32_t GetInteriorHeight() const { return Y1 - Y0 > 1 ? Y1 - Y0 - 1 : 0; }
+	};
+
+	/// @brief The pixels waiting to be iterated together (in image coordinates), and their orbits.
+	std::vector<glm::uvec2> m_Queue;
+	std::vector<OrbitResult> m_Results;
+
+	/// @brief The regions of the current and next subdivision levels of Mariani-Silver.
+	std::vector<Region> m_Regions, m_NextRegions;
+};
+
+/**
+ * Computes the orbits of a tile while skipping its uniform regions (see `AreaSkippingMode`).
+ *
+ * The pixels a strategy needs are queued and iterated in batches, so the SIMD kernels keep their lanes busy even though the pixels are scattered.
+ * Both strategies only ever fill a region with the orbit of its own pixels when the color of that orbit follows from its iteration count alone (see `CanFill`),
+ * so the filled pixels are shaded exactly like the pixels they were copied from.
+ */
+class AreaSkipping {
+public:
+	/**
+	 * Iterates a list of pixels of the image.
+	 */
+	using IteratePixelsFunction = std::function<void(const glm::uvec2* pixels, uint32_t count, OrbitResult* results)>;
+
+	/**
+	 * Computes every pixel of the tile, either by iterating it or by filling it.
+	 *
+	 * @param mode The area-skipping strategy. With `None`, every pixel is iterated.
+	 * @param verify Whether the strategy checks more pixels before filling a region.
+	 * @param params The kernel parameters of the frame.
+	 * @param tile The tile to compute, reset to the area it covers.
+	 * @param iteratePixels Iterates lists of pixels, in image coordinates.
+	 */
+	static void Render(AreaSkippingMode mode, bool verify, const KernelParameters& params, OrbitTile& tile, const IteratePixelsFunction& iteratePixels);
+
+	/**
+	 * Checks whether a region whose pixels all share the iteration count of `orbit` can be filled with it.
+	 *
+	 * That is the case for interior pixels (without orbit trap), and for exterior pixels with `Step` coloring and no orbit coloring.
+	 */
+	static bool CanFill(const KernelParameters& params, const OrbitResult& orbit);
+private:
+	static void Queue(OrbitTile& tile, uint32_t x, uint32_t y);
+	static void QueueRun(OrbitTile& tile, uint32_t x, uint32_t y, uint32_t count, uint32_t strideX, uint32_t strideY);
+	static void Flush(OrbitTile& tile, const IteratePixelsFunction& iteratePixels);
+	static void Fill(OrbitTile& tile, uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1, const OrbitResult& orbit);
+
+	static void MarianiSilver(bool verify, const KernelParameters& params, OrbitTile& tile, const IteratePixelsFunction& iteratePixels);
+	static void QueueMiddleLines(OrbitTile& tile, const OrbitTile::Region& region);
+	static bool IsUniformBorder(const KernelParameters& params, OrbitTile& tile, const OrbitTile::Region& region);
+	static bool AreMiddleLinesUniform(OrbitTile& tile, const OrbitTile::Region& region);
+
+	static void SolidGuessing(bool verify, const KernelParameters& params, OrbitTile& tile, const IteratePixelsFunction& iteratePixels);
+	static void QueueGrid(OrbitTile& tile, uint32_t step);
+};
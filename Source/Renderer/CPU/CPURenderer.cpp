@@ -0,0 +1,1285 @@
+#include "CPURenderer.h"
+
+#include "Core/CPUFeatures.h"
+#include "Core/Log.h"
+#include "Core/Profiler.h"
+
+#include "Renderer/CPU/AreaSkipping.h"
+#include "Renderer/CPU/FractalKernel.h"
+#include "Renderer/CPU/PerturbationKernel.h"
+#include "Renderer/Supersampling.h"
+
+#include "Utilities/Utilities.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+
+#include <xmmintrin.h>
+#include <pmmintrin.h>
+
+// The tiles of the frame and of the tile cache both fit in the slots of the tile store
+static_assert(CPURenderer::TileSize <= TileStore::MaximumTileSize && TileCache::TileSize <= TileStore::MaximumTileSize);
+
+// The number of bins each task of the prefix sum of the histogram scans
+static constexpr uint32_t HistogramChunkSize = 256;
+
+// The number of supersampled pixels each task iterates the samples of
+static constexpr uint32_t SampleChunkSize = 256;
+
+// The pass of progressive rendering each pixel of a 4x4 block is iterated in (an ordered dither matrix), so every pass spreads evenly over the block.
+// The first pass covers a pixel in 16, and the first four passes cover every other pixel of every other row.
+static constexpr uint32_t ProgressivePasses = 16;
+static constexpr uint8_t ProgressiveOrder[4][4] = {
+	{ 0, 8, 2, 10 },
+	{ 12, 4, 14, 6 },
+	{ 3, 11, 1, 9 },
+	{ 15, 7, 13, 5 }
+};
+
+static uint8_t ToUNorm8(float value) {
+	return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+/**
+ * Enables flush-to-zero and denormals-are-zero for the lifetime of the object, restoring the previous mode afterwards.
+ *
+ * GPUs flush denormals, and interior orbits (whose derivative decays towards zero) would otherwise hit the very slow denormal path of the CPU.
+ */
+struct ScopedFlushDenormals {
+	unsigned int PreviousMode;
+
+	ScopedFlushDenormals() : PreviousMode(_mm_getcsr()) {
+		_mm_setcsr(PreviousMode | _MM_FLUSH_ZERO_ON | _MM_DENORMALS_ZERO_ON);
+	}
+
+	~ScopedFlushDenormals() {
+		_mm_setcsr(PreviousMode);
+	}
+};
+
+// Whether two settings of the CPU engine give every pixel the same orbit
+static bool HasSameOrbitSettings(const CPURenderingSettings& a, const CPURenderingSettings& b) {
+	return a.SIMD == b.SIMD
+		&& a.Perturbation == b.Perturbation
+		&& a.SeriesApproximation == b.SeriesApproximation
+		&& a.AreaSkipping == b.AreaSkipping
+		&& a.VerifyAreaSkipping == b.VerifyAreaSkipping
+		&& a.TileCache == b.TileCache;
+}
+
+// The settings of the CPU engine the orbits of a stored tile depend on, with the instruction set the kernels resolved to (their rounding differs slightly)
+static void AddOrbitSettings(TileKeyBuilder& builder, const CPURenderingSettings& settings, InstructionSet simd) {
+	builder.Add(simd)
+		.Add(settings.Perturbation)
+		.Add(settings.SeriesApproximation)
+		.Add(settings.AreaSkipping)
+		.Add(settings.VerifyAreaSkipping);
+}
+
+static void AddFractal(TileKeyBuilder& builder, const TileFractal& fractal) {
+	builder.Add(fractal.Algorithm)
+		.Add(fractal.Power)
+		.Add(fractal.Bailout)
+		.Add(fractal.MaxIterations)
+		.Add(fractal.JuliaMode)
+		.Add(fractal.JuliaC)
+		.Add(fractal.NeedsDerivative)
+		.Add(fractal.TrapType)
+		.Add(fractal.TrapP1)
+		.Add(fractal.TrapP2)
+		.Add(fractal.FilledExterior);
+}
+
+CPURenderer::CPURenderer(uint32_t threadCount) {
+	Log::Trace("CPURenderer::CPURenderer - Creating the CPU Renderer");
+
+	m_ThreadPool = CreateScope<ThreadPool>(threadCount);
+
+	m_ResolvedSIMD = CPUFeatures::Resolve(m_RequestedSIMD);
+	Log::Info("CPURenderer::CPURenderer - Using " + Utilities::InstructionSetToString(m_ResolvedSIMD) + " kernels");
+}
+
+void CPURenderer::Render(const Mandelbrot& mandelbrot, uint32_t width, uint32_t height, const CPURenderingSettings& settings, float frameBudget, const SupersamplingSettings& supersampling, bool settled) {
+	MB_PROFILE_SCOPE("CPURenderer::Render");
+
+	if (width == 0 || height == 0) {
+		return;
+	}
+
+	if (width != m_Width || height != m_Height) {
+		m_Width = width;
+		m_Height = height;
+		m_Pixels.resize((size_t)width * height * 4);
+		m_Orbits.resize((size_t)width * height);
+		m_PreviousOrbits.resize((size_t)width * height);
+		m_HasOrbits = false;
+
+		m_TilesX = (width + TileSize - 1) / TileSize;
+		m_TilesY = (height + TileSize - 1) / TileSize;
+		m_TileStates.assign((size_t)m_TilesX * m_TilesY, TileState::Refined);
+		m_TilePasses.assign((size_t)m_TilesX * m_TilesY, 0);
+		m_PendingTiles = 0;
+	}
+
+	if (settings.SIMD != m_RequestedSIMD) {
+		m_RequestedSIMD = settings.SIMD;
+		m_ResolvedSIMD = CPUFeatures::Resolve(settings.SIMD);
+		Log::Info("CPURenderer::Render - Switched to " + Utilities::InstructionSetToString(m_ResolvedSIMD) + " kernels");
+	}
+
+	UpdateTileStore(settings);
+	m_Settled = settled;
+
+	const auto start = std::chrono::steady_clock::now();
+
+	// Area skipping only fills the regions whose color follows from their iteration count (see `AreaSkipping::CanFill`), which depends on the coloring
+	const bool sameFills = settings.AreaSkipping == AreaSkippingMode::None
+		|| (mandelbrot.ExteriorColoring == m_OrbitFractal.ExteriorColoring && mandelbrot.OrbitColoring == m_OrbitFractal.OrbitColoring);
+
+	const bool canReuse = m_HasOrbits && HasSameOrbitSettings(settings, m_OrbitSettings) && sameFills;
+
+	// The addresses of the tiles of the cache only resolve the views double precision can render, so deeper ones bypass it
+	bool cached = settings.TileCache && !mandelbrot.RequiresPerturbation(height);
+	m_TileCache.SetCapacity(settings.TileCacheSize > 0 ? (size_t)settings.TileCacheSize << 20 : TileCache::GetAutomaticCapacity(width, height));
+
+	if (!settings.TileCache) {
+		m_TileCache.Clear();
+	}
+
+	// A view being panned is snapped to the pixel grid of the previous frame, whose orbits then only need shifting.
+	// The tiles of a view being refined are aligned to the frame, so it is reprojected instead. The tile cache samples any view, so it needs neither.
+	Mandelbrot frame = mandelbrot;
+	glm::ivec2 pan(0);
+	const bool panned = canReuse && !cached && m_PendingTiles == 0 && frame.SnapToPixelGrid(m_OrbitFractal, m_RequestedPosition, width, height, pan);
+	m_RequestedPosition = mandelbrot.Position;
+
+	KernelParameters params = KernelParameters::Create(frame, width, height);
+	params.UsePerturbation = params.UsePerturbation && settings.Perturbation;
+
+	// Coloring changes leave the orbits of the previous frame valid, so only the shading pass runs again
+	const bool reuseOrbits = canReuse && frame.HasSameOrbits(m_OrbitFractal);
+
+	// A zoomed or rotated view starts from the previous image resampled to it, which the following frames refine
+	const bool reproject = !reuseOrbits && !panned && !cached && canReuse && settings.ZoomReprojection && frame.IsSameFractal(m_OrbitFractal);
+
+	// Progressive rendering iterates scattered pixels, which area skipping cannot fill
+	const bool progressive = !reuseOrbits && !panned && !reproject && !cached && settings.Progressive && settings.AreaSkipping == AreaSkippingMode::None;
+
+	if (!reuseOrbits) {
+		m_Statistics.LoadedTiles = 0;
+
+		std::fill(m_TileStates.begin(), m_TileStates.end(), TileState::Refined);
+		m_PendingTiles = 0;
+		m_Progressive = progressive;
+
+		if (reproject) {
+			ReprojectOrbits(m_OrbitFractal, frame);
+		} else if (progressive) {
+			// The passes are run below, along with those of the following frames
+			std::fill(m_TileStates.begin(), m_TileStates.end(), TileState::Progressive);
+			std::fill(m_TilePasses.begin(), m_TilePasses.end(), 0);
+			m_PendingTiles = (uint32_t)m_TileStates.size();
+		} else if (cached) {
+			// A view needing more tiles than the cache holds would evict its own tiles every frame, so it is rendered directly
+			cached = RenderCached(frame, params, settings);
+
+			if (!cached) {
+				IterateFrame(frame, params, settings);
+			}
+		} else if (panned) {
+			ShiftOrbits(pan);
+			Iterate(frame, params, settings, GetExposedRegions(pan));
+			GatherEscapes(params);
+		} else {
+			IterateFrame(frame, params, settings);
+		}
+
+		if (!cached) {
+			m_Statistics.CachedTiles = 0;
+			m_Statistics.RenderedTiles = 0;
+		}
+
+		m_OrbitFractal = frame;
+		m_OrbitSettings = settings;
+		m_HasOrbits = true;
+		m_HasHistogram = false;
+	}
+
+	m_TileCache.Trim();
+
+	// Views rendered over several frames iterate until the budget of the frame runs out
+	const bool refine = m_PendingTiles > 0;
+	if (refine) {
+		const auto deadline = frameBudget > 0.0f
+			? start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(frameBudget))
+			: std::chrono::steady_clock::time_point::max();
+
+		if (m_Progressive) {
+			Progress(frame, params, settings, deadline);
+		} else {
+			Refine(frame, params, settings, deadline);
+			GatherEscapes(params);
+		}
+
+		m_HasHistogram = false;
+	}
+
+	// The cumulative histogram only depends on the orbits, so it is built once for every iterated frame
+	if (mandelbrot.ExteriorColoring == ColorAlgorithm::Histogram) {
+		if (!m_HasHistogram) {
+			BuildHistogram(params);
+			m_HasHistogram = true;
+		}
+
+		params.HistogramCDF = m_HistogramCDF.data();
+	}
+
+	m_PaletteLUT.Update(mandelbrot.ColorPalette);
+	params.Palette = &m_PaletteLUT;
+
+	Shade(params);
+
+	// The previews of a view rendered over several frames are replaced anyway, so only the final image is supersampled.
+	// Coloring edits (like scrubbing the palette) reuse the orbits, but the extra samples would be iterated again, as costly as a full render,
+	// so their frames are shown without supersampling until the coloring stops changing, and the next frame of the same fractal supersamples it.
+	m_Statistics.SupersampledPixels = 0;
+	m_Statistics.SupersamplingTime = 0.0;
+
+	const bool recolored = reuseOrbits && !refine && !(mandelbrot == m_ShadedFractal);
+	m_SupersamplingDeferred = supersampling.Enabled && m_PendingTiles == 0 && recolored;
+	m_ShadedFractal = mandelbrot;
+
+	if (supersampling.Enabled && m_PendingTiles == 0 && !m_SupersamplingDeferred) {
+		Supersample(frame, params, settings, supersampling);
+	}
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	m_Statistics.ReusedOrbits = reuseOrbits && !refine;
+	m_Statistics.PendingTiles = m_PendingTiles;
+	m_Statistics.TileCacheSize = m_TileCache.GetSize();
+	m_Statistics.StoredTiles = m_TileStore.GetTileCount();
+	m_Statistics.PannedPixels = !reuseOrbits && panned ? (uint64_t)(width - std::abs(pan.x)) * (height - std::abs(pan.y)) : 0;
+	m_Statistics.FrameTime = elapsed.count() * 1000.0;
+}
+
+void CPURenderer::Invalidate() {
+	m_HasOrbits = false;
+	m_HasHistogram = false;
+	m_PendingTiles = 0;
+	m_SupersamplingDeferred = false;
+	std::fill(m_TileStates.begin(), m_TileStates.end(), TileState::Refined);
+
+	m_ReferenceOrbit.Clear();
+}
+
+void CPURenderer::Iterate(const Mandelbrot& mandelbrot, const KernelParameters& params, const CPURenderingSettings& settings, const std::vector<ImageRegion>& regions, std::chrono::steady_clock::time_point deadline) {
+	const auto start = std::chrono::steady_clock::now();
+
+	const uint32_t width = m_Width;
+	const SeriesApproximation series = PrepareIteration(mandelbrot, params, settings);
+
+	// The regions are split into tiles, starting from their corner
+	m_Tiles.clear();
+	for (const ImageRegion& region : regions) {
+		for (uint32_t y = region.Y0; y < region.Y1; y += TileSize) {
+			for (uint32_t x = region.X0; x < region.X1; x += TileSize) {
+				m_Tiles.push_back({ x, y, std::min(x + TileSize, region.X1), std::min(y + TileSize, region.Y1) });
+			}
+		}
+	}
+
+	const uint32_t tileCount = (uint32_t)m_Tiles.size();
+	const uint32_t threadCount = m_ThreadPool->GetThreadCount();
+
+	std::atomic<uint64_t> totalIterations = 0;
+	std::atomic<uint64_t> totalRebases = 0;
+	std::atomic<uint64_t> totalRejected = 0;
+	std::atomic<uint64_t> totalSkipped = 0;
+
+	// Each tile gathers its own escape statistics, merged once the frame is done
+	m_TileEscapes.assign(tileCount, EscapeStatistics{ params.MaxIterations });
+	m_TileIterated.assign(tileCount, 0);
+
+	m_ThreadPool->ParallelFor(tileCount, [&](uint32_t tileIndex) {
+		// Past the deadline, the remaining tiles wait for a later frame, though every thread still iterates one
+		if (tileIndex >= threadCount && std::chrono::steady_clock::now() >= deadline) {
+			return;
+		}
+
+		m_TileIterated[tileIndex] = 1;
+
+		ScopedFlushDenormals flushDenormals;
+
+		const uint32_t x0 = m_Tiles[tileIndex].X0;
+		const uint32_t y0 = m_Tiles[tileIndex].Y0;
+		const uint32_t x1 = m_Tiles[tileIndex].X1;
+		const uint32_t y1 = m_Tiles[tileIndex].Y1;
+
+		uint64_t tileIterations = 0;
+		uint64_t tileRebases = 0;
+		uint64_t tileRejected = 0;
+		uint64_t tileSkipped = 0;
+		EscapeStatistics& tileEscapes = m_TileEscapes[tileIndex];
+
+		const AreaSkipping::IteratePixelsFunction iteratePixels = [&](const glm::uvec2* pixels, uint32_t count, OrbitResult* results) {
+			tileRebases += IteratePixels(params, series, pixels, count, results);
+		};
+
+		// Each worker keeps its tile buffer across tiles and frames
+		thread_local OrbitTile tile;
+		tile.Reset(x0, y0, x1 - x0, y1 - y0);
+
+		AreaSkipping::Render(settings.AreaSkipping, settings.VerifyAreaSkipping, params, tile, iteratePixels);
+
+		for (uint32_t y = y0; y < y1; ++y) {
+			OrbitResult* row = m_Orbits.data() + (size_t)y * width;
+
+			for (uint32_t x = x0; x < x1; ++x) {
+				const OrbitResult& orbit = tile.GetOrbit(x - x0, y - y0);
+				row[x] = orbit;
+
+				tileIterations += (uint64_t)orbit.ExecutedIterations;
+				tileEscapes.Add(orbit.Iterations, orbit.ProvenInterior);
+
+				// Apart from the pixels filled by area skipping, only the interior test finishes an interior pixel without iterating it
+				if (tile.GetState(x - x0, y - y0) == OrbitTile::PixelState::Filled) {
+					++tileSkipped;
+				} else if (params.RejectInterior && orbit.ExecutedIterations == 0 && orbit.Iterations >= params.MaxIterations) {
+					++tileRejected;
+				}
+			}
+		}
+
+		totalIterations.fetch_add(tileIterations, std::memory_order_relaxed);
+		totalRebases.fetch_add(tileRebases, std::memory_order_relaxed);
+		totalRejected.fetch_add(tileRejected, std::memory_order_relaxed);
+		totalSkipped.fetch_add(tileSkipped, std::memory_order_relaxed);
+	});
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	m_Statistics.Iterations = totalIterations.load();
+	m_Statistics.RejectedPixels = totalRejected.load();
+	m_Statistics.SkippedPixels = totalSkipped.load();
+	m_Statistics.Rebases = totalRebases.load();
+
+	ReportIteration(params, series, elapsed.count());
+}
+
+SeriesApproximation CPURenderer::PrepareIteration(const Mandelbrot& mandelbrot, const KernelParameters& params, const CPURenderingSettings& settings) {
+	// Perturbation iterates every pixel against the orbit of the view center, which is only recomputed when the center moves
+	SeriesApproximation series;
+	if (params.UsePerturbation) {
+		m_ReferenceOrbit.Update(mandelbrot.Position, mandelbrot.GetPixelSpacing(m_Height), params.MaxIterations, params.Bailout);
+
+		// The skipped iterations would be missing from the orbit trap distances
+		if (settings.SeriesApproximation && params.Trap.Type == OrbitTrapType::None) {
+			const double aspect = (double)m_Width / (double)m_Height;
+			series = m_ReferenceOrbit.ComputeSeries(std::sqrt(aspect * aspect + 1.0) / params.Zoom, params.MaxIterations);
+		}
+	}
+
+	return series;
+}
+
+uint64_t CPURenderer::IteratePixels(const KernelParameters& params, const SeriesApproximation& series, const glm::uvec2* pixels, uint32_t count, OrbitResult* results) const {
+	if (!params.UsePerturbation) {
+		FractalKernel::IteratePixels(params, m_ResolvedSIMD, pixels, count, results);
+		return 0;
+	}
+
+	// The perturbation kernel is scalar, so the pixels are iterated one by one
+	uint64_t rebases = 0;
+	for (uint32_t i = 0; i < count; ++i) {
+		rebases += PerturbationKernel::IterateRow(params, m_ReferenceOrbit, series, pixels[i].x, pixels[i].y, 1, results + i);
+	}
+
+	return rebases;
+}
+
+void CPURenderer::ReportIteration(const KernelParameters& params, const SeriesApproximation& series, double seconds) {
+	m_Statistics.SIMD = m_ResolvedSIMD;
+	m_Statistics.UsedSIMD = !params.UsePerturbation && m_ResolvedSIMD != InstructionSet::Scalar && FractalKernel::SupportsSIMD(params);
+	m_Statistics.ThreadCount = m_ThreadPool->GetThreadCount();
+
+	m_Statistics.Escapes = EscapeStatistics{ params.MaxIterations };
+	for (const EscapeStatistics& tileEscapes : m_TileEscapes) {
+		m_Statistics.Escapes.Merge(tileEscapes);
+	}
+
+	m_Statistics.IterationTime = seconds * 1000.0;
+	m_Statistics.GigaIterationsPerSecond = seconds > 0.0 ? (double)m_Statistics.Iterations / seconds * 1e-9 : 0.0;
+	m_Statistics.Perturbation = params.UsePerturbation;
+	m_Statistics.ReferenceIterations = params.UsePerturbation ? m_ReferenceOrbit.GetLength() - 1 : 0;
+	m_Statistics.SkippedIterations = series.SkippedIterations;
+}
+
+void CPURenderer::IterateFrame(const Mandelbrot& mandelbrot, const KernelParameters& params, const CPURenderingSettings& settings) {
+	const uint32_t width = m_Width;
+	const uint32_t height = m_Height;
+
+	if (!m_TileStore.IsOpen()) {
+		Iterate(mandelbrot, params, settings, { { 0, 0, width, height } });
+		return;
+	}
+
+	// Every tile of the frame is keyed by the whole view, which is how deep views (that no other view shares tiles with) are found again
+	TileKeyBuilder view;
+	view.Add('F')
+		.Add(mandelbrot.Position)
+		.Add(mandelbrot.Zoom)
+		.Add(mandelbrot.Rotation)
+		.Add(width)
+		.Add(height)
+		.Add(params.UsePerturbation);
+
+	AddFractal(view, TileFractal::Create(params, settings));
+	AddOrbitSettings(view, settings, m_ResolvedSIMD);
+
+	const auto getKey = [&](uint32_t x, uint32_t y) {
+		TileKeyBuilder tile = view;
+		return tile.Add(x).Add(y).Get();
+	};
+
+	// The tiles are those of a full render, so the stored tiles are identical to it
+	std::vector<ImageRegion> missing;
+
+	for (uint32_t y0 = 0; y0 < height; y0 += TileSize) {
+		for (uint32_t x0 = 0; x0 < width; x0 += TileSize) {
+			const uint32_t x1 = std::min(x0 + TileSize, width);
+			const uint32_t y1 = std::min(y0 + TileSize, height);
+
+			const OrbitResult* orbits = m_TileStore.Find(getKey(x0, y0), x1 - x0, y1 - y0);
+			if (!orbits) {
+				missing.push_back({ x0, y0, x1, y1 });
+				continue;
+			}
+
+			for (uint32_t y = y0; y < y1; ++y) {
+				std::copy_n(orbits + (size_t)(y - y0) * (x1 - x0), x1 - x0, m_Orbits.data() + (size_t)y * width + x0);
+			}
+
+			++m_Statistics.LoadedTiles;
+		}
+	}
+
+	// A view loaded whole from the store iterates nothing, so the reference orbit and the series of perturbation are not computed either
+	if (missing.empty()) {
+		m_Statistics.Iterations = 0;
+		m_Statistics.RejectedPixels = 0;
+		m_Statistics.SkippedPixels = 0;
+		m_Statistics.Rebases = 0;
+		m_Statistics.IterationTime = 0.0;
+		m_Statistics.GigaIterationsPerSecond = 0.0;
+		m_Statistics.Perturbation = params.UsePerturbation;
+		m_Statistics.ReferenceIterations = 0;
+		m_Statistics.SkippedIterations = 0;
+
+		GatherEscapes(params);
+		return;
+	}
+
+	Iterate(mandelbrot, params, settings, missing);
+
+	// The tiles are keyed by the whole view, so those of a view still moving would only fill the store with views never seen again
+	if (m_Settled) {
+		for (const ImageRegion& tile : missing) {
+			m_TileStore.Store(getKey(tile.X0, tile.Y0), tile.X1 - tile.X0, tile.Y1 - tile.Y0, m_Orbits.data() + (size_t)tile.Y0 * width + tile.X0, width);
+		}
+	}
+
+	if (m_Statistics.LoadedTiles > 0) {
+		GatherEscapes(params);
+	}
+}
+
+void CPURenderer::UpdateTileStore(const CPURenderingSettings& settings) {
+	if (!settings.TileStore) {
+		if (m_TileStore.IsOpen()) {
+			m_TileStore.Close();
+		}
+
+		m_TileStorePath.clear();
+		return;
+	}
+
+	const std::filesystem::path filepath = settings.TileStoreFolder / "Tiles.mbtiles";
+	const size_t capacity = (size_t)std::max(settings.TileStoreSize, 0) << 20;
+
+	// A store that failed to open is only tried again once its settings change
+	if (filepath == m_TileStorePath && capacity == m_TileStoreCapacity) {
+		return;
+	}
+
+	m_TileStorePath = filepath;
+	m_TileStoreCapacity = capacity;
+
+	std::error_code error;
+	std::filesystem::create_directories(settings.TileStoreFolder, error);
+
+	if (!m_TileStore.Open(filepath, capacity)) {
+		Log::Error("CPURenderer::UpdateTileStore - Cannot open the tile store '" + filepath.string() + "'");
+	}
+}
+
+bool CPURenderer::RenderCached(const Mandelbrot& mandelbrot, const KernelParameters& params, const CPURenderingSettings& settings) {
+	const auto start = std::chrono::steady_clock::now();
+
+	const uint32_t width = m_Width;
+	const uint32_t height = m_Height;
+	constexpr uint32_t size = TileCache::TileSize;
+	constexpr uint32_t shift = TileCache::TileShift;
+
+	// The tiles only hold the orbits of the settings they were rendered with
+	if (!HasSameOrbitSettings(settings, m_CacheSettings)) {
+		m_TileCache.Clear();
+		m_CacheSettings = settings;
+	}
+
+	const TileFractal fractal = TileFractal::Create(params, settings);
+
+	TileKeyBuilder store;
+	store.Add('Q');
+	AddFractal(store, fractal);
+	AddOrbitSettings(store, settings, m_ResolvedSIMD);
+
+	const auto getStoreKey = [&](const TileAddress& address) {
+		TileKeyBuilder tile = store;
+		return tile.Add(address.Level).Add(address.X).Add(address.Y).Get();
+	};
+
+	// The view is sampled from the coarsest level of the quadtree whose samples are at most a pixel apart
+	const double pixelSpacing = mandelbrot.GetPixelSpacing(height);
+	const int level = TileCache::GetLevel(pixelSpacing);
+	const double sampleSpacing = TileCache::GetSampleSpacing(level);
+	const double tileSpacing = sampleSpacing * (double)size;
+
+	// The rotation is rounded to float like the kernels do
+	const float rotation = glm::radians(mandelbrot.Rotation);
+	const double cosR = (double)std::cos(rotation), sinR = (double)std::sin(rotation);
+	const glm::dvec2 center(mandelbrot.Position);
+	const glm::dvec2 half((double)width * 0.5, (double)height * 0.5);
+
+	// The point of the plane at the given offset from the view center, in pixels
+	const auto toPlane = [&](double x, double y) {
+		return center + glm::dvec2(cosR * x + sinR * y, -sinR * x + cosR * y) * pixelSpacing;
+	};
+
+	// The tiles under the bounding box of the view
+	glm::dvec2 lower(DBL_MAX), upper(-DBL_MAX);
+	for (const glm::dvec2& corner : { -half, glm::dvec2(half.x, -half.y), glm::dvec2(-half.x, half.y), half }) {
+		const glm::dvec2 point = toPlane(corner.x, corner.y);
+		lower = glm::min(lower, point);
+		upper = glm::max(upper, point);
+	}
+
+	const int64_t firstX = (int64_t)std::floor(lower.x / tileSpacing);
+	const int64_t firstY = (int64_t)std::floor(lower.y / tileSpacing);
+	const uint32_t columns = (uint32_t)((int64_t)std::floor(upper.x / tileSpacing) - firstX + 1);
+	const uint32_t rows = (uint32_t)((int64_t)std::floor(upper.y / tileSpacing) - firstY + 1);
+
+	// A rotated view leaves out the corners of its bounding box, so only the tiles whose circumscribed circle meets the view are kept (with a pixel to spare for rounding)
+	const double radius = tileSpacing * 0.5 * std::sqrt(2.0) / pixelSpacing + 1.0;
+
+	const auto isVisible = [&](const TileAddress& address) {
+		const glm::dvec2 offset = glm::dvec2(((double)address.X + 0.5) * tileSpacing, ((double)address.Y + 0.5) * tileSpacing) - center;
+		const glm::dvec2 pixels = glm::dvec2(cosR * offset.x - sinR * offset.y, sinR * offset.x + cosR * offset.y) / pixelSpacing;
+		return std::abs(pixels.x) <= half.x + radius && std::abs(pixels.y) <= half.y + radius;
+	};
+
+	// The tiles of the frame must all fit in the cache at once, as `Trim` would otherwise evict some of them before the next frame gets to reuse them
+	size_t visibleTiles = 0;
+	for (uint32_t row = 0; row < rows; ++row) {
+		for (uint32_t column = 0; column < columns; ++column) {
+			visibleTiles += isVisible({ level, firstX + column, firstY + row }) ? 1 : 0;
+		}
+	}
+
+	if (visibleTiles * TileCache::TileBytes > m_TileCache.GetCapacity()) {
+		return false;
+	}
+
+	m_CachedTiles.assign((size_t)columns * rows, nullptr);
+	m_MissingTiles.clear();
+	m_MissingOrbits.clear();
+
+	uint32_t cachedTiles = 0;
+	for (uint32_t row = 0; row < rows; ++row) {
+		for (uint32_t column = 0; column < columns; ++column) {
+			const TileAddress address{ level, firstX + column, firstY + row };
+
+			if (!isVisible(address)) {
+				continue;
+			}
+
+			const OrbitResult*& tile = m_CachedTiles[(size_t)row * columns + column];
+			tile = m_TileCache.Find(fractal, address);
+
+			if (!tile) {
+				OrbitResult* orbits = m_TileCache.Insert(fractal, address);
+				tile = orbits;
+
+				// The tile store holds the tiles of previous sessions
+				if (const OrbitResult* stored = m_TileStore.Find(getStoreKey(address), size, size)) {
+					std::copy_n(stored, (size_t)size * size, orbits);
+					++m_Statistics.LoadedTiles;
+				} else {
+					m_MissingTiles.push_back(address);
+					m_MissingOrbits.push_back(orbits);
+				}
+			}
+
+			++cachedTiles;
+		}
+	}
+
+	// Every missing tile is rendered as a view of its own, whose pixels are the samples of the tile
+	const uint32_t missingCount = (uint32_t)m_MissingTiles.size();
+
+	std::atomic<uint64_t> totalIterations = 0;
+	std::atomic<uint64_t> totalRejected = 0;
+	std::atomic<uint64_t> totalSkipped = 0;
+
+	m_ThreadPool->ParallelFor(missingCount, [&](uint32_t index) {
+		ScopedFlushDenormals flushDenormals;
+
+		const TileAddress& address = m_MissingTiles[index];
+
+		Mandelbrot view = mandelbrot;
+		view.Position = BigVec2(glm::dvec2(((double)address.X + 0.5) * tileSpacing, ((double)address.Y + 0.5) * tileSpacing));
+		view.Zoom = 2.0 / tileSpacing;
+		view.Rotation = 0.0f;
+
+		const KernelParameters tileParams = KernelParameters::Create(view, size, size);
+
+		const AreaSkipping::IteratePixelsFunction iteratePixels = [&](const glm::uvec2* pixels, uint32_t count, OrbitResult* results) {
+			FractalKernel::IteratePixels(tileParams, m_ResolvedSIMD, pixels, count, results);
+		};
+
+		thread_local OrbitTile tile;
+		tile.Reset(0, 0, size, size);
+
+		AreaSkipping::Render(settings.AreaSkipping, settings.VerifyAreaSkipping, tileParams, tile, iteratePixels);
+
+		uint64_t tileIterations = 0;
+		uint64_t tileRejected = 0;
+		uint64_t tileSkipped = 0;
+
+		for (size_t i = 0; i < tile.Orbits.size(); ++i) {
+			const OrbitResult& orbit = tile.Orbits[i];
+			tileIterations += (uint64_t)orbit.ExecutedIterations;
+
+			if (tile.States[i] == OrbitTile::PixelState::Filled) {
+				++tileSkipped;
+			} else if (tileParams.RejectInterior && orbit.ExecutedIterations == 0 && orbit.Iterations >= tileParams.MaxIterations) {
+				++tileRejected;
+			}
+		}
+
+		std::copy(tile.Orbits.begin(), tile.Orbits.end(), m_MissingOrbits[index]);
+
+		totalIterations.fetch_add(tileIterations, std::memory_order_relaxed);
+		totalRejected.fetch_add(tileRejected, std::memory_order_relaxed);
+		totalSkipped.fetch_add(tileSkipped, std::memory_order_relaxed);
+	});
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	for (uint32_t index = 0; index < missingCount; ++index) {
+		m_TileStore.Store(getStoreKey(m_MissingTiles[index]), size, size, m_MissingOrbits[index], size);
+	}
+
+	// Every pixel takes the sample whose cell it falls in, at most half a pixel away
+	const uint32_t bands = (height + TileSize - 1) / TileSize;
+
+	m_ThreadPool->ParallelFor(bands, [&](uint32_t band) {
+		const uint32_t first = band * TileSize;
+		const uint32_t last = std::min(first + TileSize, height);
+
+		for (uint32_t y = first; y < last; ++y) {
+			OrbitResult* row = m_Orbits.data() + (size_t)y * width;
+
+			for (uint32_t x = 0; x < width; ++x) {
+				const glm::dvec2 point = toPlane((double)x + 0.5 - half.x, (double)y + 0.5 - half.y);
+				const int64_t sampleX = (int64_t)std::floor(point.x / sampleSpacing);
+				const int64_t sampleY = (int64_t)std::floor(point.y / sampleSpacing);
+
+				const int64_t column = std::clamp<int64_t>((sampleX >> shift) - firstX, 0, (int64_t)columns - 1);
+				const int64_t tileRow = std::clamp<int64_t>((sampleY >> shift) - firstY, 0, (int64_t)rows - 1);
+				const OrbitResult* tile = m_CachedTiles[(size_t)tileRow * columns + column];
+
+				row[x] = tile[(size_t)(sampleY & (size - 1)) * size + (size_t)(sampleX & (size - 1))];
+			}
+		}
+	});
+
+	// The figures of the tiles rendered for the frame, with the escape statistics of the whole view
+	m_Statistics.Iterations = totalIterations.load();
+	m_Statistics.RejectedPixels = totalRejected.load();
+	m_Statistics.SkippedPixels = totalSkipped.load();
+	m_Statistics.Rebases = 0;
+	m_Statistics.CachedTiles = cachedTiles;
+	m_Statistics.RenderedTiles = missingCount;
+
+	m_TileEscapes.clear();
+	ReportIteration(params, {}, elapsed.count());
+	GatherEscapes(params);
+
+	return true;
+}
+
+void CPURenderer::ShiftOrbits(const glm::ivec2& offset) {
+	const uint32_t width = m_Width;
+	const uint32_t height = m_Height;
+
+	// The pixels of the previous frame still on screen, in the new frame
+	const uint32_t x0 = (uint32_t)std::max(-offset.x, 0);
+	const uint32_t x1 = (uint32_t)std::min((int)width - offset.x, (int)width);
+	const uint32_t y0 = (uint32_t)std::max(-offset.y, 0);
+	const uint32_t y1 = (uint32_t)std::min((int)height - offset.y, (int)height);
+
+	// The rows are copied from the other buffer, so they are independent of each other
+	std::swap(m_Orbits, m_PreviousOrbits);
+
+	const uint32_t bands = (y1 - y0 + TileSize - 1) / TileSize;
+
+	m_ThreadPool->ParallelFor(bands, [&](uint32_t band) {
+		const uint32_t first = y0 + band * TileSize;
+		const uint32_t last = std::min(first + TileSize, y1);
+
+		for (uint32_t y = first; y < last; ++y) {
+			const OrbitResult* source = m_PreviousOrbits.data() + (size_t)(y + offset.y) * width + (x0 + offset.x);
+			std::copy_n(source, x1 - x0, m_Orbits.data() + (size_t)y * width + x0);
+		}
+	});
+}
+
+std::vector<ImageRegion> CPURenderer::GetExposedRegions(const glm::ivec2& offset) const {
+	const uint32_t width = m_Width;
+	const uint32_t height = m_Height;
+
+	std::vector<ImageRegion> regions;
+
+	// The rows scrolled in span the whole width, and the columns scrolled in the rows left
+	uint32_t y0 = 0, y1 = height;
+	if (offset.y > 0) {
+		y1 = height - (uint32_t)offset.y;
+		regions.push_back({ 0, y1, width, height });
+	} else if (offset.y < 0) {
+		y0 = (uint32_t)-offset.y;
+		regions.push_back({ 0, 0, width, y0 });
+	}
+
+	if (offset.x > 0) {
+		regions.push_back({ width - (uint32_t)offset.x, y0, width, y1 });
+	} else if (offset.x < 0) {
+		regions.push_back({ 0, y0, (uint32_t)-offset.x, y1 });
+	}
+
+	return regions;
+}
+
+void CPURenderer::ReprojectOrbits(const Mandelbrot& from, const Mandelbrot& to) {
+	const uint32_t width = m_Width;
+	const uint32_t height = m_Height;
+
+	std::swap(m_Orbits, m_PreviousOrbits);
+
+	// The rotations are rounded to float like the kernels do
+	const float fromRotation = glm::radians(from.Rotation);
+	const float toRotation = glm::radians(to.Rotation);
+	const double fromCos = (double)std::cos(fromRotation), fromSin = (double)std::sin(fromRotation);
+	const double toCos = (double)std::cos(toRotation), toSin = (double)std::sin(toRotation);
+	const double fromSpacing = from.GetPixelSpacing(height);
+	const double toSpacing = to.GetPixelSpacing(height);
+
+	// The offset between the centers is small next to the positions, so it is taken before leaving extended precision
+	const glm::dvec2 center(to.Position - from.Position);
+	const glm::dvec2 half((double)width * 0.5, (double)height * 0.5);
+
+	std::fill(m_TileStates.begin(), m_TileStates.end(), TileState::Resampled);
+	m_PendingTiles = (uint32_t)m_TileStates.size();
+
+	// Every band is one row of tiles, so each thread only marks its own tiles
+	m_ThreadPool->ParallelFor(m_TilesY, [&](uint32_t band) {
+		const uint32_t first = band * TileSize;
+		const uint32_t last = std::min(first + TileSize, height);
+
+		for (uint32_t y = first; y < last; ++y) {
+			OrbitResult* row = m_Orbits.data() + (size_t)y * width;
+
+			for (uint32_t x = 0; x < width; ++x) {
+				// The offset of the pixel center from the view center, in the plane, then in pixels of the previous frame
+				const glm::dvec2 pixel((double)x + 0.5 - half.x, (double)y + 0.5 - half.y);
+				const glm::dvec2 plane = center + glm::dvec2(toCos * pixel.x + toSin * pixel.y, -toSin * pixel.x + toCos * pixel.y) * toSpacing;
+				const glm::dvec2 source = glm::dvec2(fromCos * plane.x - fromSin * plane.y, fromSin * plane.x + fromCos * plane.y) / fromSpacing + half;
+
+				int sourceX = (int)std::floor(source.x);
+				int sourceY = (int)std::floor(source.y);
+
+				// Zooming out exposes pixels the previous frame did not cover, so their tiles are refined first
+				if (sourceX < 0 || sourceY < 0 || sourceX >= (int)width || sourceY >= (int)height) {
+					m_TileStates[(size_t)band * m_TilesX + x / TileSize] = TileState::Exposed;
+
+					sourceX = std::clamp(sourceX, 0, (int)width - 1);
+					sourceY = std::clamp(sourceY, 0, (int)height - 1);
+				}
+
+				row[x] = m_PreviousOrbits[(size_t)sourceY * width + sourceX];
+			}
+		}
+	});
+}
+
+void CPURenderer::Refine(const Mandelbrot& mandelbrot, const KernelParameters& params, const CPURenderingSettings& settings, std::chrono::steady_clock::time_point deadline) {
+	// The pending tiles, the exposed ones first, then from the center outwards
+	std::vector<uint32_t> pending;
+	pending.reserve(m_PendingTiles);
+
+	for (uint32_t i = 0; i < (uint32_t)m_TileStates.size(); ++i) {
+		if (m_TileStates[i] != TileState::Refined) {
+			pending.push_back(i);
+		}
+	}
+
+	const auto distance = [&](uint32_t tile) {
+		const int64_t dx = 2 * (int64_t)(tile % m_TilesX) + 1 - (int64_t)m_TilesX;
+		const int64_t dy = 2 * (int64_t)(tile / m_TilesX) + 1 - (int64_t)m_TilesY;
+		return dx * dx + dy * dy;
+	};
+
+	std::sort(pending.begin(), pending.end(), [&](uint32_t a, uint32_t b) {
+		const bool exposedA = m_TileStates[a] == TileState::Exposed;
+		const bool exposedB = m_TileStates[b] == TileState::Exposed;
+
+		if (exposedA != exposedB) {
+			return exposedA;
+		}
+
+		return distance(a) < distance(b);
+	});
+
+	// The tiles are those of a full render, so a refined tile is identical to it
+	std::vector<ImageRegion> regions;
+	regions.reserve(pending.size());
+
+	for (uint32_t tile : pending) {
+		const uint32_t x = (tile % m_TilesX) * TileSize;
+		const uint32_t y = (tile / m_TilesX) * TileSize;
+		regions.push_back({ x, y, std::min(x + TileSize, m_Width), std::min(y + TileSize, m_Height) });
+	}
+
+	Iterate(mandelbrot, params, settings, regions, deadline);
+
+	for (size_t i = 0; i < pending.size(); ++i) {
+		if (m_TileIterated[i]) {
+			m_TileStates[pending[i]] = TileState::Refined;
+			--m_PendingTiles;
+		}
+	}
+}
+
+void CPURenderer::Progress(const Mandelbrot& mandelbrot, const KernelParameters& params, const CPURenderingSettings& settings, std::chrono::steady_clock::time_point deadline) {
+	const auto start = std::chrono::steady_clock::now();
+
+	const uint32_t width = m_Width;
+	const uint32_t threadCount = m_ThreadPool->GetThreadCount();
+	const SeriesApproximation series = PrepareIteration(mandelbrot, params, settings);
+
+	const auto distance = [&](uint32_t tile) {
+		const int64_t dx = 2 * (int64_t)(tile % m_TilesX) + 1 - (int64_t)m_TilesX;
+		const int64_t dy = 2 * (int64_t)(tile / m_TilesX) + 1 - (int64_t)m_TilesY;
+		return dx * dx + dy * dy;
+	};
+
+	std::atomic<uint64_t> totalIterations = 0;
+	std::atomic<uint64_t> totalRebases = 0;
+	std::atomic<uint64_t> totalRejected = 0;
+
+	EscapeStatistics escapes{ params.MaxIterations };
+	std::vector<uint32_t> pending;
+
+	// Every round runs the next pass of each pending tile, the least advanced ones first, then from the center outwards
+	bool finishedRound = true;
+	for (uint32_t round = 0; m_PendingTiles > 0 && finishedRound; ++round) {
+		pending.clear();
+		for (uint32_t i = 0; i < (uint32_t)m_TileStates.size(); ++i) {
+			if (m_TileStates[i] == TileState::Progressive) {
+				pending.push_back(i);
+			}
+		}
+
+		std::sort(pending.begin(), pending.end(), [&](uint32_t a, uint32_t b) {
+			if (m_TilePasses[a] != m_TilePasses[b]) {
+				return m_TilePasses[a] < m_TilePasses[b];
+			}
+
+			return distance(a) < distance(b);
+		});
+
+		// The first pass is the preview of the view, so it always covers the whole frame. Past it, every frame runs at least part of a round.
+		const bool preview = m_TilePasses[pending.front()] == 0;
+		if (!preview && round > 0 && std::chrono::steady_clock::now() >= deadline) {
+			break;
+		}
+
+		const uint32_t tileCount = (uint32_t)pending.size();
+
+		m_TileEscapes.assign(tileCount, EscapeStatistics{ params.MaxIterations });
+		m_TileIterated.assign(tileCount, 0);
+
+		m_ThreadPool->ParallelFor(tileCount, [&](uint32_t unit) {
+			if (!preview && unit >= threadCount && std::chrono::steady_clock::now() >= deadline) {
+				return;
+			}
+
+			m_TileIterated[unit] = 1;
+
+			ScopedFlushDenormals flushDenormals;
+
+			const uint32_t tile = pending[unit];
+			const uint32_t pass = m_TilePasses[tile];
+			const uint32_t x0 = (tile % m_TilesX) * TileSize;
+			const uint32_t y0 = (tile / m_TilesX) * TileSize;
+			const uint32_t x1 = std::min(x0 + TileSize, m_Width);
+			const uint32_t y1 = std::min(y0 + TileSize, m_Height);
+
+			// Each worker keeps its sample buffers across tiles and frames
+			thread_local std::vector<glm::uvec2> samples;
+			thread_local std::vector<OrbitResult> results;
+
+			samples.clear();
+			for (uint32_t y = y0; y < y1; ++y) {
+				for (uint32_t x = x0; x < x1; ++x) {
+					if (ProgressiveOrder[y & 3][x & 3] == pass) {
+						samples.emplace_back(x, y);
+					}
+				}
+			}
+
+			results.resize(samples.size());
+			const uint64_t tileRebases = IteratePixels(params, series, samples.data(), (uint32_t)samples.size(), results.data());
+
+			uint64_t tileIterations = 0;
+			uint64_t tileRejected = 0;
+			EscapeStatistics& tileEscapes = m_TileEscapes[unit];
+
+			for (size_t i = 0; i < samples.size(); ++i) {
+				const OrbitResult& orbit = results[i];
+				m_Orbits[(size_t)samples[i].y * width + samples[i].x] = orbit;
+
+				tileIterations += (uint64_t)orbit.ExecutedIterations;
+				tileEscapes.Add(orbit.Iterations, orbit.ProvenInterior);
+
+				if (params.RejectInterior && orbit.ExecutedIterations == 0 && orbit.Iterations >= params.MaxIterations) {
+					++tileRejected;
+				}
+			}
+
+			// Until the tile is done, the pixels left show the closest pixel iterated before them: of every 2x2 block once the first four passes are done, of every 4x4 block before
+			const uint32_t passes = pass + 1;
+			if (passes < ProgressivePasses) {
+				const uint32_t mask = passes >= 4 ? ~1u : ~3u;
+
+				for (uint32_t y = y0; y < y1; ++y) {
+					for (uint32_t x = x0; x < x1; ++x) {
+						if (ProgressiveOrder[y & 3][x & 3] >= passes) {
+							m_Orbits[(size_t)y * width + x] = m_Orbits[(size_t)(y & mask) * width + (x & mask)];
+						}
+					}
+				}
+			}
+
+			totalIterations.fetch_add(tileIterations, std::memory_order_relaxed);
+			totalRebases.fetch_add(tileRebases, std::memory_order_relaxed);
+			totalRejected.fetch_add(tileRejected, std::memory_order_relaxed);
+		});
+
+		for (uint32_t unit = 0; unit < tileCount; ++unit) {
+			if (!m_TileIterated[unit]) {
+				finishedRound = false;
+				continue;
+			}
+
+			escapes.Merge(m_TileEscapes[unit]);
+
+			const uint32_t tile = pending[unit];
+			if (++m_TilePasses[tile] == ProgressivePasses) {
+				m_TileStates[tile] = TileState::Refined;
+				--m_PendingTiles;
+			}
+		}
+	}
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	m_Statistics.Iterations = totalIterations.load();
+	m_Statistics.RejectedPixels = totalRejected.load();
+	m_Statistics.SkippedPixels = 0;
+	m_Statistics.Rebases = totalRebases.load();
+
+	// The statistics of the samples iterated by the frame stand for the whole view
+	m_TileEscapes.assign(1, escapes);
+	ReportIteration(params, series, elapsed.count());
+}
+
+void CPURenderer::GatherEscapes(const KernelParameters& params) {
+	const uint32_t width = m_Width;
+	const uint32_t height = m_Height;
+	const uint32_t bands = (height + TileSize - 1) / TileSize;
+
+	m_TileEscapes.assign(bands, EscapeStatistics{ params.MaxIterations });
+
+	m_ThreadPool->ParallelFor(bands, [&](uint32_t band) {
+		const size_t first = (size_t)band * TileSize * width;
+		const size_t last = (size_t)std::min((band + 1) * TileSize, height) * width;
+
+		for (size_t i = first; i < last; ++i) {
+			m_TileEscapes[band].Add(m_Orbits[i].Iterations, m_Orbits[i].ProvenInterior);
+		}
+	});
+
+	m_Statistics.Escapes = EscapeStatistics{ params.MaxIterations };
+	for (const EscapeStatistics& bandEscapes : m_TileEscapes) {
+		m_Statistics.Escapes.Merge(bandEscapes);
+	}
+}
+
+void CPURenderer::Shade(const KernelParameters& params) {
+	const uint32_t width = m_Width;
+	const uint32_t height = m_Height;
+
+	// Rows are shaded independently, in bands large enough to amortize the scheduling
+	const uint32_t bands = (height + TileSize - 1) / TileSize;
+
+	m_ThreadPool->ParallelFor(bands, [&](uint32_t band) {
+		const uint32_t y0 = band * TileSize;
+		const uint32_t y1 = std::min(y0 + TileSize, height);
+
+		for (uint32_t y = y0; y < y1; ++y) {
+			const OrbitResult* orbits = m_Orbits.data() + (size_t)y * width;
+			uint8_t* row = m_Pixels.data() + (size_t)y * width * 4;
+
+			for (uint32_t x = 0; x < width; ++x) {
+				const glm::vec3 color = FractalKernel::Shade(params, orbits[x]);
+
+				uint8_t* pixel = row + (size_t)x * 4;
+				pixel[0] = ToUNorm8(color.x);
+				pixel[1] = ToUNorm8(color.y);
+				pixel[2] = ToUNorm8(color.z);
+				pixel[3] = 255;
+			}
+		}
+	});
+}
+
+void CPURenderer::Supersample(const Mandelbrot& mandelbrot, const KernelParameters& params, const CPURenderingSettings& settings, const SupersamplingSettings& supersampling) {
+	const auto start = std::chrono::steady_clock::now();
+
+	const uint32_t width = m_Width;
+	const uint32_t height = m_Height;
+	const uint32_t bands = (height + TileSize - 1) / TileSize;
+
+	const float colorThreshold = supersampling.ColorThreshold * 255.0f;
+	const int iterationThreshold = supersampling.IterationThreshold;
+
+	// The distance estimate is only available when the kernels tracked the derivative
+	const bool useDistance = params.NeedsDerivative;
+	const double pixelSpacing = mandelbrot.GetPixelSpacing(height);
+
+	// Whether a pixel and its neighbour differ enough for the edge between them to alias
+	const auto differs = [&](size_t pixel, size_t neighbour) {
+		const OrbitResult& a = m_Orbits[pixel];
+		const OrbitResult& b = m_Orbits[neighbour];
+
+		if ((a.Iterations >= params.MaxIterations) != (b.Iterations >= params.MaxIterations) || std::abs(a.Iterations - b.Iterations) > iterationThreshold) {
+			return true;
+		}
+
+		const uint8_t* colorA = m_Pixels.data() + pixel * 4;
+		const uint8_t* colorB = m_Pixels.data() + neighbour * 4;
+
+		for (int channel = 0; channel < 3; ++channel) {
+			if (std::abs((float)colorA[channel] - (float)colorB[channel]) > colorThreshold) {
+				return true;
+			}
+		}
+
+		return false;
+	};
+
+	// Same distance as the distance estimation coloring, for the exterior pixels closer to the boundary than a pixel
+	const auto nearBoundary = [&](const OrbitResult& orbit) {
+		if (!useDistance || orbit.Iterations >= params.MaxIterations) {
+			return false;
+		}
+
+		const float zSquared = glm::dot(orbit.Z, orbit.Z);
+		const float dzSquared = glm::dot(orbit.Derivative, orbit.Derivative);
+
+		if (dzSquared < 1e-20f || zSquared < 1e-20f || !std::isfinite(dzSquared)) {
+			return false;
+		}
+
+		const double distance = std::sqrt(zSquared / dzSquared) * std::log(zSquared) * 0.5;
+		return distance < pixelSpacing;
+	};
+
+	m_SampleMask.resize((size_t)width * height);
+
+	m_ThreadPool->ParallelFor(bands, [&](uint32_t band) {
+		const uint32_t y0 = band * TileSize;
+		const uint32_t y1 = std::min(y0 + TileSize, height);
+
+		for (uint32_t y = y0; y < y1; ++y) {
+			for (uint32_t x = 0; x < width; ++x) {
+				const size_t i = (size_t)y * width + x;
+
+				const bool flagged = (x > 0 && differs(i, i - 1))
+					|| (x + 1 < width && differs(i, i + 1))
+					|| (y > 0 && differs(i, i - width))
+					|| (y + 1 < height && differs(i, i + width))
+					|| nearBoundary(m_Orbits[i]);
+
+				m_SampleMask[i] = flagged ? 1 : 0;
+			}
+		}
+	});
+
+	m_SamplePixels.clear();
+	for (uint32_t y = 0; y < height; ++y) {
+		for (uint32_t x = 0; x < width; ++x) {
+			if (m_SampleMask[(size_t)y * width + x]) {
+				m_SamplePixels.push_back({ x, y });
+			}
+		}
+	}
+
+	const uint32_t pixelCount = (uint32_t)m_SamplePixels.size();
+
+	if (pixelCount > 0) {
+		const SeriesApproximation series = PrepareIteration(mandelbrot, params, settings);
+
+		// Every extra sample is iterated with the kernel parameters of the frame, moved by its offset within the pixel
+		const int grid = Supersampling::GetGrid(supersampling);
+		const int sampleCount = Supersampling::GetSampleCount(supersampling);
+
+		std::vector<KernelParameters> sampleParams(sampleCount, params);
+		for (int sample = 0; sample < sampleCount; ++sample) {
+			sampleParams[sample].SampleOffset = Supersampling::GetSampleOffset(grid, sample);
+		}
+
+		const float scale = 1.0f / (float)(sampleCount + 1);
+		const uint32_t chunks = (pixelCount + SampleChunkSize - 1) / SampleChunkSize;
+
+		m_ThreadPool->ParallelFor(chunks, [&](uint32_t chunk) {
+			ScopedFlushDenormals flushDenormals;
+
+			const uint32_t first = chunk * SampleChunkSize;
+			const uint32_t count = std::min(first + SampleChunkSize, pixelCount) - first;
+			const glm::uvec2* pixels = m_SamplePixels.data() + first;
+
+			// The colors are summed from the shading of the pixel itself, before it was rounded to 8 bits
+			OrbitResult results[SampleChunkSize];
+			glm::vec3 colors[SampleChunkSize];
+
+			for (uint32_t i = 0; i < count; ++i) {
+				colors[i] = FractalKernel::Shade(params, m_Orbits[(size_t)pixels[i].y * width + pixels[i].x]);
+			}
+
+			for (int sample = 0; sample < sampleCount; ++sample) {
+				IteratePixels(sampleParams[sample], series, pixels, count, results);
+
+				for (uint32_t i = 0; i < count; ++i) {
+					colors[i] += FractalKernel::Shade(params, results[i]);
+				}
+			}
+
+			for (uint32_t i = 0; i < count; ++i) {
+				const glm::vec3 color = colors[i] * scale;
+
+				uint8_t* pixel = m_Pixels.data() + ((size_t)pixels[i].y * width + pixels[i].x) * 4;
+				pixel[0] = ToUNorm8(color.x);
+				pixel[1] = ToUNorm8(color.y);
+				pixel[2] = ToUNorm8(color.z);
+			}
+		});
+	}
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	m_Statistics.SupersampledPixels = pixelCount;
+	m_Statistics.SupersamplingTime = elapsed.count() * 1000.0;
+}
+
+void CPURenderer::BuildHistogram(const KernelParameters& params) {
+	const uint32_t width = m_Width;
+	const uint32_t height = m_Height;
+	const uint32_t bins = (uint32_t)params.HistogramBins;
+	const uint32_t bands = (height + TileSize - 1) / TileSize;
+
+	// Each band of rows counts its pixels into its own histogram, so the threads share no counter
+	m_BandHistograms.assign((size_t)bands * bins, 0);
+
+	m_ThreadPool->ParallelFor(bands, [&](uint32_t band) {
+		uint32_t* histogram = m_BandHistograms.data() + (size_t)band * bins;
+
+		const size_t first = (size_t)band * TileSize * width;
+		const size_t last = (size_t)std::min((band + 1) * TileSize, height) * width;
+
+		for (size_t i = first; i < last; ++i) {
+			const int iterations = m_Orbits[i].Iterations;
+
+			if (iterations < params.MaxIterations) {
+				++histogram[FractalKernel::GetHistogramBin(params, iterations)];
+			}
+		}
+	});
+
+	// The prefix sum runs over chunks of bins in two passes: each chunk merges the bands and scans its own bins, then adds the total of the chunks before it
+	const uint32_t chunks = (bins + HistogramChunkSize - 1) / HistogramChunkSize;
+
+	m_HistogramCounts.resize(bins);
+	m_HistogramChunkOffsets.resize(chunks);
+
+	m_ThreadPool->ParallelFor(chunks, [&](uint32_t chunk) {
+		const uint32_t first = chunk * HistogramChunkSize;
+		const uint32_t last = std::min(first + HistogramChunkSize, bins);
+
+		uint64_t sum = 0;
+		for (uint32_t bin = first; bin < last; ++bin) {
+			m_HistogramCounts[bin] = sum;
+
+			for (uint32_t band = 0; band < bands; ++band) {
+				sum += m_BandHistograms[(size_t)band * bins + bin];
+			}
+		}
+
+		m_HistogramChunkOffsets[chunk] = sum;
+	});
+
+	uint64_t total = 0;
+	for (uint64_t& offset : m_HistogramChunkOffsets) {
+		const uint64_t chunkTotal = offset;
+		offset = total;
+		total += chunkTotal;
+	}
+
+	const double scale = total > 0 ? 1.0 / (double)total : 0.0;
+	m_HistogramCDF.resize(bins + 1);
+
+	m_ThreadPool->ParallelFor(chunks, [&](uint32_t chunk) {
+		const uint32_t first = chunk * HistogramChunkSize;
+		const uint32_t last = std::min(first + HistogramChunkSize, bins);
+
+		for (uint32_t bin = first; bin < last; ++bin) {
+			m_HistogramCDF[bin] = (float)((double)(m_HistogramChunkOffsets[chunk] + m_HistogramCounts[bin]) * scale);
+		}
+	});
+
+	m_HistogramCDF[bins] = total > 0 ? 1.0f : 0.0f;
+}
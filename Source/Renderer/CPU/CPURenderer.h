@@ -0,0 +1,342 @@
+#pragma once
+
+#include "Core/Core.h"
+#include "Core/ThreadPool.h"
+#include "Core/Settings/Settings.h"
+
+#include "Layers/Mandelbrot/Mandelbrot.h"
+
+#include "Renderer/IterationBudget.h"
+#include "Renderer/CPU/FractalKernel.h"
+#include "Renderer/CPU/ReferenceOrbit.h"
+#include "Renderer/CPU/TileCache.h"
+#include "Renderer/CPU/TileStore.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+/**
+ * Performance figures of the last frame rendered by the CPU engine.
+ */
+struct CPURenderStatistics {
+	/// @brief The instruction set the kernels ran with.
+	InstructionSet SIMD = InstructionSet::Scalar;
+
+	/// @brief Whether the SIMD kernels were used, or the frame fell back to the scalar kernel.
+	bool UsedSIMD = false;
+
+	/// @brief The number of threads the frame was split across.
+	uint32_t ThreadCount = 0;
+
+	/// @brief The number of escape-time iterations computed for the frame.
+	uint64_t Iterations = 0;
+
+	/// @brief The number of pixels found inside the main cardioid or the period-2 bulb, which were not iterated at all.
+	uint64_t RejectedPixels = 0;
+
+	/// @brief The number of pixels filled by area skipping without being iterated (see `AreaSkippingMode`).
+	uint64_t SkippedPixels = 0;
+
+	/// @brief How the pixels of the frame escaped, which drives the automatic iteration budget (see `IterationBudget`).
+	EscapeStatistics Escapes;
+
+	/// @brief Whether the frame only recolored the orbits of a previous frame, its iteration figures being those of that frame.
+	bool ReusedOrbits = false;
+
+	/// @brief The number of pixels shifted from the previous frame while panning, only the rest of the frame being iterated.
+	uint64_t PannedPixels = 0;
+
+	/// @brief The number of tiles still showing a preview: resampled orbits (see `CPURenderingSettings::ZoomReprojection`), or pixels not iterated yet (see `CPURenderingSettings::Progressive`).
+	uint32_t PendingTiles = 0;
+
+	/// @brief The number of tiles of the tile cache the frame was sampled from, and how many of them were missing and had to be rendered (see `CPURenderingSettings::TileCache`).
+	uint32_t CachedTiles = 0;
+	uint32_t RenderedTiles = 0;
+
+	/// @brief The memory taken by the tile cache, in bytes.
+	size_t TileCacheSize = 0;
+
+	/// @brief The number of tiles of the frame read from the tile store instead of being iterated (see `CPURenderingSettings::TileStore`), and the number of tiles it holds.
+	uint32_t LoadedTiles = 0;
+	uint32_t StoredTiles = 0;
+
+	/// @brief The number of pixels that got extra samples (see `SupersamplingSettings`), and the time spent finding, iterating and shading them, in milliseconds.
+	uint64_t SupersampledPixels = 0;
+	double SupersamplingTime = 0.0;
+
+	/// @brief The wall-clock time of the frame, in milliseconds.
+	double FrameTime = 0.0;
+
+	/// @brief The wall-clock time spent iterating the orbits, in milliseconds.
+	double IterationTime = 0.0;
+
+	/// @brief The iteration throughput of the frame, in billions of iterations per second.
+	double GigaIterationsPerSecond = 0.0;
+
+	/// @brief Whether the frame was rendered with perturbation.
+	bool Perturbation = false;
+
+	/// @brief The length of the reference orbit, in iterations.
+	uint32_t ReferenceIterations = 0;
+
+	/// @brief The number of iterations every pixel skipped thanks to the series approximation.
+	int SkippedIterations = 0;
+
+	/// @brief The number of times pixels were rebased onto the start of the reference orbit.
+	uint64_t Rebases = 0;
+};
+
+/**
+ * A rectangle of the image, in pixels. The last column and row (`X1` and `Y1`) are excluded.
+ */
+struct ImageRegion {
+	uint32_t X0 = 0, Y0 = 0;
+	uint32_t X1 = 0, Y1 = 0;
+};
+
+/**
+ * Renders the fractal on the CPU, splitting the image into square tiles that are processed in parallel by a thread pool.
+ *
+ * The output is an RGBA8 image whose rows are stored bottom-up, matching the layout OpenGL expects when uploading it to a texture.
+ * Views deeper than double precision can resolve are rendered with perturbation (see `PerturbationKernel`) when the settings allow it.
+ */
+class CPURenderer {
+public:
+	/// @brief The size, in pixels, of the square tiles the image is split into.
+	static constexpr uint32_t TileSize = 64;
+
+	/**
+	 * Constructs the CPU renderer and spawns its worker threads.
+	 *
+	 * @param threadCount The number of threads to render with. A value of `0` uses every hardware thread of the machine.
+	 */
+	CPURenderer(uint32_t threadCount = 0);
+
+	/**
+	 * Renders the fractal into the internal pixel buffer, resizing it if needed.
+	 *
+	 * @param mandelbrot The fractal to render.
+	 * @param width The width of the image in pixels.
+	 * @param height The height of the image in pixels.
+	 * @param settings The settings of the CPU engine. The requested SIMD instruction set is resolved against the processor features once, when it changes.
+	 * @param frameBudget The time in milliseconds the frame may spend iterating a view rendered over several frames (see `RenderingSettings::FrameBudget`). With `0`, such views are finished in a single frame.
+	 * @param supersampling The settings of adaptive supersampling, which only runs once the image is final, and once its coloring stopped changing.
+	 * @param settled Whether the view stopped moving. The full renders of views still moving (every frame of an animation) are not written to the tile store, as they are never seen again.
+	 */
+	void Render(const Mandelbrot& mandelbrot, uint32_t width, uint32_t height, const CPURenderingSettings& settings = {}, float frameBudget = 0.0f, const SupersamplingSettings& supersampling = {}, bool settled = true);
+
+	/**
+	 * Gets the RGBA8 pixels of the last rendered image.
+	 *
+	 * @return The pixel buffer, `width * height * 4` bytes long.
+	 */
+	const std::vector<uint8_t>& GetPixels() const { return m_Pixels; }
+
+	/**
+	 * Gets the orbits of the last rendered image, in the same bottom-up order as its pixels.
+	 */
+	const std::vector<OrbitResult>& GetOrbits() const { return m_Orbits; }
+
+	uint32_t GetWidth() const { return m_Width; }
+	uint32_t GetHeight() const { return m_Height; }
+
+	uint32_t GetThreadCount() const { return m_ThreadPool->GetThreadCount(); }
+
+	const CPURenderStatistics& GetStatistics() const { return m_Statistics; }
+
+	/**
+	 * Checks whether the last image is final: neither snapped to the pixel grid of a panned view, nor waiting for the following frames to refine or supersample it.
+	 */
+	bool IsComplete() const { return m_PendingTiles == 0 && m_OrbitFractal.Position == m_RequestedPosition && !m_SupersamplingDeferred; }
+
+	/**
+	 * Forgets the orbits of the last frame and the reference orbit, so the next frame iterates every pixel however close its view is to the last one.
+	 *
+	 * The tile cache and the tile store are kept, as they follow their own settings.
+	 */
+	void Invalidate();
+private:
+	/**
+	 * Iterates the pixels of the given regions of the image into the orbit buffer, and gathers their iteration statistics.
+	 *
+	 * The regions are split into tiles, iterated in order. Once `deadline` has passed, the tiles not started yet are skipped, though every thread iterates at least one;
+	 * `m_TileIterated` tells which tiles of `m_Tiles` were iterated.
+	 */
+	void Iterate(const Mandelbrot& mandelbrot, const KernelParameters& params, const CPURenderingSettings& settings, const std::vector<ImageRegion>& regions,
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+
+	/**
+	 * Updates the reference orbit of a perturbation frame and evaluates its series approximation.
+	 */
+	SeriesApproximation PrepareIteration(const Mandelbrot& mandelbrot, const KernelParameters& params, const CPURenderingSettings& settings);
+
+	/**
+	 * Iterates a list of pixels with the kernel of the frame.
+	 *
+	 * @return The number of perturbation rebases.
+	 */
+	uint64_t IteratePixels(const KernelParameters& params, const SeriesApproximation& series, const glm::uvec2* pixels, uint32_t count, OrbitResult* results) const;
+
+	/**
+	 * Fills the figures of the iteration statistics shared by every way of iterating, the escape statistics being merged from `m_TileEscapes`.
+	 */
+	void ReportIteration(const KernelParameters& params, const SeriesApproximation& series, double seconds);
+
+	/**
+	 * Runs the next passes of progressive rendering (see `CPURenderingSettings::Progressive`) until `deadline`, the first pass of every tile excepted.
+	 * The pixels not iterated yet show the closest pixel iterated before them.
+	 */
+	void Progress(const Mandelbrot& mandelbrot, const KernelParameters& params, const CPURenderingSettings& settings, std::chrono::steady_clock::time_point deadline);
+
+	/**
+	 * Iterates the whole frame, reading the tiles the tile store holds instead (see `CPURenderingSettings::TileStore`) and storing the others once iterated, if the view is settled.
+	 */
+	void IterateFrame(const Mandelbrot& mandelbrot, const KernelParameters& params, const CPURenderingSettings& settings);
+
+	/**
+	 * Opens, reopens or closes the tile store to follow the settings.
+	 */
+	void UpdateTileStore(const CPURenderingSettings& settings);
+
+	/**
+	 * Samples the orbit buffer from the tiles of the tile cache covering the view (see `CPURenderingSettings::TileCache`), every pixel taking the orbit of the nearest sample.
+	 * The tiles missing from the cache are rendered first.
+	 *
+	 * @return `false` if the tiles of the view do not fit in the capacity of the cache, in which case nothing is rendered and the view is to be rendered directly.
+	 */
+	bool RenderCached(const Mandelbrot& mandelbrot, const KernelParameters& params, const CPURenderingSettings& settings);
+
+	/**
+	 * Resamples the orbit buffer of the view `from` to the view `to`, every pixel taking the orbit of the nearest pixel of the previous frame, and marks every tile as pending.
+	 */
+	void ReprojectOrbits(const Mandelbrot& from, const Mandelbrot& to);
+
+	/**
+	 * Iterates the pending tiles of a reprojected view until `deadline`: the tiles the previous frame did not cover first, then from the center outwards.
+	 */
+	void Refine(const Mandelbrot& mandelbrot, const KernelParameters& params, const CPURenderingSettings& settings, std::chrono::steady_clock::time_point deadline);
+
+	/**
+	 * Shifts the orbit buffer for a panned view (see `Mandelbrot::SnapToPixelGrid`), the pixel (x, y) taking the orbit of the pixel (x, y) + `offset`.
+	 */
+	void ShiftOrbits(const glm::ivec2& offset);
+
+	/**
+	 * Gets the regions of the image a shift by `offset` leaves without orbits.
+	 */
+	std::vector<ImageRegion> GetExposedRegions(const glm::ivec2& offset) const;
+
+	/**
+	 * Gathers the escape statistics of the whole orbit buffer, after only part of it was iterated.
+	 */
+	void GatherEscapes(const KernelParameters& params);
+
+	/**
+	 * Builds the cumulative iteration histogram of the orbit buffer, for `ColorAlgorithm::Histogram`.
+	 */
+	void BuildHistogram(const KernelParameters& params);
+
+	/**
+	 * Colors the orbit buffer into the pixel buffer.
+	 */
+	void Shade(const KernelParameters& params);
+
+	/**
+	 * Antialiases the pixel buffer (see `SupersamplingSettings`): flags the pixels that differ from their neighbours or lie near the boundary,
+	 * then iterates and shades their extra samples, every flagged pixel taking the average of its samples.
+	 */
+	void Supersample(const Mandelbrot& mandelbrot, const KernelParameters& params, const CPURenderingSettings& settings, const SupersamplingSettings& supersampling);
+private:
+	/// @brief The thread pool the tiles are distributed across.
+	Scope<ThreadPool> m_ThreadPool;
+
+	/// @brief The RGBA8 pixels of the last rendered image, stored bottom-up.
+	std::vector<uint8_t> m_Pixels;
+
+	uint32_t m_Width = 0, m_Height = 0;
+
+	/// @brief The orbits of every pixel of the last iterated frame, and what they were iterated with.
+	/// Frames that only change the coloring are shaded from them without iterating again.
+	std::vector<OrbitResult> m_Orbits;
+	Mandelbrot m_OrbitFractal;
+	CPURenderingSettings m_OrbitSettings;
+	bool m_HasOrbits = false;
+
+	/// @brief The fractal of the last frame, and whether its coloring changed from the one before, so its supersampling waits for a frame of the same coloring.
+	Mandelbrot m_ShadedFractal;
+	bool m_SupersamplingDeferred = false;
+
+	/// @brief The orbit buffer of the frame before, which the orbits of a panned view are shifted from, and the position the last frame was requested at.
+	std::vector<OrbitResult> m_PreviousOrbits;
+	BigVec2 m_RequestedPosition;
+
+	/// @brief The tiles the regions of the frame being iterated are split into, and whether each one was iterated before the deadline.
+	std::vector<ImageRegion> m_Tiles;
+	std::vector<uint8_t> m_TileIterated;
+
+	/// @brief Whether each tile of the frame holds the exact orbits of the view, orbits resampled from the previous frame (see `ReprojectOrbits`), or is being rendered progressively.
+	enum class TileState : uint8_t {
+		Refined,
+		Resampled,
+
+		/// @brief Resampled, with pixels the previous frame did not cover.
+		Exposed,
+
+		/// @brief Only the pixels of its first `m_TilePasses` passes were iterated (see `Progress`).
+		Progressive
+	};
+
+	/// @brief The state of every tile of the frame, in rows of `m_TilesX` tiles, the number of tiles not refined yet, and whether they are rendered progressively.
+	std::vector<TileState> m_TileStates;
+	std::vector<uint8_t> m_TilePasses;
+	uint32_t m_TilesX = 0, m_TilesY = 0;
+	uint32_t m_PendingTiles = 0;
+	bool m_Progressive = false;
+
+	/// @brief The tiles rendered for previous views, and the settings they were rendered with.
+	TileCache m_TileCache;
+	CPURenderingSettings m_CacheSettings;
+
+	/// @brief The tiles of previous sessions, and the file and capacity the store was opened with.
+	TileStore m_TileStore;
+	std::filesystem::path m_TileStorePath;
+	size_t m_TileStoreCapacity = 0;
+
+	/// @brief Whether the view of the frame being rendered stopped moving, so its full render is worth storing.
+	bool m_Settled = true;
+
+	/// @brief The orbits of the tiles of the cache covering the frame (`nullptr` for the tiles outside of it), and the tiles missing from the cache.
+	std::vector<const OrbitResult*> m_CachedTiles;
+	std::vector<TileAddress> m_MissingTiles;
+	std::vector<OrbitResult*> m_MissingOrbits;
+
+	/// @brief The histogram of each band of rows, the exclusive prefix sum of the bins within their chunk and the offset of each chunk,
+	/// and the cumulative histogram of the orbit buffer built from them.
+	std::vector<uint32_t> m_BandHistograms;
+	std::vector<uint64_t> m_HistogramCounts;
+	std::vector<uint64_t> m_HistogramChunkOffsets;
+	std::vector<float> m_HistogramCDF;
+	bool m_HasHistogram = false;
+
+	/// @brief Whether each pixel of the image gets extra samples, and the list of those pixels.
+	std::vector<uint8_t> m_SampleMask;
+	std::vector<glm::uvec2> m_SamplePixels;
+
+	/// @brief The palette of the last frame, baked into a lookup table.
+	PaletteLUT m_PaletteLUT;
+
+	/// @brief The last requested instruction set, and the one it resolved to.
+	InstructionSet m_RequestedSIMD = InstructionSet::Auto;
+	InstructionSet m_ResolvedSIMD = InstructionSet::Scalar;
+
+	/// @brief The reference orbit of the last perturbation frame, kept while the view center does not move.
+	ReferenceOrbit m_ReferenceOrbit;
+
+	/// @brief The performance figures of the last frame.
+	CPURenderStatistics m_Statistics;
+
+	/// @brief The escape statistics of each tile of the last frame.
+	std::vector<EscapeStatistics> m_TileEscapes;
+};
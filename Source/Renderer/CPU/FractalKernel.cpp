@@ -0,0 +1,372 @@
+#include "FractalKernel.h"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+template<typename Real>
+using Complex = glm::vec<2, Real>;
+
+// Complex multiplication
+template<typename Real>
+static Complex<Real> CMul(const Complex<Real>& a, const Complex<Real>& b) {
+	return Complex<Real>(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+// Complex power: z^p
+template<typename Real>
+static Complex<Real> CPow(const Complex<Real>& z, Real p) {
+	Real r = glm::length(z);
+	Real a = std::atan2(z.y, z.x);
+
+	return std::pow(r, p) * Complex<Real>(std::cos(p * a), std::sin(p * a));
+}
+
+// Distance from a point to a line segment
+template<typename Real>
+static Real DistanceToLine(const Complex<Real>& p, const Complex<Real>& a, const Complex<Real>& b) {
+	Complex<Real> pa = p - a, ba = b - a;
+	Real h = glm::clamp(glm::dot(pa, ba) / glm::dot(ba, ba), (Real)0, (Real)1);
+
+	return glm::length(pa - ba * h);
+}
+
+// Distance to a box (Chebyshev distance)
+template<typename Real>
+static Real DistanceToBox(const Complex<Real>& p, const Complex<Real>& center, const Complex<Real>& size) {
+	Complex<Real> d = glm::abs(p - center) - size;
+
+	return glm::length(glm::max(d, (Real)0)) + std::min(std::max(d.x, d.y), (Real)0);
+}
+
+// Distance to a cross
+template<typename Real>
+static Real DistanceToCross(const Complex<Real>& p, const Complex<Real>& center) {
+	Complex<Real> d = glm::abs(p - center);
+
+	return std::min(d.x, d.y);
+}
+
+template<typename Real>
+static float TrapDistance(const OrbitTrap& trap, const Complex<Real>& z) {
+	const Complex<Real> p1(trap.P1), p2(trap.P2);
+
+	switch (trap.Type) {
+		case OrbitTrapType::Point:	return (float)glm::length(z - p1);
+		case OrbitTrapType::Circle:	return (float)std::abs(glm::length(z - p1) - p2.x);
+		case OrbitTrapType::Line:	return (float)DistanceToLine(z, p1, p2);
+		case OrbitTrapType::Box:	return (float)DistanceToBox(z, p1, p2);
+		case OrbitTrapType::Cross:	return (float)DistanceToCross(z, p1);
+		default:					return 1e20f;
+	}
+}
+
+KernelParameters KernelParameters::Create(const Mandelbrot& mandelbrot, uint32_t width, uint32_t height) {
+	KernelParameters params;
+
+	params.Resolution = glm::vec2((float)width, (float)height);
+	params.Zoom = mandelbrot.Zoom;
+	params.Position = glm::dvec2(mandelbrot.Position);
+
+	const float rotation = glm::radians(mandelbrot.Rotation);
+	params.CosRotation = std::cos(rotation);
+	params.SinRotation = std::sin(rotation);
+
+	params.MaxIterations = mandelbrot.MaxIterations;
+	params.Bailout = mandelbrot.Bailout;
+	params.Power = mandelbrot.Power;
+	params.Algorithm = mandelbrot.Algorithm;
+
+	params.JuliaMode = mandelbrot.JuliaMode;
+	params.JuliaC = mandelbrot.JuliaC;
+
+	params.ExteriorColoring = mandelbrot.ExteriorColoring;
+	params.InteriorColoring = mandelbrot.InteriorColoring;
+	params.InteriorColor = mandelbrot.InteriorColor;
+	params.ColorFrequency = mandelbrot.ColorFrequency;
+	params.ColorOffset = mandelbrot.ColorOffset;
+	params.OrbitColoring = mandelbrot.OrbitColoring;
+	params.DistanceScale = mandelbrot.DistanceScale;
+
+	params.Trap = mandelbrot.Trap;
+
+	params.HistogramBins = mandelbrot.GetHistogramBinCount();
+
+	params.NeedsDerivative = mandelbrot.NeedsDerivative();
+	params.IsPow2 = params.Power == 2.0f;
+	params.UseDoublePrecision = mandelbrot.RequiresDoublePrecision(height);
+	params.UsePerturbation = mandelbrot.SupportsPerturbation() && mandelbrot.RequiresPerturbation(height);
+	params.RejectInterior = mandelbrot.SupportsInteriorRejection();
+
+	return params;
+}
+
+template<typename Real>
+glm::vec<2, Real> FractalKernel::MapToComplex(const KernelParameters& params, float fragX, float fragY) {
+	const Complex<Real> resolution(params.Resolution);
+	const Complex<Real> fragCoord = Complex<Real>((Real)(fragX + params.SampleOffset.x), (Real)(fragY + params.SampleOffset.y));
+	Complex<Real> uv = (fragCoord * (Real)2 - resolution) / resolution.y;
+
+	// Same rotation as the shader's column-major `mat2(cosR, -sinR, sinR, cosR) * uv`
+	const Real cosR = (Real)params.CosRotation;
+	const Real sinR = (Real)params.SinRotation;
+	uv = Complex<Real>(cosR * uv.x + sinR * uv.y, -sinR * uv.x + cosR * uv.y);
+
+	// In single precision, the view is rounded to float exactly like the shader uniforms
+	return Complex<Real>(params.Position) + uv / (Real)params.Zoom;
+}
+
+template glm::vec2 FractalKernel::MapToComplex<float>(const KernelParameters&, float, float);
+template glm::dvec2 FractalKernel::MapToComplex<double>(const KernelParameters&, float, float);
+
+glm::dvec2 FractalKernel::MapToOffset(const KernelParameters& params, float fragX, float fragY) {
+	const glm::dvec2 resolution(params.Resolution);
+	const glm::dvec2 fragCoord((double)(fragX + params.SampleOffset.x), (double)(fragY + params.SampleOffset.y));
+	const glm::dvec2 uv = (fragCoord * 2.0 - resolution) / resolution.y;
+
+	const double cosR = (double)params.CosRotation;
+	const double sinR = (double)params.SinRotation;
+
+	return glm::dvec2(cosR * uv.x + sinR * uv.y, -sinR * uv.x + cosR * uv.y) / params.Zoom;
+}
+
+template<typename Real>
+bool FractalKernel::IsInMainCardioidOrBulb(const glm::vec<2, Real>& c) {
+	// Main cardioid: q * (q + (x - 1/4)) <= y^2 / 4, with q = (x - 1/4)^2 + y^2
+	const Real x = c.x - (Real)0.25;
+	const Real y2 = c.y * c.y;
+	const Real q = x * x + y2;
+	if (q * (q + x) <= (Real)0.25 * y2) {
+		return true;
+	}
+
+	// Period-2 bulb: the disk of radius 1/4 centered on -1
+	const Real x1 = c.x + (Real)1;
+	return x1 * x1 + y2 <= (Real)0.0625;
+}
+
+template bool FractalKernel::IsInMainCardioidOrBulb<float>(const glm::vec2&);
+template bool FractalKernel::IsInMainCardioidOrBulb<double>(const glm::dvec2&);
+
+OrbitResult FractalKernel::Iterate(const KernelParameters& params, float fragX, float fragY) {
+	if (params.UseDoublePrecision) {
+		return IterateImpl<double>(params, fragX, fragY);
+	}
+
+	return IterateImpl<float>(params, fragX, fragY);
+}
+
+template<typename Real>
+OrbitResult FractalKernel::IterateImpl(const KernelParameters& params, float fragX, float fragY) {
+	const Complex<Real> point = MapToComplex<Real>(params, fragX, fragY);
+	const Real power = (Real)params.Power;
+
+	Complex<Real> z, c;
+	if (params.JuliaMode) {
+		z = point;
+		c = Complex<Real>(params.JuliaC);
+	} else {
+		z = Complex<Real>((Real)0);
+		c = point;
+	}
+
+	Complex<Real> dz = params.JuliaMode ? Complex<Real>((Real)1, (Real)0) : Complex<Real>((Real)0);
+	float minTrapDist = 1e20f;
+
+	// Pixels inside the main cardioid or the period-2 bulb never escape
+	OrbitResult orbit;
+	if (params.RejectInterior && IsInMainCardioidOrBulb(c)) {
+		orbit.Iterations = params.MaxIterations;
+		orbit.ProvenInterior = true;
+		return orbit;
+	}
+
+	const bool hasTrap = params.Trap.Type != OrbitTrapType::None;
+	const Real bailout = (Real)params.Bailout;
+
+	// Brent's periodicity check (see 'Iteration.frag')
+	Complex<Real> saved = z;
+	int checkpoint = 1;
+	int executed = -1;
+
+	int i;
+	for (i = 0; i < params.MaxIterations; i++) {
+		// The derivative is updated using the current 'z'
+		if (params.NeedsDerivative) {
+			// Avoid singularity at the origin for non-integer powers
+			if (glm::dot(z, z) > (Real)1e-12) {
+				if (params.IsPow2) {
+					dz = (Real)2 * CMul(z, dz);
+				} else {
+					dz = power * CMul(CPow(z, power - (Real)1), dz);
+				}
+			}
+		}
+
+		if (params.Algorithm == FractalAlgorithm::BurningShip) {
+			z = Complex<Real>(std::abs(z.x), std::abs(z.y));
+		} else if (params.Algorithm == FractalAlgorithm::Tricorn) {
+			z = Complex<Real>(z.x, -z.y);
+		}
+
+		// Z Update
+		if (params.IsPow2) {
+			z = Complex<Real>(z.x * z.x - z.y * z.y, (Real)2 * z.x * z.y) + c;
+		} else {
+			z = CPow(z, power) + c;
+		}
+
+		// For Mandelbrot, on the first iteration, dz must be 1
+		if (!params.JuliaMode && i == 0) {
+			dz = Complex<Real>((Real)1, (Real)0);
+		}
+
+		if (hasTrap) {
+			minTrapDist = std::min(minTrapDist, TrapDistance(params.Trap, z));
+		}
+
+		if (glm::dot(z, z) > bailout) {
+			break;
+		}
+
+		if (z == saved) {
+			executed = i + 1;
+			i = params.MaxIterations;
+			break;
+		}
+
+		if (i == checkpoint) {
+			saved = z;
+			checkpoint *= 2;
+		}
+	}
+
+	orbit.Iterations = i;
+	orbit.ExecutedIterations = executed >= 0 ? executed : std::min(i + 1, params.MaxIterations);
+	orbit.ProvenInterior = executed >= 0;
+	orbit.Z = glm::vec2(z);
+	orbit.Derivative = glm::vec2(dz);
+	orbit.MinTrapDistance = minTrapDist;
+
+	return orbit;
+}
+
+bool FractalKernel::SupportsSIMD(const KernelParameters& params) {
+	return params.IsPow2 && params.Trap.Type == OrbitTrapType::None;
+}
+
+void FractalKernel::IterateRow(const KernelParameters& params, InstructionSet instructionSet, uint32_t x, uint32_t y, uint32_t count, OrbitResult* results) {
+	if (SupportsSIMD(params)) {
+		switch (instructionSet) {
+			case InstructionSet::AVX512:	IterateRowAVX512(params, x, y, count, results);	return;
+			case InstructionSet::AVX2:		IterateRowAVX2(params, x, y, count, results);	return;
+			case InstructionSet::SSE2:		IterateRowSSE2(params, x, y, count, results);	return;
+			default:																		break;
+		}
+	}
+
+	const float fragY = (float)y + 0.5f;
+	for (uint32_t i = 0; i < count; ++i) {
+		results[i] = Iterate(params, (float)(x + i) + 0.5f, fragY);
+	}
+}
+
+void FractalKernel::IteratePixels(const KernelParameters& params, InstructionSet instructionSet, const glm::uvec2* pixels, uint32_t count, OrbitResult* results) {
+	if (SupportsSIMD(params)) {
+		switch (instructionSet) {
+			case InstructionSet::AVX512:	IteratePixelsAVX512(params, pixels, count, results);	return;
+			case InstructionSet::AVX2:		IteratePixelsAVX2(params, pixels, count, results);		return;
+			case InstructionSet::SSE2:		IteratePixelsSSE2(params, pixels, count, results);		return;
+			default:																				break;
+		}
+	}
+
+	for (uint32_t i = 0; i < count; ++i) {
+		results[i] = Iterate(params, (float)pixels[i].x + 0.5f, (float)pixels[i].y + 0.5f);
+	}
+}
+
+glm::vec3 FractalKernel::Shade(const KernelParameters& params, const OrbitResult& orbit) {
+	const glm::vec2& z = orbit.Z;
+
+	glm::vec3 finalColor;
+	if (orbit.Iterations >= params.MaxIterations) {
+		switch (params.InteriorColoring) {
+			case InteriorColorAlgorithm::Black:	finalColor = glm::vec3(0.0f); break;
+			case InteriorColorAlgorithm::White:	finalColor = glm::vec3(1.0f); break;
+			default:							finalColor = params.InteriorColor; break;
+		}
+	} else {
+		float t = 0.0f;
+
+		if (params.ExteriorColoring == ColorAlgorithm::Step) {
+			t = (float)orbit.Iterations / (float)params.MaxIterations;
+		} else if (params.ExteriorColoring == ColorAlgorithm::Smooth) {
+			float logP = std::log(params.Power);
+			float log_zn = std::log(glm::dot(z, z)) * 0.5f;
+			float nu = std::log(log_zn / logP) / logP;
+			t = ((float)orbit.Iterations + 1.0f - nu) / (float)params.MaxIterations;
+		} else if (params.ExteriorColoring == ColorAlgorithm::Histogram) {
+			float logP = std::log(params.Power);
+			float log_zn = std::log(glm::dot(z, z)) * 0.5f;
+			float nu = std::log(log_zn / logP) / logP;
+
+			// The smooth iteration count, kept within the iteration of the pixel so it falls into the bin the pixel was counted in
+			float mu = (float)orbit.Iterations + glm::clamp(1.0f - nu, 0.0f, 1.0f);
+
+			if (params.HistogramCDF) {
+				// Interpolates the cumulative histogram across the bin, so the bands of the palette stay smooth
+				float bin = mu * ((float)params.HistogramBins / (float)params.MaxIterations);
+				int k = std::min((int)bin, params.HistogramBins - 1);
+				t = glm::mix(params.HistogramCDF[k], params.HistogramCDF[k + 1], glm::clamp(bin - (float)k, 0.0f, 1.0f));
+			} else {
+				t = mu / (float)params.MaxIterations;
+			}
+		} else {
+			float z_sq = glm::dot(z, z);
+			float dz_sq = glm::dot(orbit.Derivative, orbit.Derivative);
+
+			// Fall back to Step mode in unstable areas, like the shader does
+			if (dz_sq < 1e-20f || z_sq < 1e-20f) {
+				t = (float)orbit.Iterations / (float)params.MaxIterations;
+			} else {
+				float d = std::sqrt(z_sq / dz_sq) * std::log(z_sq) * 0.5f;
+				t = d * params.DistanceScale;
+			}
+		}
+
+		finalColor = GetPaletteColor(params, t);
+
+		if (params.OrbitColoring) {
+			float angle = std::atan2(z.y, z.x) / (2.0f * glm::pi<float>());
+			glm::vec3 orbitColor = GetPaletteColor(params, angle);
+			finalColor = glm::mix(finalColor, orbitColor, 0.5f);
+		}
+	}
+
+	// Final mix with Orbit Trap
+	if (params.Trap.Type != OrbitTrapType::None && orbit.MinTrapDistance < 1e19f) {
+		float trapFactor = params.Trap.Blend * std::exp(-2.0f * orbit.MinTrapDistance);
+		finalColor = glm::mix(finalColor, params.Trap.Color, trapFactor);
+	}
+
+	return finalColor;
+}
+
+int FractalKernel::GetHistogramBin(const KernelParameters& params, int iterations) {
+	return std::min((int)((float)iterations * ((float)params.HistogramBins / (float)params.MaxIterations)), params.HistogramBins - 1);
+}
+
+float FractalKernel::GetTrapDistance(const OrbitTrap& trap, const glm::dvec2& z) {
+	return TrapDistance(trap, z);
+}
+
+glm::vec3 FractalKernel::GetPaletteColor(const KernelParameters& params, float t) {
+	t = glm::fract(t * params.ColorFrequency + params.ColorOffset);
+
+	// Without a palette, return an error color
+	if (!params.Palette) return glm::vec3(1.0f, 0.0f, 1.0f);
+
+	return params.Palette->Sample(t);
+}
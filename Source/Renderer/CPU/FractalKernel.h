@@ -0,0 +1,235 @@
+#pragma once
+
+#include "Core/Settings/Settings.h"
+
+#include "Layers/Mandelbrot/Mandelbrot.h"
+
+#include "Renderer/PaletteLUT.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+/**
+ * A flattened, render-ready copy of the fractal parameters consumed by the CPU kernel.
+ *
+ * It mirrors the uniforms of the Mandelbrot shaders, with the values that are constant across the frame (like the rotation) precomputed once.
+ */
+struct KernelParameters {
+	// View and Calculation
+	glm::vec2 Resolution = { 1.0f, 1.0f };
+	double Zoom = 1.0;
+	glm::dvec2 Position = { 0.0, 0.0 };
+	float CosRotation = 1.0f;
+	float SinRotation = 0.0f;
+	int MaxIterations = 256;
+	float Bailout = 16.0f;
+	float Power = 2.0f;
+	FractalAlgorithm Algorithm = FractalAlgorithm::Mandelbrot;
+
+	// Julia
+	bool JuliaMode = false;
+	glm::vec2 JuliaC = { 0.0f, 0.0f };
+
+	// Coloration
+	ColorAlgorithm ExteriorColoring = ColorAlgorithm::Smooth;
+	InteriorColorAlgorithm InteriorColoring = InteriorColorAlgorithm::CustomColor;
+	glm::vec3 InteriorColor = { 0.0f, 0.0f, 0.0f };
+	float ColorFrequency = 1.0f;
+	float ColorOffset = 0.0f;
+	bool OrbitColoring = false;
+	float DistanceScale = 50.0f;
+
+	// Palette
+	const PaletteLUT* Palette = nullptr; // Only needed for shading, set by the renderer
+
+	// Orbit Trap
+	OrbitTrap Trap;
+
+	// Histogram
+	int HistogramBins = 1;
+	const float* HistogramCDF = nullptr; // 'HistogramBins + 1' entries: the fraction of the exterior pixels below each bin, only set for 'ColorAlgorithm::Histogram'
+
+	// Supersampling
+	glm::vec2 SampleOffset = { 0.0f, 0.0f }; // Added to the pixel centers, set by the renderer for the extra samples of a pixel
+
+	// Derived flags
+	bool NeedsDerivative = false;
+	bool IsPow2 = true;
+	bool UseDoublePrecision = false;
+	bool UsePerturbation = false;
+	bool RejectInterior = false;
+
+	/**
+	 * Builds the kernel parameters from the fractal description and the size of the target image.
+	 *
+	 * @param mandelbrot The fractal to render.
+	 * @param width The width of the target image in pixels.
+	 * @param height The height of the target image in pixels.
+	 * @return The kernel parameters.
+	 */
+	static KernelParameters Create(const Mandelbrot& mandelbrot, uint32_t width, uint32_t height);
+};
+
+/**
+ * The raw outcome of iterating a single pixel, before any coloring is applied.
+ */
+struct OrbitResult {
+	/// @brief The iteration at which the orbit escaped, or `MaxIterations` if it never did (or was found to be periodic).
+	int Iterations = 0;
+
+	/// @brief The last value of `z`. For periodic orbits, the point at which the cycle was found.
+	glm::vec2 Z = { 0.0f, 0.0f };
+
+	/// @brief The last value of the derivative `dz/dc`, only tracked when needed.
+	glm::vec2 Derivative = { 0.0f, 0.0f };
+
+	/// @brief The minimum distance from the orbit to the orbit trap.
+	float MinTrapDistance = 1e20f;
+
+	/// @brief The number of iterations actually computed, lower than `Iterations + 1` when the periodicity check or the series approximation cut the orbit short.
+	/// `0` for interior pixels rejected without iterating (see `FractalKernel::IsInMainCardioidOrBulb`).
+	int ExecutedIterations = 0;
+
+	/// @brief Whether the orbit was proven never to escape, by the interior test or the periodicity check, rather than running out of iterations.
+	bool ProvenInterior = false;
+};
+
+/**
+ * The scalar CPU implementation of the Mandelbrot shader.
+ *
+ * Both halves of the shader (iteration and coloring) are reproduced step by step, so the CPU engine produces the same image as the GPU.
+ * Like the shader, the iteration switches to double precision when the pixel spacing demands it (see `Mandelbrot::RequiresDoublePrecision`), while coloring always stays in single precision.
+ * The iteration also has SIMD implementations (SSE2, AVX2 and AVX-512), each one living in its own translation unit that enables that instruction set for its functions only, and selected at runtime.
+ */
+class FractalKernel {
+public:
+	/**
+	 * Maps a fragment coordinate to the complex plane, applying the zoom, rotation and position of the view. The fragment is moved by `params.SampleOffset` first.
+	 *
+	 * @tparam Real The precision of the mapping, `float` or `double`.
+	 * @param params The kernel parameters of the frame.
+	 * @param fragX The horizontal fragment coordinate (pixel center).
+	 * @param fragY The vertical fragment coordinate (pixel center, bottom-up).
+	 * @return The point of the complex plane under the fragment.
+	 */
+	template<typename Real>
+	static glm::vec<2, Real> MapToComplex(const KernelParameters& params, float fragX, float fragY);
+
+	/**
+	 * Maps a fragment coordinate to its offset from the view center on the complex plane, in double precision.
+	 *
+	 * Unlike `MapToComplex`, the offset never gets added to the position, so it stays accurate at any zoom. Perturbation iterates it against the reference orbit of the center.
+	 *
+	 * @param params The kernel parameters of the frame.
+	 * @param fragX The horizontal fragment coordinate (pixel center).
+	 * @param fragY The vertical fragment coordinate (pixel center, bottom-up).
+	 * @return The offset of the fragment from the view center.
+	 */
+	static glm::dvec2 MapToOffset(const KernelParameters& params, float fragX, float fragY);
+
+	/**
+	 * Checks whether a point lies inside the main cardioid or the period-2 bulb of the quadratic Mandelbrot set, where every orbit stays bounded.
+	 *
+	 * Both regions have a closed form, so their pixels are classified as interior in a few operations instead of `MaxIterations` iterations.
+	 * The kernels only apply it when `params.RejectInterior` is set (see `Mandelbrot::SupportsInteriorRejection`).
+	 *
+	 * @tparam Real The precision of the test, `float` or `double`.
+	 * @param c The point of the complex plane.
+	 * @return `true` if the point is inside one of the two regions, `false` otherwise.
+	 */
+	template<typename Real>
+	static bool IsInMainCardioidOrBulb(const glm::vec<2, Real>& c);
+
+	/**
+	 * Iterates the pixel located at the given fragment coordinates, in the precision selected by `params.UseDoublePrecision`.
+	 *
+	 * @param params The kernel parameters of the frame.
+	 * @param fragX The horizontal fragment coordinate (pixel center), equivalent to `gl_FragCoord.x`.
+	 * @param fragY The vertical fragment coordinate (pixel center, bottom-up), equivalent to `gl_FragCoord.y`.
+	 * @return The orbit of the pixel.
+	 */
+	static OrbitResult Iterate(const KernelParameters& params, float fragX, float fragY);
+
+	/**
+	 * Checks whether the SIMD kernels can iterate the given frame.
+	 *
+	 * They cover the quadratic (`Power == 2`) variants of every algorithm, with or without the derivative. Other powers and orbit traps use the scalar kernel.
+	 *
+	 * @param params The kernel parameters of the frame.
+	 * @return `true` if the SIMD kernels support the frame, `false` otherwise.
+	 */
+	static bool SupportsSIMD(const KernelParameters& params);
+
+	/**
+	 * Iterates `count` consecutive pixels of a row, using the widest kernel allowed by `instructionSet` that supports the frame.
+	 *
+	 * @param params The kernel parameters of the frame.
+	 * @param instructionSet The resolved instruction set to use (see `CPUFeatures::Resolve`).
+	 * @param x The first pixel of the run.
+	 * @param y The row of the run (bottom-up).
+	 * @param count The number of pixels of the run.
+	 * @param results The output orbits, `count` elements long.
+	 */
+	static void IterateRow(const KernelParameters& params, InstructionSet instructionSet, uint32_t x, uint32_t y, uint32_t count, OrbitResult* results);
+
+	/**
+	 * Iterates an arbitrary list of pixels, like `IterateRow`.
+	 *
+	 * Scattered pixels (see `AreaSkipping`) still fill every lane of the SIMD kernels this way.
+	 *
+	 * @param params The kernel parameters of the frame.
+	 * @param instructionSet The resolved instruction set to use (see `CPUFeatures::Resolve`).
+	 * @param pixels The pixels to iterate (bottom-up rows).
+	 * @param count The number of pixels.
+	 * @param results The output orbits, `count` elements long.
+	 */
+	static void IteratePixels(const KernelParameters& params, InstructionSet instructionSet, const glm::uvec2* pixels, uint32_t count, OrbitResult* results);
+
+	/**
+	 * Computes the final color of a pixel from its orbit.
+	 *
+	 * @param params The kernel parameters of the frame.
+	 * @param orbit The orbit returned by `Iterate`.
+	 * @return The linear RGB color of the pixel.
+	 */
+	static glm::vec3 Shade(const KernelParameters& params, const OrbitResult& orbit);
+
+	/**
+	 * Gets the bin of the iteration histogram an escaped pixel falls into.
+	 *
+	 * @param params The kernel parameters of the frame.
+	 * @param iterations The iteration count of the pixel, below `MaxIterations`.
+	 * @return The bin, in `[0, HistogramBins)`.
+	 */
+	static int GetHistogramBin(const KernelParameters& params, int iterations);
+
+	/**
+	 * Interpolates the color of the palette at `t`, applying the color frequency and offset.
+	 *
+	 * @param params The kernel parameters of the frame.
+	 * @param t The palette coordinate.
+	 * @return The palette color.
+	 */
+	static glm::vec3 GetPaletteColor(const KernelParameters& params, float t);
+
+	/**
+	 * Computes the distance from a point of the orbit to the orbit trap.
+	 *
+	 * @param trap The orbit trap.
+	 * @param z The point of the orbit.
+	 * @return The distance to the trap, or `1e20` if there is no trap.
+	 */
+	static float GetTrapDistance(const OrbitTrap& trap, const glm::dvec2& z);
+private:
+	template<typename Real>
+	static OrbitResult IterateImpl(const KernelParameters& params, float fragX, float fragY);
+
+	static void IterateRowSSE2(const KernelParameters& params, uint32_t x, uint32_t y, uint32_t count, OrbitResult* results);
+	static void IterateRowAVX2(const KernelParameters& params, uint32_t x, uint32_t y, uint32_t count, OrbitResult* results);
+	static void IterateRowAVX512(const KernelParameters& params, uint32_t x, uint32_t y, uint32_t count, OrbitResult* results);
+
+	static void IteratePixelsSSE2(const KernelParameters& params, const glm::uvec2* pixels, uint32_t count, OrbitResult* results);
+	static void IteratePixelsAVX2(const KernelParameters& params, const glm::uvec2* pixels, uint32_t count, OrbitResult* results);
+	static void IteratePixelsAVX512(const KernelParameters& params, const glm::uvec2* pixels, uint32_t count, OrbitResult* results);
+};
@@ -0,0 +1,98 @@
+#include "Renderer/CPU/FractalKernel.h"
+
+#include <immintrin.h>
+
+// Only the code below is compiled for AVX2 and FMA: the headers above (glm, the standard library...) are shared with the rest of the
+// application, and their inline functions must not be emitted with instructions that older processors cannot run.
+#if defined(__clang__)
+	#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#elif defined(__GNUC__)
+	#pragma GCC push_options
+	#pragma GCC target("avx2,fma")
+#endif
+
+#include "Renderer/CPU/FractalKernelSIMD.h"
+
+namespace {
+
+	// Eight single-precision lanes of 256-bit AVX2 vectors, with fused multiply-add.
+	struct AVX2Ops {
+		using Real = float;
+		using Float = __m256;
+		using Mask = __m256;
+		static constexpr uint32_t Width = 8;
+
+		static Float Set1(float value) { return _mm256_set1_ps(value); }
+		static Float Load(const float* values) { return _mm256_load_ps(values); }
+		static void Store(float* values, Float a) { _mm256_store_ps(values, a); }
+
+		static Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+		static Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+		static Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+		static Float MulAdd(Float a, Float b, Float c) { return _mm256_fmadd_ps(a, b, c); }
+		static Float MulSub(Float a, Float b, Float c) { return _mm256_fmsub_ps(a, b, c); }
+		static Float Abs(Float a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+		static Float Negate(Float a) { return _mm256_xor_ps(_mm256_set1_ps(-0.0f), a); }
+		static Float Select(Mask mask, Float a, Float b) { return _mm256_blendv_ps(b, a, mask); }
+
+		static Mask Greater(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+		static Mask Equal(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+		static Mask And(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+		static Mask AndNot(Mask a, Mask b) { return _mm256_andnot_ps(a, b); }
+		static uint32_t ToBits(Mask mask) { return (uint32_t)_mm256_movemask_ps(mask); }
+	};
+
+	// Four double-precision lanes of 256-bit AVX2 vectors, with fused multiply-add.
+	struct AVX2DoubleOps {
+		using Real = double;
+		using Float = __m256d;
+		using Mask = __m256d;
+		static constexpr uint32_t Width = 4;
+
+		static Float Set1(double value) { return _mm256_set1_pd(value); }
+		static Float Load(const double* values) { return _mm256_load_pd(values); }
+		static void Store(double* values, Float a) { _mm256_store_pd(values, a); }
+
+		static Float Add(Float a, Float b) { return _mm256_add_pd(a, b); }
+		static Float Sub(Float a, Float b) { return _mm256_sub_pd(a, b); }
+		static Float Mul(Float a, Float b) { return _mm256_mul_pd(a, b); }
+		static Float MulAdd(Float a, Float b, Float c) { return _mm256_fmadd_pd(a, b, c); }
+		static Float MulSub(Float a, Float b, Float c) { return _mm256_fmsub_pd(a, b, c); }
+		static Float Abs(Float a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+		static Float Negate(Float a) { return _mm256_xor_pd(_mm256_set1_pd(-0.0), a); }
+		static Float Select(Mask mask, Float a, Float b) { return _mm256_blendv_pd(b, a, mask); }
+
+		static Mask Greater(Float a, Float b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+		static Mask Equal(Float a, Float b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+		static Mask And(Mask a, Mask b) { return _mm256_and_pd(a, b); }
+		static Mask AndNot(Mask a, Mask b) { return _mm256_andnot_pd(a, b); }
+		static uint32_t ToBits(Mask mask) { return (uint32_t)_mm256_movemask_pd(mask); }
+	};
+
+}
+
+void FractalKernel::IterateRowAVX2(const KernelParameters& params, uint32_t x, uint32_t y, uint32_t count, OrbitResult* results) {
+	const auto pixelAt = [x, y](uint32_t i) { return glm::uvec2(x + i, y); };
+
+	if (params.UseDoublePrecision) {
+		IterateSIMD<AVX2DoubleOps>(params, count, pixelAt, results);
+	} else {
+		IterateSIMD<AVX2Ops>(params, count, pixelAt, results);
+	}
+}
+
+void FractalKernel::IteratePixelsAVX2(const KernelParameters& params, const glm::uvec2* pixels, uint32_t count, OrbitResult* results) {
+	const auto pixelAt = [pixels](uint32_t i) { return pixels[i]; };
+
+	if (params.UseDoublePrecision) {
+		IterateSIMD<AVX2DoubleOps>(params, count, pixelAt, results);
+	} else {
+		IterateSIMD<AVX2Ops>(params, count, pixelAt, results);
+	}
+}
+
+#if defined(__clang__)
+	#pragma clang attribute pop
+#elif defined(__GNUC__)
+	#pragma GCC pop_options
+#endif
@@ -0,0 +1,98 @@
+#include "Renderer/CPU/FractalKernel.h"
+
+#include <immintrin.h>
+
+// Only the code below is compiled for AVX-512, AVX2 and FMA: the headers above (glm, the standard library...) are shared with the rest of the
+// application, and their inline functions must not be emitted with instructions that older processors cannot run.
+#if defined(__clang__)
+	#pragma clang attribute push(__attribute__((target("avx512f,avx2,fma"))), apply_to = function)
+#elif defined(__GNUC__)
+	#pragma GCC push_options
+	#pragma GCC target("avx512f,avx2,fma")
+#endif
+
+#include "Renderer/CPU/FractalKernelSIMD.h"
+
+namespace {
+
+	// Sixteen single-precision lanes of 512-bit AVX-512 vectors, with fused multiply-add and dedicated mask registers.
+	struct AVX512Ops {
+		using Real = float;
+		using Float = __m512;
+		using Mask = __mmask16;
+		static constexpr uint32_t Width = 16;
+
+		static Float Set1(float value) { return _mm512_set1_ps(value); }
+		static Float Load(const float* values) { return _mm512_load_ps(values); }
+		static void Store(float* values, Float a) { _mm512_store_ps(values, a); }
+
+		static Float Add(Float a, Float b) { return _mm512_add_ps(a, b); }
+		static Float Sub(Float a, Float b) { return _mm512_sub_ps(a, b); }
+		static Float Mul(Float a, Float b) { return _mm512_mul_ps(a, b); }
+		static Float MulAdd(Float a, Float b, Float c) { return _mm512_fmadd_ps(a, b, c); }
+		static Float MulSub(Float a, Float b, Float c) { return _mm512_fmsub_ps(a, b, c); }
+		static Float Abs(Float a) { return _mm512_castsi512_ps(_mm512_and_epi32(_mm512_castps_si512(a), _mm512_set1_epi32(0x7FFFFFFF))); }
+		static Float Negate(Float a) { return _mm512_castsi512_ps(_mm512_xor_epi32(_mm512_castps_si512(a), _mm512_set1_epi32((int)0x80000000))); }
+		static Float Select(Mask mask, Float a, Float b) { return _mm512_mask_blend_ps(mask, b, a); }
+
+		static Mask Greater(Float a, Float b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+		static Mask Equal(Float a, Float b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+		static Mask And(Mask a, Mask b) { return (Mask)(a & b); }
+		static Mask AndNot(Mask a, Mask b) { return (Mask)(~a & b); }
+		static uint32_t ToBits(Mask mask) { return (uint32_t)mask; }
+	};
+
+	// Eight double-precision lanes of 512-bit AVX-512 vectors.
+	struct AVX512DoubleOps {
+		using Real = double;
+		using Float = __m512d;
+		using Mask = __mmask8;
+		static constexpr uint32_t Width = 8;
+
+		static Float Set1(double value) { return _mm512_set1_pd(value); }
+		static Float Load(const double* values) { return _mm512_load_pd(values); }
+		static void Store(double* values, Float a) { _mm512_store_pd(values, a); }
+
+		static Float Add(Float a, Float b) { return _mm512_add_pd(a, b); }
+		static Float Sub(Float a, Float b) { return _mm512_sub_pd(a, b); }
+		static Float Mul(Float a, Float b) { return _mm512_mul_pd(a, b); }
+		static Float MulAdd(Float a, Float b, Float c) { return _mm512_fmadd_pd(a, b, c); }
+		static Float MulSub(Float a, Float b, Float c) { return _mm512_fmsub_pd(a, b, c); }
+		static Float Abs(Float a) { return _mm512_castsi512_pd(_mm512_and_epi64(_mm512_castpd_si512(a), _mm512_set1_epi64(0x7FFFFFFFFFFFFFFFll))); }
+		static Float Negate(Float a) { return _mm512_castsi512_pd(_mm512_xor_epi64(_mm512_castpd_si512(a), _mm512_set1_epi64((long long)0x8000000000000000ull))); }
+		static Float Select(Mask mask, Float a, Float b) { return _mm512_mask_blend_pd(mask, b, a); }
+
+		static Mask Greater(Float a, Float b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+		static Mask Equal(Float a, Float b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+		static Mask And(Mask a, Mask b) { return (Mask)(a & b); }
+		static Mask AndNot(Mask a, Mask b) { return (Mask)(~a & b); }
+		static uint32_t ToBits(Mask mask) { return (uint32_t)mask; }
+	};
+
+}
+
+void FractalKernel::IterateRowAVX512(const KernelParameters& params, uint32_t x, uint32_t y, uint32_t count, OrbitResult* results) {
+	const auto pixelAt = [x, y](uint32_t i) { return glm::uvec2(x + i, y); };
+
+	if (params.UseDoublePrecision) {
+		IterateSIMD<AVX512DoubleOps>(params, count, pixelAt, results);
+	} else {
+		IterateSIMD<AVX512Ops>(params, count, pixelAt, results);
+	}
+}
+
+void FractalKernel::IteratePixelsAVX512(const KernelParameters& params, const glm::uvec2* pixels, uint32_t count, OrbitResult* results) {
+	const auto pixelAt = [pixels](uint32_t i) { return pixels[i]; };
+
+	if (params.UseDoublePrecision) {
+		IterateSIMD<AVX512DoubleOps>(params, count, pixelAt, results);
+	} else {
+		IterateSIMD<AVX512Ops>(params, count, pixelAt, results);
+	}
+}
+
+#if defined(__clang__)
+	#pragma clang attribute pop
+#elif defined(__GNUC__)
+	#pragma GCC pop_options
+#endif
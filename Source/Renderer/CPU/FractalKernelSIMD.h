@@ -0,0 +1,199 @@
+#pragma once
+
+#include "Renderer/CPU/FractalKernel.h"
+
+/**
+ * The escape-time loop shared by the SIMD kernels, written once against a small set of vector operations (`Ops`).
+ *
+ * Each SIMD translation unit includes this header and instantiates it with an `Ops` type declared in an anonymous namespace,
+ * so every instantiation stays local to the translation unit and is never shared with code that may run on older processors.
+ * The translation units are compiled for the baseline instruction set: they include `FractalKernel.h` first, then enable their instruction set
+ * (`#pragma GCC target` / `#pragma clang attribute`) only around this header and their own functions, so the inline functions of the shared headers
+ * are never emitted with instructions the processor may not have. For the same reason, this header must only be included that way, by the SIMD translation units.
+ *
+ * `Ops` provides:
+ * - `Real`: the scalar type of the lanes (`float` or `double`), which selects the precision of the iteration.
+ * - `Float` / `Mask`: the vector and lane mask types, and `Width`, the number of lanes.
+ * - `Set1`, `Load`, `Store`, `Add`, `Sub`, `Mul`, `MulAdd` (`a * b + c`), `MulSub` (`a * b - c`), `Abs`, `Negate` and `Select` (per-lane `mask ? a : b`).
+ * - `Greater` (per-lane `a > b`), `Equal` (per-lane `a == b`), `And`, `AndNot` (`b & ~a`) and `ToBits` (one bit per lane).
+ *
+ * `pixelAt(i)` returns the image position (`glm::uvec2`) of the pixel `i`, so rows and arbitrary lists of pixels share the loop.
+ */
+template<typename Ops, typename PixelAt>
+static void IterateSIMD(const KernelParameters& params, uint32_t count, const PixelAt& pixelAt, OrbitResult* results) {
+	using Real = typename Ops::Real;
+	using Float = typename Ops::Float;
+	using Mask = typename Ops::Mask;
+	constexpr uint32_t Width = Ops::Width;
+
+	const bool burningShip = params.Algorithm == FractalAlgorithm::BurningShip;
+	const bool tricorn = params.Algorithm == FractalAlgorithm::Tricorn;
+
+	const Float two = Ops::Set1((Real)2);
+	const Float one = Ops::Set1((Real)1);
+	const Float zero = Ops::Set1((Real)0);
+	const Float bailout = Ops::Set1((Real)params.Bailout);
+	const Float epsilon = Ops::Set1((Real)1e-12);
+
+	alignas(64) Real pointX[Width], pointY[Width], laneActive[Width];
+	alignas(64) Real laneZX[Width], laneZY[Width], laneDZX[Width], laneDZY[Width];
+	int iterations[Width], executed[Width];
+	bool interior[Width];
+
+	for (uint32_t base = 0; base < count; base += Width) {
+		const uint32_t lanes = count - base < Width ? count - base : Width;
+
+		// The starting points are computed with the scalar mapping, so every kernel samples exactly the same coordinates.
+		// Lanes past the end of the run repeat the last pixel and are discarded.
+		for (uint32_t lane = 0; lane < Width; ++lane) {
+			const glm::uvec2 pixel = pixelAt(base + (lane < lanes ? lane : lanes - 1));
+			const glm::vec<2, Real> point = FractalKernel::MapToComplex<Real>(params, (float)pixel.x + 0.5f, (float)pixel.y + 0.5f);
+			pointX[lane] = point.x;
+			pointY[lane] = point.y;
+			iterations[lane] = params.MaxIterations;
+			executed[lane] = params.MaxIterations;
+			interior[lane] = false;
+
+			// Lanes inside the main cardioid or the period-2 bulb never escape, so they start out finished
+			const bool rejected = params.RejectInterior && FractalKernel::IsInMainCardioidOrBulb(point);
+			laneActive[lane] = rejected ? (Real)0 : (Real)1;
+			if (rejected) {
+				executed[lane] = 0;
+				interior[lane] = true;
+				if (lane < lanes) {
+					results[base + lane].Z = glm::vec2(0.0f);
+					results[base + lane].Derivative = glm::vec2(0.0f);
+				}
+			}
+		}
+
+		Float zx, zy, cx, cy, dzx, dzy;
+		if (params.JuliaMode) {
+			zx = Ops::Load(pointX);
+			zy = Ops::Load(pointY);
+			cx = Ops::Set1((Real)params.JuliaC.x);
+			cy = Ops::Set1((Real)params.JuliaC.y);
+			dzx = one;
+		} else {
+			zx = zero;
+			zy = zero;
+			cx = Ops::Load(pointX);
+			cy = Ops::Load(pointY);
+			dzx = zero;
+		}
+		dzy = zero;
+
+		Mask active = Ops::Greater(Ops::Load(laneActive), zero);
+
+		// Brent's periodicity check, on the same schedule as the scalar kernel
+		Float savedX = zx, savedY = zy;
+		int checkpoint = 1;
+
+		// Batches can be rejected as a whole inside the cardioid
+		const int iterationLimit = Ops::ToBits(active) != 0 ? params.MaxIterations : 0;
+
+		for (int i = 0; i < iterationLimit; ++i) {
+			// The derivative is updated using the current 'z', away from the origin.
+			// Finished lanes keep the one they finished with, so the decaying derivative of periodic orbits never turns into denormals.
+			if (params.NeedsDerivative) {
+				const Mask safe = Ops::And(active, Ops::Greater(Ops::MulAdd(zx, zx, Ops::Mul(zy, zy)), epsilon));
+				const Float nextDZX = Ops::Mul(two, Ops::MulSub(zx, dzx, Ops::Mul(zy, dzy)));
+				const Float nextDZY = Ops::Mul(two, Ops::MulAdd(zx, dzy, Ops::Mul(zy, dzx)));
+				dzx = Ops::Select(safe, nextDZX, dzx);
+				dzy = Ops::Select(safe, nextDZY, dzy);
+			}
+
+			if (burningShip) {
+				zx = Ops::Abs(zx);
+				zy = Ops::Abs(zy);
+			} else if (tricorn) {
+				zy = Ops::Negate(zy);
+			}
+
+			// z = z^2 + c
+			const Float xy = Ops::Mul(zx, zy);
+			zx = Ops::Add(Ops::MulSub(zx, zx, Ops::Mul(zy, zy)), cx);
+			zy = Ops::MulAdd(two, xy, cy);
+
+			// For Mandelbrot, on the first iteration, dz must be 1
+			if (!params.JuliaMode && i == 0) {
+				dzx = one;
+				dzy = zero;
+			}
+
+			const Mask escaped = Ops::And(active, Ops::Greater(Ops::MulAdd(zx, zx, Ops::Mul(zy, zy)), bailout));
+			const Mask periodic = Ops::AndNot(escaped, Ops::And(active, Ops::And(Ops::Equal(zx, savedX), Ops::Equal(zy, savedY))));
+
+			if (i == checkpoint) {
+				savedX = zx;
+				savedY = zy;
+				checkpoint *= 2;
+			}
+
+			const uint32_t escapedBits = Ops::ToBits(escaped);
+			uint32_t finishedBits = escapedBits | Ops::ToBits(periodic);
+			if (finishedBits == 0) {
+				continue;
+			}
+
+			// Lanes finish only once, so spilling the registers here is cheap compared to blending them every iteration
+			Ops::Store(laneZX, zx);
+			Ops::Store(laneZY, zy);
+			Ops::Store(laneDZX, dzx);
+			Ops::Store(laneDZY, dzy);
+
+			while (finishedBits != 0) {
+				uint32_t lane = 0;
+				while ((finishedBits & (1u << lane)) == 0) {
+					++lane;
+				}
+				finishedBits &= ~(1u << lane);
+
+				// Periodic lanes are interior, and keep 'MaxIterations'
+				if (escapedBits & (1u << lane)) {
+					iterations[lane] = i;
+				} else {
+					interior[lane] = true;
+				}
+				executed[lane] = i + 1;
+
+				if (lane < lanes) {
+					OrbitResult& result = results[base + lane];
+					result.Z.x = (float)laneZX[lane];
+					result.Z.y = (float)laneZY[lane];
+					result.Derivative.x = (float)laneDZX[lane];
+					result.Derivative.y = (float)laneDZY[lane];
+				}
+			}
+
+			active = Ops::AndNot(periodic, Ops::AndNot(escaped, active));
+			if (Ops::ToBits(active) == 0) {
+				break;
+			}
+		}
+
+		// Lanes that never escaped keep their final state
+		uint32_t activeBits = Ops::ToBits(active);
+		if (activeBits != 0) {
+			Ops::Store(laneZX, zx);
+			Ops::Store(laneZY, zy);
+			Ops::Store(laneDZX, dzx);
+			Ops::Store(laneDZY, dzy);
+		}
+
+		for (uint32_t lane = 0; lane < lanes; ++lane) {
+			OrbitResult& result = results[base + lane];
+			result.Iterations = iterations[lane];
+			result.ExecutedIterations = executed[lane];
+			result.ProvenInterior = interior[lane];
+			result.MinTrapDistance = 1e20f;
+
+			if (activeBits & (1u << lane)) {
+				result.Z.x = (float)laneZX[lane];
+				result.Z.y = (float)laneZY[lane];
+				result.Derivative.x = (float)laneDZX[lane];
+				result.Derivative.y = (float)laneDZY[lane];
+			}
+		}
+	}
+}
@@ -0,0 +1,81 @@
+#include "Renderer/CPU/FractalKernelSIMD.h"
+
+#include <emmintrin.h>
+
+namespace {
+
+	// Four single-precision lanes of 128-bit SSE2 vectors. SSE2 has no fused multiply-add, so `MulAdd` rounds twice like the scalar kernel.
+	struct SSE2Ops {
+		using Real = float;
+		using Float = __m128;
+		using Mask = __m128;
+		static constexpr uint32_t Width = 4;
+
+		static Float Set1(float value) { return _mm_set1_ps(value); }
+		static Float Load(const float* values) { return _mm_load_ps(values); }
+		static void Store(float* values, Float a) { _mm_store_ps(values, a); }
+
+		static Float Add(Float a, Float b) { return _mm_add_ps(a, b); }
+		static Float Sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+		static Float Mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+		static Float MulAdd(Float a, Float b, Float c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+		static Float MulSub(Float a, Float b, Float c) { return _mm_sub_ps(_mm_mul_ps(a, b), c); }
+		static Float Abs(Float a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+		static Float Negate(Float a) { return _mm_xor_ps(_mm_set1_ps(-0.0f), a); }
+		static Float Select(Mask mask, Float a, Float b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+		static Mask Greater(Float a, Float b) { return _mm_cmpgt_ps(a, b); }
+		static Mask Equal(Float a, Float b) { return _mm_cmpeq_ps(a, b); }
+		static Mask And(Mask a, Mask b) { return _mm_and_ps(a, b); }
+		static Mask AndNot(Mask a, Mask b) { return _mm_andnot_ps(a, b); }
+		static uint32_t ToBits(Mask mask) { return (uint32_t)_mm_movemask_ps(mask); }
+	};
+
+	// Two double-precision lanes of 128-bit SSE2 vectors.
+	struct SSE2DoubleOps {
+		using Real = double;
+		using Float = __m128d;
+		using Mask = __m128d;
+		static constexpr uint32_t Width = 2;
+
+		static Float Set1(double value) { return _mm_set1_pd(value); }
+		static Float Load(const double* values) { return _mm_load_pd(values); }
+		static void Store(double* values, Float a) { _mm_store_pd(values, a); }
+
+		static Float Add(Float a, Float b) { return _mm_add_pd(a, b); }
+		static Float Sub(Float a, Float b) { return _mm_sub_pd(a, b); }
+		static Float Mul(Float a, Float b) { return _mm_mul_pd(a, b); }
+		static Float MulAdd(Float a, Float b, Float c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+		static Float MulSub(Float a, Float b, Float c) { return _mm_sub_pd(_mm_mul_pd(a, b), c); }
+		static Float Abs(Float a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+		static Float Negate(Float a) { return _mm_xor_pd(_mm_set1_pd(-0.0), a); }
+		static Float Select(Mask mask, Float a, Float b) { return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b)); }
+
+		static Mask Greater(Float a, Float b) { return _mm_cmpgt_pd(a, b); }
+		static Mask Equal(Float a, Float b) { return _mm_cmpeq_pd(a, b); }
+		static Mask And(Mask a, Mask b) { return _mm_and_pd(a, b); }
+		static Mask AndNot(Mask a, Mask b) { return _mm_andnot_pd(a, b); }
+		static uint32_t ToBits(Mask mask) { return (uint32_t)_mm_movemask_pd(mask); }
+	};
+
+}
+
+void FractalKernel::IterateRowSSE2(const KernelParameters& params, uint32_t x, uint32_t y, uint32_t count, OrbitResult* results) {
+	const auto pixelAt = [x, y](uint32_t i) { return glm::uvec2(x + i, y); };
+
+	if (params.UseDoublePrecision) {
+		IterateSIMD<SSE2DoubleOps>(params, count, pixelAt, results);
+	} else {
+		IterateSIMD<SSE2Ops>(params, count, pixelAt, results);
+	}
+}
+
+void FractalKernel::IteratePixelsSSE2(const KernelParameters& params, const glm::uvec2* pixels, uint32_t count, OrbitResult* results) {
+	const auto pixelAt = [pixels](uint32_t i) { return pixels[i]; };
+
+	if (params.UseDoublePrecision) {
+		IterateSIMD<SSE2DoubleOps>(params, count, pixelAt, results);
+	} else {
+		IterateSIMD<SSE2Ops>(params, count, pixelAt, results);
+	}
+}
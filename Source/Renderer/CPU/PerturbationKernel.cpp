@@ -0,0 +1,106 @@
+#include "PerturbationKernel.h"
+
+#include <algorithm>
+
+// Complex multiplication
+static glm::dvec2 CMul(const glm::dvec2& a, const glm::dvec2& b) {
+	return glm::dvec2(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+uint32_t PerturbationKernel::IterateRow(const KernelParameters& params, const ReferenceOrbit& reference, const SeriesApproximation& series, uint32_t x, uint32_t y, uint32_t count, OrbitResult* results) {
+	const std::vector<glm::dvec2>& points = reference.GetPoints();
+	const uint32_t last = reference.GetLength() - 1;
+
+	const float fragY = (float)y + 0.5f;
+	const double bailout = (double)params.Bailout;
+	const bool hasTrap = params.Trap.Type != OrbitTrapType::None;
+	const int skipped = series.SkippedIterations;
+
+	uint32_t rebases = 0;
+
+	for (uint32_t pixel = 0; pixel < count; ++pixel) {
+		const glm::dvec2 deltaC = FractalKernel::MapToOffset(params, (float)(x + pixel) + 0.5f, fragY);
+
+		glm::dvec2 delta(0.0), dz(0.0);
+		uint32_t m = 0;
+
+		// Start from the series approximation, with the derivative of the reference orbit
+		if (skipped > 0) {
+			const glm::dvec2 u = deltaC / series.Radius;
+			const glm::dvec2 u2 = CMul(u, u);
+
+			delta = CMul(series.A, u) + CMul(series.B, u2) + CMul(series.C, CMul(u2, u));
+			dz = series.Derivative;
+			m = (uint32_t)skipped;
+		}
+
+		glm::dvec2 z = points[m] + delta;
+		float minTrapDist = 1e20f;
+
+		// Brent's periodicity check, on the state of the perturbed orbit (its offset and its position along the reference)
+		glm::dvec2 savedDelta = delta;
+		uint32_t savedM = m;
+		int checkpoint = skipped + 1;
+		int executed = -1;
+
+		int i = skipped;
+		if (skipped > 0 && glm::dot(z, z) > bailout) {
+			// The pixel escaped during the skipped iterations
+			i = skipped - 1;
+		} else {
+			for (; i < params.MaxIterations; i++) {
+				// The derivative is updated using the current 'z'
+				if (params.NeedsDerivative && glm::dot(z, z) > 1e-12) {
+					dz = 2.0 * CMul(z, dz);
+				}
+
+				delta = CMul(2.0 * points[m], delta) + CMul(delta, delta) + deltaC;
+				++m;
+
+				// For Mandelbrot, on the first iteration, dz must be 1
+				if (i == 0) {
+					dz = glm::dvec2(1.0, 0.0);
+				}
+
+				z = points[m] + delta;
+
+				if (hasTrap) {
+					minTrapDist = std::min(minTrapDist, FractalKernel::GetTrapDistance(params.Trap, z));
+				}
+
+				if (glm::dot(z, z) > bailout) {
+					break;
+				}
+
+				// Rebase onto the start of the reference orbit when the pixel gets closer to the origin than its offset, or when the reference ran out
+				if (glm::dot(z, z) < glm::dot(delta, delta) || m == last) {
+					delta = z;
+					m = 0;
+					++rebases;
+				}
+
+				if (m == savedM && delta == savedDelta) {
+					executed = i + 1 - skipped;
+					i = params.MaxIterations;
+					break;
+				}
+
+				if (i == checkpoint) {
+					savedDelta = delta;
+					savedM = m;
+					checkpoint = 2 * checkpoint - skipped;
+				}
+			}
+		}
+
+		OrbitResult& result = results[pixel];
+		result.Iterations = i;
+		result.Z = glm::vec2(z);
+		result.Derivative = glm::vec2(dz);
+		result.MinTrapDistance = minTrapDist;
+		result.ExecutedIterations = executed >= 0 ? executed : std::max(std::min(i + 1, params.MaxIterations) - skipped, 0);
+		result.ProvenInterior = executed >= 0;
+	}
+
+	return rebases;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Renderer/CPU/FractalKernel.h"
+#include "Renderer/CPU/ReferenceOrbit.h"
+
+#include <cstdint>
+
+/**
+ * Iterates pixels with perturbation theory, for views deeper than double precision can resolve.
+ *
+ * Every pixel `c = center + deltaC` is iterated as its offset `delta` from the reference orbit `Z` of the view center:
+ * `delta' = 2 * Z * delta + delta^2 + deltaC`, which stays accurate in double precision because it never adds the tiny offsets to the large coordinates.
+ * The first iterations are skipped with the series approximation of the frame, and pixels are rebased onto the start of the reference orbit
+ * whenever their orbit gets closer to the origin than their offset (where the offset would lose its precision and glitch), or when the reference orbit runs out.
+ *
+ * The resulting orbits match the ones of `FractalKernel`, so they are colored by `FractalKernel::Shade`.
+ */
+class PerturbationKernel {
+public:
+	/**
+	 * Iterates `count` consecutive pixels of a row.
+	 *
+	 * @param params The kernel parameters of the frame.
+	 * @param reference The reference orbit of the view center.
+	 * @param series The series approximation of the frame (see `ReferenceOrbit::ComputeSeries`).
+	 * @param x The first pixel of the run.
+	 * @param y The row of the run (bottom-up).
+	 * @param count The number of pixels of the run.
+	 * @param results The output orbits, `count` elements long.
+	 * @return The number of times the pixels of the run were rebased.
+	 */
+	static uint32_t IterateRow(const KernelParameters& params, const ReferenceOrbit& reference, const SeriesApproximation& series, uint32_t x, uint32_t y, uint32_t count, OrbitResult* results);
+};
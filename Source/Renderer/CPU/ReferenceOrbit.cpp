@@ -0,0 +1,167 @@
+#include "ReferenceOrbit.h"
+
+#include "Core/DoubleDouble.h"
+#include "Core/Log.h"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+// Complex multiplication
+static glm::dvec2 CMul(const glm::dvec2& a, const glm::dvec2& b) {
+	return glm::dvec2(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+// The precision of a DoubleDouble, in bits of mantissa
+static constexpr uint32_t DoubleDoubleBits = 106;
+
+// Rounds the center to the precision of the orbit
+template<typename Real>
+static Real ToReal(const BigReal& value) {
+	return Real(value);
+}
+
+template<>
+DoubleDouble ToReal<DoubleDouble>(const BigReal& value) {
+	const double hi = (double)value;
+
+	return DoubleDouble(hi, (double)(value - BigReal(hi)));
+}
+
+bool ReferenceOrbit::Update(const BigVec2& center, double pixelSpacing, int maxIterations, float bailout) {
+	// The orbit needs the bits that tell neighbouring pixels apart, plus a margin for the rounding errors amplified along the orbit
+	const glm::dvec2 approximateCenter(center);
+	const double magnitude = std::max({ 1.0, std::abs(approximateCenter.x), std::abs(approximateCenter.y) });
+	const double requiredBits = std::log2(magnitude / pixelSpacing) + 32.0;
+
+	uint32_t precision = 0;
+	if (requiredBits <= DoubleDoubleBits) {
+		precision = DoubleDoubleBits;
+	} else if (requiredBits <= BigFloat<8>::Bits) {
+		precision = BigFloat<8>::Bits;
+	} else if (requiredBits <= BigFloat<16>::Bits) {
+		precision = BigFloat<16>::Bits;
+	} else {
+		precision = BigReal::Bits;
+	}
+
+	if (!m_Points.empty() && center == m_Center && precision == m_Precision && maxIterations == m_MaxIterations && bailout == m_Bailout) {
+		return false;
+	}
+
+	m_Center = center;
+	m_Precision = precision;
+	m_MaxIterations = maxIterations;
+	m_Bailout = bailout;
+
+	switch (precision) {
+		case DoubleDoubleBits:
+			Compute<DoubleDouble>(center);
+			break;
+		case BigFloat<8>::Bits:
+			Compute<BigFloat<8>>(center);
+			break;
+		case BigFloat<16>::Bits:
+			Compute<BigFloat<16>>(center);
+			break;
+		default:
+			Compute<BigReal>(center);
+			break;
+	}
+
+	Log::Trace("ReferenceOrbit::Update - Computed a reference orbit of " + std::to_string(m_Points.size() - 1) + " iterations with " + std::to_string(precision) + " bits");
+
+	return true;
+}
+
+template<typename Real>
+void ReferenceOrbit::Compute(const BigVec2& center) {
+	m_Points.clear();
+	m_Points.reserve((size_t)m_MaxIterations + 1);
+	m_Points.emplace_back(0.0, 0.0);
+
+	const Real cx = ToReal<Real>(center.x), cy = ToReal<Real>(center.y);
+	Real zx(0.0), zy(0.0);
+
+	// Each point is computed from the previous one in extended precision, so rounding errors never accumulate along the orbit
+	for (int i = 0; i < m_MaxIterations; ++i) {
+		const Real xy = zx * zy;
+		zx = zx * zx - zy * zy + cx;
+		zy = xy + xy + cy;
+
+		const glm::dvec2 z((double)zx, (double)zy);
+		m_Points.push_back(z);
+
+		if (glm::dot(z, z) > (double)m_Bailout) {
+			break;
+		}
+	}
+}
+
+SeriesApproximation ReferenceOrbit::ComputeSeries(double radius, int maxIterations) const {
+	SeriesApproximation series;
+	series.Radius = radius;
+
+	// The series is checked against exact perturbation on the edge of the view, where its truncation error is the largest.
+	// Pixels near the boundary amplify any initial error over thousands of iterations, so the tolerance stays close to double precision.
+	constexpr int ProbeCount = 8;
+	constexpr double Tolerance = 1e-13;
+
+	glm::dvec2 probeU[ProbeCount], probeDeltaC[ProbeCount], probeDelta[ProbeCount];
+	for (int p = 0; p < ProbeCount; ++p) {
+		const double angle = glm::two_pi<double>() * (double)p / (double)ProbeCount;
+		probeU[p] = glm::dvec2(std::cos(angle), std::sin(angle));
+		probeDeltaC[p] = probeU[p] * radius;
+		probeDelta[p] = glm::dvec2(0.0);
+	}
+
+	const int last = std::min((int)m_Points.size() - 1, maxIterations - 1);
+
+	for (int n = 0; n < last; ++n) {
+		const glm::dvec2& z = m_Points[n];
+		const glm::dvec2 twoZ = 2.0 * z;
+
+		// A' = 2ZA + 1, B' = 2ZB + A^2, C' = 2ZC + 2AB (scaled by powers of the radius)
+		const glm::dvec2 a = CMul(twoZ, series.A) + glm::dvec2(radius, 0.0);
+		const glm::dvec2 b = CMul(twoZ, series.B) + CMul(series.A, series.A);
+		const glm::dvec2 c = CMul(twoZ, series.C) + 2.0 * CMul(series.A, series.B);
+
+		bool valid = true;
+		for (int p = 0; p < ProbeCount && valid; ++p) {
+			const glm::dvec2 delta = CMul(twoZ, probeDelta[p]) + CMul(probeDelta[p], probeDelta[p]) + probeDeltaC[p];
+
+			const glm::dvec2& u = probeU[p];
+			const glm::dvec2 u2 = CMul(u, u);
+			const glm::dvec2 approximation = CMul(a, u) + CMul(b, u2) + CMul(c, CMul(u2, u));
+
+			const glm::dvec2 error = approximation - delta;
+			const glm::dvec2 pixel = m_Points[n + 1] + delta;
+
+			// Stop before the series drifts away, or before the probe would need to be rebased
+			valid = glm::dot(error, error) <= Tolerance * Tolerance * glm::dot(delta, delta) && glm::dot(pixel, pixel) >= glm::dot(delta, delta);
+
+			probeDelta[p] = delta;
+		}
+
+		if (!valid) {
+			break;
+		}
+
+		series.A = a;
+		series.B = b;
+		series.C = c;
+
+		// Same derivative as the kernels: reset to 1 after the first iteration, then multiplied by 2z away from the origin
+		if (n == 0) {
+			series.Derivative = glm::dvec2(1.0, 0.0);
+		} else if (glm::dot(z, z) > 1e-12) {
+			series.Derivative = CMul(twoZ, series.Derivative);
+		}
+
+		series.SkippedIterations = n + 1;
+	}
+
+	return series;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Core/BigFloat.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * The truncated series `delta(n) = A * u + B * u^2 + C * u^3` approximating the offset of every pixel from the reference orbit, after `SkippedIterations` iterations.
+ *
+ * `u = deltaC / Radius` is the offset of the pixel from the view center, normalized by the radius of the view, so the coefficients stay in the range of the offsets themselves at any zoom.
+ */
+struct SeriesApproximation {
+	/// @brief The number of iterations every pixel skips by evaluating the series. `0` when the series is disabled.
+	int SkippedIterations = 0;
+
+	/// @brief The radius of the view on the complex plane, used to normalize the pixel offsets.
+	double Radius = 1.0;
+
+	/// @brief The coefficients of the series, as complex numbers.
+	glm::dvec2 A = { 0.0, 0.0 };
+	glm::dvec2 B = { 0.0, 0.0 };
+	glm::dvec2 C = { 0.0, 0.0 };
+
+	/// @brief The derivative of the reference orbit after `SkippedIterations` iterations, which seeds the derivative of the pixels.
+	glm::dvec2 Derivative = { 0.0, 0.0 };
+};
+
+/**
+ * The orbit of the view center, computed in extended precision and stored in double precision.
+ *
+ * Perturbation iterates every pixel as a small offset from this orbit, which only needs double precision however deep the view is.
+ * The orbit itself needs more bits than the zoom resolves, so it is computed with `DoubleDouble` down to about 1e24 and with `BigFloat` of growing width past that.
+ * The orbit is only recomputed when the center, the precision or the iteration budget changes.
+ */
+class ReferenceOrbit {
+public:
+	/**
+	 * Recomputes the orbit if the center or the iteration parameters changed since the last call.
+	 *
+	 * @param center The reference point on the complex plane, usually the view center.
+	 * @param pixelSpacing The distance between two adjacent pixels, which sets the precision of the orbit.
+	 * @param maxIterations The maximum number of iterations of the orbit.
+	 * @param bailout The squared escape radius.
+	 * @return `true` if the orbit was recomputed, `false` if the cached one was kept.
+	 */
+	bool Update(const BigVec2& center, double pixelSpacing, int maxIterations, float bailout);
+
+	/**
+	 * Finds how many iterations the pixels can skip with a series approximation, by checking the series against perturbation iterated exactly at probe points on the edge of the view.
+	 *
+	 * @param radius The radius of the view on the complex plane (the distance from the center to the farthest pixel).
+	 * @param maxIterations The maximum number of iterations of the frame.
+	 * @return The series approximation. Its `SkippedIterations` is `0` when no iteration can be skipped.
+	 */
+	SeriesApproximation ComputeSeries(double radius, int maxIterations) const;
+
+	/**
+	 * Forgets the orbit, so the next call to `Update` computes it again.
+	 */
+	void Clear() { m_Points.clear(); }
+
+	/**
+	 * Gets the points of the orbit, starting with `Z(0) = 0`.
+	 *
+	 * The orbit ends either after `maxIterations` iterations, or at the first point that escaped.
+	 */
+	const std::vector<glm::dvec2>& GetPoints() const { return m_Points; }
+
+	uint32_t GetLength() const { return (uint32_t)m_Points.size(); }
+
+	/**
+	 * Gets the precision the orbit was computed with, in bits of mantissa.
+	 */
+	uint32_t GetPrecision() const { return m_Precision; }
+private:
+	template<typename Real>
+	void Compute(const BigVec2& center);
+private:
+	/// @brief The points of the orbit, rounded to double precision.
+	std::vector<glm::dvec2> m_Points;
+
+	/// @brief The parameters the orbit was computed with.
+	BigVec2 m_Center;
+	uint32_t m_Precision = 0;
+	int m_MaxIterations = 0;
+	float m_Bailout = 0.0f;
+};
@@ -0,0 +1,109 @@
+#include "TileCache.h"
+
+#include <cmath>
+#include <functional>
+
+// Mixes a value into a hash, like 'boost::hash_combine'
+template<typename T>
+static void HashCombine(size_t& seed, const T& value) {
+	seed ^= std::hash<T>()(value) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+}
+
+TileFractal TileFractal::Create(const KernelParameters& params, const CPURenderingSettings& settings) {
+	TileFractal fractal;
+
+	fractal.Algorithm = params.Algorithm;
+	fractal.Power = params.Power;
+	fractal.Bailout = params.Bailout;
+	fractal.MaxIterations = params.MaxIterations;
+	fractal.JuliaMode = params.JuliaMode;
+	fractal.JuliaC = params.JuliaC;
+	fractal.NeedsDerivative = params.NeedsDerivative;
+
+	fractal.TrapType = params.Trap.Type;
+	fractal.TrapP1 = params.Trap.P1;
+	fractal.TrapP2 = params.Trap.P2;
+
+	fractal.FilledExterior = settings.AreaSkipping != AreaSkippingMode::None && params.ExteriorColoring == ColorAlgorithm::Step && !params.OrbitColoring;
+
+	return fractal;
+}
+
+int TileCache::GetLevel(double pixelSpacing) {
+	return (int)std::ceil(-std::log2(pixelSpacing * (double)TileSize));
+}
+
+double TileCache::GetSampleSpacing(int level) {
+	return std::ldexp(1.0, -level) / (double)TileSize;
+}
+
+size_t TileCache::GetAutomaticCapacity(uint32_t width, uint32_t height) {
+	// The samples of a level are between half a pixel and a pixel apart, so a tile spans at least `TileSize / 2` pixels, and the view may straddle one more tile on each axis
+	const size_t columns = ((size_t)width * 2 + TileSize - 1) / TileSize + 1;
+	const size_t rows = ((size_t)height * 2 + TileSize - 1) / TileSize + 1;
+
+	return columns * rows * TileBytes * AutomaticCapacityViews;
+}
+
+size_t TileCache::KeyHash::operator()(const Key& key) const {
+	const TileFractal& fractal = key.Fractal;
+
+	size_t seed = 0;
+	HashCombine(seed, key.Address.Level);
+	HashCombine(seed, key.Address.X);
+	HashCombine(seed, key.Address.Y);
+	HashCombine(seed, (int)fractal.Algorithm);
+	HashCombine(seed, fractal.Power);
+	HashCombine(seed, fractal.Bailout);
+	HashCombine(seed, fractal.MaxIterations);
+	HashCombine(seed, fractal.JuliaMode);
+	HashCombine(seed, fractal.JuliaC.x);
+	HashCombine(seed, fractal.JuliaC.y);
+	HashCombine(seed, fractal.NeedsDerivative);
+	HashCombine(seed, (int)fractal.TrapType);
+	HashCombine(seed, fractal.TrapP1.x);
+	HashCombine(seed, fractal.TrapP1.y);
+	HashCombine(seed, fractal.TrapP2.x);
+	HashCombine(seed, fractal.TrapP2.y);
+	HashCombine(seed, fractal.FilledExterior);
+
+	return seed;
+}
+
+const OrbitResult* TileCache::Find(const TileFractal& fractal, const TileAddress& address) {
+	const auto it = m_Index.find({ fractal, address });
+	if (it == m_Index.end()) {
+		return nullptr;
+	}
+
+	m_Tiles.splice(m_Tiles.begin(), m_Tiles, it->second);
+
+	return it->second->Orbits.data();
+}
+
+OrbitResult* TileCache::Insert(const TileFractal& fractal, const TileAddress& address) {
+	const Key key{ fractal, address };
+
+	const auto it = m_Index.find(key);
+	if (it != m_Index.end()) {
+		m_Tiles.splice(m_Tiles.begin(), m_Tiles, it->second);
+		return it->second->Orbits.data();
+	}
+
+	m_Tiles.push_front({ key, std::vector<OrbitResult>((size_t)TileSize * TileSize) });
+	m_Index.emplace(key, m_Tiles.begin());
+
+	return m_Tiles.front().Orbits.data();
+}
+
+void TileCache::Trim() {
+	while (!m_Tiles.empty() && GetSize() > m_Capacity) {
+		m_Index.erase(m_Tiles.back().TileKey);
+		m_Tiles.pop_back();
+	}
+}
+
+void TileCache::Clear() {
+	m_Index.clear();
+	m_Tiles.clear();
+}
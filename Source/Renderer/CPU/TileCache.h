@@ -0,0 +1,147 @@
+#pragma once
+
+#include "Core/Settings/Settings.h"
+
+#include "Renderer/CPU/FractalKernel.h"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The parameters of the fractal the orbits of a cached tile depend on: those compared by `Mandelbrot::IsSameFractal`, with the iteration limit of the frame.
+ */
+struct TileFractal {
+	FractalAlgorithm Algorithm = FractalAlgorithm::Mandelbrot;
+	float Power = 2.0f;
+	float Bailout = 16.0f;
+	int MaxIterations = 0;
+	bool JuliaMode = false;
+	glm::vec2 JuliaC = { 0.0f, 0.0f };
+	bool NeedsDerivative = false;
+	OrbitTrapType TrapType = OrbitTrapType::None;
+	glm::vec2 TrapP1 = { 0.0f, 0.0f };
+	glm::vec2 TrapP2 = { 0.0f, 0.0f };
+
+	/// @brief Whether area skipping filled the exterior regions of the tile, which only the `Step` coloring allows (see `AreaSkipping::CanFill`).
+	bool FilledExterior = false;
+
+	/**
+	 * Gets the fractal the tiles of a frame are rendered with.
+	 */
+	static TileFractal Create(const KernelParameters& params, const CPURenderingSettings& settings);
+
+	bool operator==(const TileFractal& other) const = default;
+};
+
+/**
+ * The address of a tile in the quadtree covering the plane.
+ *
+ * The tiles of level `Level` are squares of side `2^-Level`, the tile (X, Y) covering `[X, X + 1) * 2^-Level` by `[Y, Y + 1) * 2^-Level`.
+ * Each tile holds `TileCache::TileSize` by `TileCache::TileSize` samples, so every level halves the spacing of the samples of the level above.
+ */
+struct TileAddress {
+	int Level = 0;
+	int64_t X = 0, Y = 0;
+
+	bool operator==(const TileAddress& other) const = default;
+};
+
+/**
+ * An in-memory cache of the orbits of the tiles of the quadtree, keyed by the fractal and the address of each tile, which evicts the least recently used tiles past its capacity.
+ *
+ * The tiles sample the plane on a grid of their own, independent of the view, so a view returned to (by zooming back in, or loading a preset again) finds its tiles in the cache.
+ * The samples of a tile are the pixels of a `TileSize` by `TileSize` view of it, stored bottom-up like the image.
+ */
+class TileCache {
+public:
+	/// @brief The number of samples along each side of a tile, a power of two.
+	static constexpr uint32_t TileShift = 6;
+	static constexpr uint32_t TileSize = 1u << TileShift;
+
+	/// @brief The memory taken by the orbits of one tile, in bytes.
+	static constexpr size_t TileBytes = (size_t)TileSize * TileSize * sizeof(OrbitResult);
+
+	/// @brief The number of views of the size of the frame the automatic capacity holds.
+	static constexpr uint32_t AutomaticCapacityViews = 3;
+
+	/**
+	 * Gets the level of the quadtree a view is sampled from: the coarsest one whose samples are at most a pixel apart.
+	 *
+	 * @param pixelSpacing The distance between two adjacent pixels of the view, on the complex plane.
+	 */
+	static int GetLevel(double pixelSpacing);
+
+	/**
+	 * Gets the distance between two adjacent samples of a level, on the complex plane.
+	 */
+	static double GetSampleSpacing(int level);
+
+	/**
+	 * Gets the capacity of the cache when none is set (see `CPURenderingSettings::TileCacheSize`): the tiles of `AutomaticCapacityViews` views of the given size,
+	 * sampled at the densest spacing of their level, so the view and those zoomed in and out of it fit.
+	 *
+	 * @return The capacity, in bytes.
+	 */
+	static size_t GetAutomaticCapacity(uint32_t width, uint32_t height);
+
+	/**
+	 * Gets the orbits of a tile, marking it as the most recently used one.
+	 *
+	 * @return The orbits of the tile, or `nullptr` if it is not cached.
+	 */
+	const OrbitResult* Find(const TileFractal& fractal, const TileAddress& address);
+
+	/**
+	 * Adds a tile to the cache, its orbits to be written by the caller. Nothing is evicted until the next call to `Trim`,
+	 * so the orbits of the tiles of a frame stay valid while it is being rendered.
+	 *
+	 * @return The orbits of the tile, `TileSize * TileSize` entries long.
+	 */
+	OrbitResult* Insert(const TileFractal& fractal, const TileAddress& address);
+
+	/**
+	 * Evicts the least recently used tiles until the cache fits in its capacity.
+	 */
+	void Trim();
+
+	/**
+	 * Evicts every tile.
+	 */
+	void Clear();
+
+	/**
+	 * Sets the memory the cache may take, in bytes.
+	 */
+	void SetCapacity(size_t bytes) { m_Capacity = bytes; }
+	size_t GetCapacity() const { return m_Capacity; }
+
+	uint32_t GetTileCount() const { return (uint32_t)m_Tiles.size(); }
+	size_t GetSize() const { return m_Tiles.size() * TileBytes; }
+private:
+	struct Key {
+		TileFractal Fractal;
+		TileAddress Address;
+
+		bool operator==(const Key& other) const = default;
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key& key) const;
+	};
+
+	struct Entry {
+		Key TileKey;
+		std::vector<OrbitResult> Orbits;
+	};
+private:
+	/// @brief The cached tiles, from the most to the least recently used, and where each key is in the list.
+	std::list<Entry> m_Tiles;
+	std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_Index;
+
+	size_t m_Capacity = 0;
+};
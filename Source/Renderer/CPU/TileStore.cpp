@@ -0,0 +1,260 @@
+#include "TileStore.h"
+
+#include "Core/Log.h"
+
+#include <algorithm>
+#include <cstring>
+
+static constexpr char StoreMagic[8] = { 'M', 'B', 'T', 'I', 'L', 'E', 'S', '\0' };
+
+static constexpr uint64_t FNVPrime = 0x100000001b3ull;
+
+// The finalizer of SplitMix64, which spreads every bit of the input over the whole output
+static uint64_t Mix(uint64_t value) {
+	value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+	value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+	return value ^ (value >> 31);
+}
+
+#pragma region - TileKeyBuilder -
+
+TileKeyBuilder& TileKeyBuilder::Add(const BigReal& value) {
+	AddBytes(value.GetMantissa(), BigReal::Bits / 8);
+	Add(value.GetExponent());
+	Add(value.IsNegative());
+	return *this;
+}
+
+TileKeyBuilder& TileKeyBuilder::Add(const BigVec2& value) {
+	Add(value.x);
+	Add(value.y);
+	return *this;
+}
+
+void TileKeyBuilder::AddBytes(const void* data, size_t size) {
+	const uint8_t* bytes = (const uint8_t*)data;
+
+	for (size_t i = 0; i < size; ++i) {
+		m_High = (m_High ^ bytes[i]) * FNVPrime;
+		m_Low = (m_Low ^ bytes[i]) * FNVPrime;
+	}
+}
+
+TileKey TileKeyBuilder::Get() const {
+	return { Mix(m_High), Mix(m_Low ^ m_High) };
+}
+
+#pragma endregion
+
+bool TileStore::Open(const std::filesystem::path& filepath, size_t capacity) {
+	Close();
+
+	const uint32_t slotCount = (uint32_t)(capacity > sizeof(Header) ? (capacity - sizeof(Header)) / SlotSize : 0);
+	if (slotCount == 0) {
+		Log::Warning("TileStore::Open - The capacity of the tile store is too small for a single tile");
+		return false;
+	}
+
+	if (!m_File.Open(filepath, sizeof(Header) + (size_t)slotCount * SlotSize)) {
+		return false;
+	}
+
+	m_SlotCount = slotCount;
+
+	// The slots past the end of a smaller file were added as zeros, so they are free already
+	Header& header = GetHeader();
+	const bool compatible = std::memcmp(header.Magic, StoreMagic, sizeof(StoreMagic)) == 0
+		&& header.Version == Version
+		&& header.TileSize == MaximumTileSize
+		&& header.OrbitSize == (uint32_t)sizeof(OrbitResult);
+
+	const uint32_t keptSlots = compatible ? std::min(header.SlotCount, slotCount) : 0;
+
+	if (!compatible) {
+		std::memcpy(header.Magic, StoreMagic, sizeof(StoreMagic));
+		header.Version = Version;
+		header.TileSize = MaximumTileSize;
+		header.OrbitSize = (uint32_t)sizeof(OrbitResult);
+		header.Clock = 0;
+	}
+
+	header.SlotCount = slotCount;
+
+	m_Index.clear();
+	m_FreeSlots.clear();
+	m_Verified.assign(slotCount, 0);
+	m_Recency.clear();
+	m_RecencyPositions.assign(slotCount, m_Recency.end());
+
+	for (uint32_t slot = 0; slot < slotCount; ++slot) {
+		SlotRecord& record = GetRecord(slot);
+
+		if (slot >= keptSlots) {
+			record.Valid = 0;
+		}
+
+		// A key stored twice (which only a crash in the middle of a write leaves behind) keeps its first slot
+		if (record.Valid && m_Index.emplace(record.Key, slot).second) {
+			continue;
+		}
+
+		record.Valid = 0;
+		m_FreeSlots.push_back(slot);
+	}
+
+	// The free slots are handed out from the back, so the file fills up from its start
+	std::reverse(m_FreeSlots.begin(), m_FreeSlots.end());
+
+	// The recency list is rebuilt once from the clocks of the records, so evictions never scan the slots
+	std::vector<uint32_t> usedSlots;
+	usedSlots.reserve(m_Index.size());
+
+	for (const auto& [key, slot] : m_Index) {
+		usedSlots.push_back(slot);
+	}
+
+	std::sort(usedSlots.begin(), usedSlots.end(), [this](uint32_t a, uint32_t b) { return GetRecord(a).LastUsed > GetRecord(b).LastUsed; });
+
+	for (uint32_t slot : usedSlots) {
+		m_RecencyPositions[slot] = m_Recency.insert(m_Recency.end(), slot);
+	}
+
+	Log::Info("TileStore::Open - Opened '" + filepath.string() + "' with " + std::to_string(m_Index.size()) + " of " + std::to_string(slotCount) + " tiles");
+
+	return true;
+}
+
+void TileStore::Close() {
+	m_File.Close();
+	m_SlotCount = 0;
+
+	m_Index.clear();
+	m_FreeSlots.clear();
+	m_Verified.clear();
+	m_Recency.clear();
+	m_RecencyPositions.clear();
+}
+
+const OrbitResult* TileStore::Find(const TileKey& key, uint32_t width, uint32_t height) {
+	if (!IsOpen()) {
+		return nullptr;
+	}
+
+	const auto it = m_Index.find(key);
+	if (it == m_Index.end()) {
+		return nullptr;
+	}
+
+	const uint32_t slot = it->second;
+	SlotRecord& record = GetRecord(slot);
+
+	if (record.Width != width || record.Height != height) {
+		return nullptr;
+	}
+
+	if (!m_Verified[slot]) {
+		if (record.Checksum != ComputeChecksum(slot)) {
+			Log::Warning("TileStore::Find - Discarding a corrupt tile");
+			ReleaseSlot(slot);
+			return nullptr;
+		}
+
+		m_Verified[slot] = 1;
+	}
+
+	record.LastUsed = ++GetHeader().Clock;
+	TouchSlot(slot);
+
+	return GetOrbits(slot);
+}
+
+void TileStore::Store(const TileKey& key, uint32_t width, uint32_t height, const OrbitResult* orbits, size_t stride) {
+	if (!IsOpen() || width > MaximumTileSize || height > MaximumTileSize) {
+		return;
+	}
+
+	const auto it = m_Index.find(key);
+	const uint32_t slot = it != m_Index.end() ? it->second : AllocateSlot();
+
+	// The record is invalid while the tile is written, and its checksum catches the writes a crash interrupted
+	SlotRecord& record = GetRecord(slot);
+	record.Valid = 0;
+
+	OrbitResult* destination = GetOrbits(slot);
+	for (uint32_t y = 0; y < height; ++y) {
+		std::copy_n(orbits + y * stride, width, destination + (size_t)y * width);
+	}
+
+	record.Key = key;
+	record.Width = width;
+	record.Height = height;
+	record.LastUsed = ++GetHeader().Clock;
+	record.Checksum = ComputeChecksum(slot);
+	record.Valid = 1;
+
+	m_Index[key] = slot;
+	m_Verified[slot] = 1;
+	TouchSlot(slot);
+}
+
+uint64_t TileStore::ComputeChecksum(uint32_t slot) const {
+	const SlotRecord& record = GetRecord(slot);
+
+	TileKeyBuilder builder;
+	builder.Add(record.Key.High).Add(record.Key.Low).Add(record.Width).Add(record.Height);
+
+	// The orbits are summed 8 bytes at a time, FNV-1a style, which is fast enough to verify every tile read
+	const size_t size = (size_t)record.Width * record.Height * sizeof(OrbitResult);
+	const uint8_t* bytes = (const uint8_t*)GetOrbits(slot);
+
+	uint64_t sum = builder.Get().High;
+	size_t i = 0;
+	for (; i + 8 <= size; i += 8) {
+		uint64_t word;
+		std::memcpy(&word, bytes + i, 8);
+		sum = (sum ^ word) * FNVPrime;
+	}
+
+	for (; i < size; ++i) {
+		sum = (sum ^ bytes[i]) * FNVPrime;
+	}
+
+	return Mix(sum);
+}
+
+uint32_t TileStore::AllocateSlot() {
+	if (!m_FreeSlots.empty()) {
+		const uint32_t slot = m_FreeSlots.back();
+		m_FreeSlots.pop_back();
+		return slot;
+	}
+
+	// Every slot holds a tile once none is free, so the recency list is never empty here
+	const uint32_t oldest = m_Recency.back();
+
+	m_Index.erase(GetRecord(oldest).Key);
+
+	return oldest;
+}
+
+void TileStore::ReleaseSlot(uint32_t slot) {
+	SlotRecord& record = GetRecord(slot);
+
+	m_Index.erase(record.Key);
+	record.Valid = 0;
+	m_Verified[slot] = 0;
+	m_FreeSlots.push_back(slot);
+
+	m_Recency.erase(m_RecencyPositions[slot]);
+	m_RecencyPositions[slot] = m_Recency.end();
+}
+
+void TileStore::TouchSlot(uint32_t slot) {
+	auto& position = m_RecencyPositions[slot];
+
+	if (position == m_Recency.end()) {
+		position = m_Recency.insert(m_Recency.begin(), slot);
+	} else {
+		m_Recency.splice(m_Recency.begin(), m_Recency, position);
+	}
+}
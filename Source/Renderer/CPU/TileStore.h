@@ -0,0 +1,159 @@
+#pragma once
+
+#include "Core/BigFloat.h"
+#include "Core/MappedFile.h"
+
+#include "Renderer/CPU/FractalKernel.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A 128-bit digest of everything the orbits of a tile depend on, which identifies the tile in the tile store.
+ */
+struct TileKey {
+	uint64_t High = 0, Low = 0;
+
+	bool operator==(const TileKey& other) const = default;
+};
+
+/**
+ * Builds a `TileKey` from the values a tile depends on, added one by one.
+ *
+ * The values are hashed byte by byte, so structures with padding must be added field by field.
+ */
+class TileKeyBuilder {
+public:
+	template<typename T>
+	TileKeyBuilder& Add(const T& value) {
+		static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be hashed byte by byte");
+		AddBytes(&value, sizeof(T));
+		return *this;
+	}
+
+	TileKeyBuilder& Add(const BigReal& value);
+	TileKeyBuilder& Add(const BigVec2& value);
+
+	void AddBytes(const void* data, size_t size);
+
+	TileKey Get() const;
+private:
+	/// @brief Two FNV-1a hashes with different offset bases, mixed once all the values are added.
+	uint64_t m_High = 0xcbf29ce484222325ull;
+	uint64_t m_Low = 0x84222325cbf29ce4ull;
+};
+
+template<>
+struct std::hash<TileKey> {
+	size_t operator()(const TileKey& key) const { return (size_t)(key.High ^ key.Low); }
+};
+
+/**
+ * A persistent store of tile orbits, kept in a memory-mapped file so the tiles rendered in previous sessions are read in place, without copying or parsing them.
+ *
+ * The file holds a header and a fixed number of slots, as many as its capacity allows. Each slot has a record (the key of its tile, its size, when it was last used
+ * and a checksum) followed by the orbits of the tile. Once the file is full, the least recently used tile is evicted.
+ *
+ * A tile is written in three steps: its record is invalidated, its orbits and record are written, then its checksum is computed and the record is marked valid again.
+ * The checksum is verified the first time a tile is read in a session, so a tile left half written by a crash is discarded rather than used.
+ */
+class TileStore {
+public:
+	/// @brief The largest tile the slots hold, in samples along each side.
+	static constexpr uint32_t MaximumTileSize = 64;
+
+	/**
+	 * Opens the store, creating its file if needed.
+	 *
+	 * A file of another capacity keeps the tiles of the slots still in range. A file of another format (or that is not a tile store at all) is cleared.
+	 *
+	 * @param filepath The path of the file of the store.
+	 * @param capacity The size of the file, in bytes.
+	 * @return `true` if the store was opened.
+	 */
+	bool Open(const std::filesystem::path& filepath, size_t capacity);
+
+	/**
+	 * Writes the pending changes back to the file and closes it.
+	 */
+	void Close();
+
+	bool IsOpen() const { return m_File.IsOpen(); }
+
+	/**
+	 * Finds a tile, marking it as the most recently used one.
+	 *
+	 * @return The orbits of the tile, in rows of `width` orbits, read in place from the file until the next call to `Store`. `nullptr` if the tile is not stored, or failed its integrity check.
+	 */
+	const OrbitResult* Find(const TileKey& key, uint32_t width, uint32_t height);
+
+	/**
+	 * Stores a tile, replacing the least recently used tile if the store is full.
+	 *
+	 * @param orbits The orbits of the tile, in rows of `stride` orbits.
+	 */
+	void Store(const TileKey& key, uint32_t width, uint32_t height, const OrbitResult* orbits, size_t stride);
+
+	uint32_t GetTileCount() const { return (uint32_t)m_Index.size(); }
+	size_t GetSize() const { return m_File.GetSize(); }
+private:
+	/// @brief Bumped whenever the layout of the file or the orbits computed by the kernels change, which clears the stores of previous versions.
+	static constexpr uint32_t Version = 2;
+
+	struct Header {
+		char Magic[8];
+		uint32_t Version;
+		uint32_t TileSize;
+		uint32_t OrbitSize;
+		uint32_t SlotCount;
+		uint64_t Clock;
+		uint8_t Padding[32];
+	};
+
+	struct SlotRecord {
+		TileKey Key;
+		uint64_t LastUsed;
+		uint64_t Checksum;
+		uint32_t Width, Height;
+		uint32_t Valid;
+		uint8_t Padding[20];
+	};
+
+	static_assert(sizeof(Header) == 64 && sizeof(SlotRecord) == 64, "The header and the records are laid out on cache lines");
+
+	static constexpr size_t PayloadSize = (size_t)MaximumTileSize * MaximumTileSize * sizeof(OrbitResult);
+	static constexpr size_t SlotSize = sizeof(SlotRecord) + PayloadSize;
+private:
+	Header& GetHeader() const { return *(Header*)m_File.GetData(); }
+	SlotRecord& GetRecord(uint32_t slot) const { return *(SlotRecord*)(m_File.GetData() + sizeof(Header) + (size_t)slot * SlotSize); }
+	OrbitResult* GetOrbits(uint32_t slot) const { return (OrbitResult*)(m_File.GetData() + sizeof(Header) + (size_t)slot * SlotSize + sizeof(SlotRecord)); }
+
+	/// @brief The checksum of a slot, covering its key, its size and its orbits.
+	uint64_t ComputeChecksum(uint32_t slot) const;
+
+	/// @brief Finds the slot a new tile goes to: a free one, or the least recently used one.
+	uint32_t AllocateSlot();
+
+	void ReleaseSlot(uint32_t slot);
+
+	/// @brief Moves a slot holding a tile to the front of the recency list, adding it if it was free.
+	void TouchSlot(uint32_t slot);
+private:
+	MappedFile m_File;
+	uint32_t m_SlotCount = 0;
+
+	/// @brief The slot of every valid tile, the free slots, and whether each slot passed its integrity check in this session.
+	std::unordered_map<TileKey, uint32_t> m_Index;
+	std::vector<uint32_t> m_FreeSlots;
+	std::vector<uint8_t> m_Verified;
+
+	/// @brief The slots holding a tile, from the most to the least recently used, and where each slot is in the list (`end` for free slots).
+	/// The `LastUsed` clocks of the records only carry this order over to the next session.
+	std::list<uint32_t> m_Recency;
+	std::vector<std::list<uint32_t>::iterator> m_RecencyPositions;
+};
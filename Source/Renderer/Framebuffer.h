@@ -4,10 +4,13 @@
 
 #include "Renderer/Texture.h"
 
+#include <vector>
+
 struct FramebufferSpecification {
 	uint32_t Width = 0;
 	uint32_t Height = 0;
 	TextureSpecification ColorAttachmentSpecification;
+	std::vector<TextureSpecification> AdditionalColorAttachmentSpecifications; // Drawn to by the outputs after the first one
 	TextureSpecification DepthAttachmentSpecification;
 	bool HasDepthAttachment = false;
 };
@@ -21,7 +24,7 @@ public:
 
 	virtual void Resize(uint32_t width, uint32_t height) = 0;
 
-	virtual Ref<Texture2D> GetColorAttachment() const = 0;
+	virtual Ref<Texture2D> GetColorAttachment(uint32_t index = 0) const = 0;
 	virtual Ref<Texture2D> GetDepthAttachment() const = 0;
 
 	virtual uint32_t GetHandle() const = 0;
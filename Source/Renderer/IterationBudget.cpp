@@ -0,0 +1,131 @@
+#include "IterationBudget.h"
+
+#include "Core/CPUFeatures.h"
+
+#include "Renderer/CPU/FractalKernel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+int IterationBudget::Resolve(const Mandelbrot& mandelbrot) {
+	const int limit = Peek(mandelbrot);
+
+	// The limit now accounts for the statistics, or started over from the estimate, at the current zoom
+	if (mandelbrot.AutoIterations && (IsRestart(mandelbrot) || HasStatistics())) {
+		s_Zoom = mandelbrot.Zoom;
+	}
+
+	// A manual budget drops the statistics too, so the next automatic budget starts over from the depth estimate
+	s_HasStatistics = false;
+	s_Automatic = mandelbrot.AutoIterations;
+	s_Limit = limit;
+
+	return s_Limit;
+}
+
+int IterationBudget::Peek(const Mandelbrot& mandelbrot) {
+	if (!mandelbrot.AutoIterations) {
+		return mandelbrot.MaxIterations;
+	}
+
+	if (IsRestart(mandelbrot)) {
+		return Estimate(mandelbrot);
+	}
+
+	if (HasStatistics()) {
+		return Adjust(mandelbrot, s_Statistics);
+	}
+
+	return std::clamp(s_Limit, MinimumIterations, GetCeiling(mandelbrot));
+}
+
+int IterationBudget::Estimate(const Mandelbrot& mandelbrot) {
+	// Deeper views need more iterations for their pixels to escape, roughly in proportion to the number of times the view was magnified
+	const double octaves = std::max(0.0, std::log2(mandelbrot.Zoom));
+	const int limit = (int)std::min((double)GetCeiling(mandelbrot), BaseIterations + IterationsPerOctave * octaves);
+
+	return std::clamp(limit, MinimumIterations, GetCeiling(mandelbrot));
+}
+
+int IterationBudget::Adjust(const Mandelbrot& mandelbrot, const EscapeStatistics& statistics) {
+	int limit = statistics.Limit;
+
+	const double pixels = (double)statistics.Pixels;
+	const bool lateEscapes = (double)statistics.LateEscapes > LateEscapeTolerance * pixels;
+	const bool unescaped = (double)statistics.Unescaped > UnescapedTolerance * pixels;
+
+	// Pixels stuck at the limit may escape past it, so they raise it like late escapes do. Pixels proven interior never escape, so they leave it alone.
+	// The limit only shrinks when pixels escaped and nearly none were left unresolved at it, as the highest escape says nothing about the pixels beyond the limit.
+	if (lateEscapes || unescaped) {
+		limit = statistics.Limit * 2;
+	} else if (statistics.HighestEscape > 0 && statistics.HighestEscape * 2 < statistics.Limit) {
+		limit = statistics.HighestEscape * 2;
+	}
+
+	return std::clamp(limit, MinimumIterations, GetCeiling(mandelbrot));
+}
+
+bool IterationBudget::IsRestart(const Mandelbrot& mandelbrot) {
+	// The statistics of a view far from the current one say little about it, so the budget starts over from the depth estimate
+	return !s_Automatic || std::abs(std::log2(mandelbrot.Zoom / s_Zoom)) > MaximumZoomOctaves;
+}
+
+void IterationBudget::Report(const EscapeStatistics& statistics) {
+	s_Statistics = statistics;
+	s_HasStatistics = true;
+}
+
+void IterationBudget::Probe(const Mandelbrot& mandelbrot, uint32_t width, uint32_t height) {
+	if (width == 0 || height == 0) {
+		return;
+	}
+
+	if (width == s_ProbedWidth && height == s_ProbedHeight && mandelbrot.HasSameOrbits(s_ProbedView)) {
+		s_ProbePending = false;
+		return;
+	}
+
+	// Probing every frame of an animation would stall the main thread for views gone by the next frame, so only a view that stayed for a frame is probed
+	const bool settled = width == s_LastWidth && height == s_LastHeight && mandelbrot.HasSameOrbits(s_LastView);
+
+	s_LastView = mandelbrot;
+	s_LastWidth = width;
+	s_LastHeight = height;
+	s_ProbePending = !settled;
+
+	if (!settled) {
+		return;
+	}
+
+	s_ProbedView = mandelbrot;
+	s_ProbedWidth = width;
+	s_ProbedHeight = height;
+
+	const KernelParameters params = KernelParameters::Create(mandelbrot, width, height);
+
+	// The grid samples the center of evenly sized cells, so its pixels are spread over the whole frame
+	const uint32_t columns = std::min(ProbeColumns, width);
+	const uint32_t rows = std::min(ProbeRows, height);
+
+	std::vector<glm::uvec2> pixels;
+	pixels.reserve((size_t)columns * rows);
+
+	for (uint32_t row = 0; row < rows; ++row) {
+		for (uint32_t column = 0; column < columns; ++column) {
+			pixels.emplace_back((2 * column + 1) * width / (2 * columns), (2 * row + 1) * height / (2 * rows));
+		}
+	}
+
+	std::vector<OrbitResult> results(pixels.size());
+	FractalKernel::IteratePixels(params, CPUFeatures::GetBestInstructionSet(), pixels.data(), (uint32_t)pixels.size(), results.data());
+
+	EscapeStatistics statistics;
+	statistics.Limit = params.MaxIterations;
+
+	for (const OrbitResult& result : results) {
+		statistics.Add(result.Iterations, result.ProvenInterior);
+	}
+
+	Report(statistics);
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "Layers/Mandelbrot/Mandelbrot.h"
+
+#include <algorithm>
+#include <cstdint>
+
+/**
+ * How the pixels of a frame escaped, which tells whether its iteration limit was too low or needlessly high.
+ */
+struct EscapeStatistics {
+	/// @brief The iteration limit the pixels were iterated with.
+	int Limit = 0;
+
+	/// @brief The number of pixels sampled.
+	uint64_t Pixels = 0;
+
+	/// @brief The number of pixels that escaped in the last quarter of the limit, hinting at more pixels escaping just past it.
+	uint64_t LateEscapes = 0;
+
+	/// @brief The number of pixels that reached the limit without escaping nor being proven interior: pixels the limit may be too low for.
+	uint64_t Unescaped = 0;
+
+	/// @brief The largest iteration count of the pixels that escaped.
+	int HighestEscape = 0;
+
+	/**
+	 * Accounts for one pixel.
+	 *
+	 * @param iterations The iteration count of the pixel. Pixels that reached the limit never escaped.
+	 * @param provenInterior Whether the pixel was proven never to escape (see `OrbitResult::ProvenInterior`), so the limit has nothing to do with it.
+	 */
+	void Add(int iterations, bool provenInterior) {
+		++Pixels;
+
+		if (iterations >= Limit) {
+			Unescaped += provenInterior ? 0 : 1;
+			return;
+		}
+
+		if (iterations >= Limit - Limit / 4) {
+			++LateEscapes;
+		}
+
+		if (iterations > HighestEscape) {
+			HighestEscape = iterations;
+		}
+	}
+
+	/**
+	 * Accounts for the pixels of another sample taken with the same limit.
+	 */
+	void Merge(const EscapeStatistics& other) {
+		Pixels += other.Pixels;
+		LateEscapes += other.LateEscapes;
+		Unescaped += other.Unescaped;
+
+		if (other.HighestEscape > HighestEscape) {
+			HighestEscape = other.HighestEscape;
+		}
+	}
+};
+
+/**
+ * Picks the iteration limit of each frame when the fractal asks for an automatic budget (see `Mandelbrot::AutoIterations`).
+ *
+ * The limit starts from an estimate that grows with the zoom depth, then follows the escape statistics of the previous frame:
+ * it doubles while too many pixels escape close to it or run out of iterations without being proven interior, and shrinks back when every pixel escaped well below it.
+ * A jump of the zoom (like loading another view) starts over from the estimate.
+ * `Mandelbrot::MaxIterations` is the ceiling of the automatic budget.
+ *
+ * The CPU engine reports the statistics of the whole frame. The OpenGL engine cannot, so a coarse grid of the frame is probed with the CPU kernel instead.
+ */
+class IterationBudget {
+public:
+	/**
+	 * Gets the iteration limit of the next frame.
+	 *
+	 * @param mandelbrot The fractal to render.
+	 * @return The automatic limit, or `MaxIterations` when the budget is manual.
+	 */
+	static int Resolve(const Mandelbrot& mandelbrot);
+
+	/**
+	 * Gets the iteration limit `Resolve` would return for the next frame, without consuming the statistics.
+	 */
+	static int Peek(const Mandelbrot& mandelbrot);
+
+	/**
+	 * Gets the limit the automatic budget starts from for a view, from its zoom depth alone.
+	 */
+	static int Estimate(const Mandelbrot& mandelbrot);
+
+	/**
+	 * Gets the limit the automatic budget moves to after a frame: raised while too many pixels escape close to the limit of the frame or reach it unresolved,
+	 * lowered when they all escaped well below it.
+	 *
+	 * Unlike `Resolve`, neither function reads or updates the state of the budget, so they can be used by renders independent from the frames of the application.
+	 *
+	 * @param statistics The escape statistics of the frame.
+	 */
+	static int Adjust(const Mandelbrot& mandelbrot, const EscapeStatistics& statistics);
+
+	/**
+	 * Feeds the escape statistics of a frame rendered with the limit returned by `Resolve`.
+	 */
+	static void Report(const EscapeStatistics& statistics);
+
+	/**
+	 * Samples a coarse grid of the frame with the CPU kernel, for the engines that cannot gather escape statistics themselves.
+	 *
+	 * The probe runs on the main thread, so it waits for the view to settle: a view that changed since the last call (like every frame of an animation) is not probed,
+	 * and neither is a view already probed, as it would find the same statistics.
+	 *
+	 * @param mandelbrot The fractal being rendered, with the limit of the frame.
+	 * @param width The width of the frame in pixels.
+	 * @param height The height of the frame in pixels.
+	 */
+	static void Probe(const Mandelbrot& mandelbrot, uint32_t width, uint32_t height);
+
+	/// @brief Whether the last view passed to `Probe` is waiting for the next call to be probed, once it stayed unchanged for a frame.
+	static bool IsProbePending() { return s_ProbePending; }
+
+	/// @brief Whether the last resolved limit was automatic.
+	static bool IsAutomatic() { return s_Automatic; }
+
+	/// @brief The last resolved limit.
+	static int GetLimit() { return s_Limit; }
+private:
+	/// @brief The smallest limit the budget goes down to, and the estimate it starts from at a zoom of 1.
+	static constexpr int MinimumIterations = 32;
+	static constexpr int BaseIterations = 128;
+
+	/// @brief The iterations added to the estimate each time the zoom doubles.
+	static constexpr int IterationsPerOctave = 32;
+
+	/// @brief How far, in doublings, the zoom may move away from the last statistics before the budget starts over from the estimate.
+	static constexpr double MaximumZoomOctaves = 4.0;
+
+	/// @brief The fraction of the pixels allowed to escape in the last quarter of the limit before it is raised.
+	static constexpr double LateEscapeTolerance = 0.001;
+
+	/// @brief The fraction of the pixels allowed to reach the limit unresolved (neither escaped nor proven interior) before it is raised.
+	static constexpr double UnescapedTolerance = 0.01;
+
+	/// @brief The size of the grid probed for the OpenGL engine.
+	static constexpr uint32_t ProbeColumns = 64;
+	static constexpr uint32_t ProbeRows = 36;
+private:
+	/// @brief The highest limit of the automatic budget.
+	static int GetCeiling(const Mandelbrot& mandelbrot) { return std::max(mandelbrot.MaxIterations, MinimumIterations); }
+
+	/// @brief Whether the automatic budget starts over from the depth estimate for the given view.
+	static bool IsRestart(const Mandelbrot& mandelbrot);
+
+	/// @brief Whether statistics are waiting to be consumed by `Resolve`.
+	static bool HasStatistics() { return s_HasStatistics && s_Statistics.Pixels > 0; }
+private:
+	inline static bool s_Automatic = false;
+	inline static int s_Limit = 0;
+
+	/// @brief The zoom of the last statistics.
+	inline static double s_Zoom = 1.0;
+
+	/// @brief The statistics of the previous frame, until the next call to `Resolve` consumes them.
+	inline static EscapeStatistics s_Statistics;
+	inline static bool s_HasStatistics = false;
+
+	/// @brief The view of the last probe.
+	inline static Mandelbrot s_ProbedView;
+	inline static uint32_t s_ProbedWidth = 0, s_ProbedHeight = 0;
+
+	/// @brief The view of the last call to `Probe`, which it must match for the view to be settled.
+	inline static Mandelbrot s_LastView;
+	inline static uint32_t s_LastWidth = 0, s_LastHeight = 0;
+	inline static bool s_ProbePending = false;
+};
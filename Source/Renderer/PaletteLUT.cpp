@@ -0,0 +1,17 @@
+#include "PaletteLUT.h"
+
+bool PaletteLUT::Update(const Palette& palette) {
+	if (m_IsBaked && palette.Colors == m_Colors) {
+		return false;
+	}
+
+	// The first and last samples fall on both ends of the gradient
+	for (uint32_t i = 0; i < Size; ++i) {
+		m_Samples[i] = glm::vec4(palette.Evaluate((float)i / (float)(Size - 1)), 1.0f);
+	}
+
+	m_Colors = palette.Colors;
+	m_IsBaked = true;
+
+	return true;
+}
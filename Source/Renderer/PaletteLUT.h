@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Layers/Mandelbrot/Palette.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A palette baked into evenly spaced samples of its gradient, so the coloring looks a color up in constant time, however many colors the palette has.
+ *
+ * The samples are stored as RGBA (the alpha being unused) and aligned to cache lines, ready to be uploaded to a texture as they are.
+ * Each engine keeps its own table, rebuilt only when the colors of the palette change.
+ */
+class PaletteLUT {
+public:
+	/// @brief The number of samples of the gradient.
+	static constexpr uint32_t Size = 1024;
+
+	/**
+	 * Bakes the palette into the table, unless its colors did not change since the last call.
+	 *
+	 * @param palette The palette to bake.
+	 * @return `true` if the table was rebuilt, `false` otherwise.
+	 */
+	bool Update(const Palette& palette);
+
+	/**
+	 * Interpolates the gradient at `t` between its two nearest samples, like a linearly filtered texture.
+	 *
+	 * @param t The position in the gradient, between `0` and `1`.
+	 * @return The color of the gradient.
+	 */
+	glm::vec3 Sample(float t) const {
+		const float position = std::clamp(t, 0.0f, 1.0f) * (float)(Size - 1);
+		const uint32_t i = std::min((uint32_t)position, Size - 2);
+
+		return glm::mix(glm::vec3(m_Samples[i]), glm::vec3(m_Samples[i + 1]), position - (float)i);
+	}
+
+	/// @brief The `Size` samples of the table.
+	const glm::vec4* GetData() const { return m_Samples; }
+private:
+	alignas(64) glm::vec4 m_Samples[Size] = {};
+
+	/// @brief The colors the table was baked from.
+	std::vector<glm::vec3> m_Colors;
+	bool m_IsBaked = false;
+};
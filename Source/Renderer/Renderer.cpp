@@ -1,11 +1,18 @@
 #include "Renderer.h"
 
 #include "Core/Application.h"
+#include "Core/FrameTimings.h"
+#include "Core/Image.h"
 #include "Core/Log.h"
+#include "Core/Profiler.h"
 #include "Core/Settings/SettingsManager.h"
+
+#include "Renderer/Supersampling.h"
+
 #include <glm/gtc/type_ptr.hpp>
 
-#include "stb_image_write.h"
+#include <algorithm>
+#include <chrono>
 
 void Renderer::Init() {
 	Log::Trace("Renderer::Init - Initializing the Renderer");
@@ -15,6 +22,10 @@ void Renderer::Init() {
 	InitVertexArray();
 	InitShader();
 
+	for (auto& timerQuery : s_TimerQueries) {
+		timerQuery = TimerQuery::Create();
+	}
+
 	RenderCommand::EnableDepthTest(true);
 }
 
@@ -22,6 +33,22 @@ void Renderer::Shutdown() {
 	Log::Trace("Renderer::Shutdown - Shutting down the Renderer");
 
 	s_Framebuffer.reset();
+	s_IterationFramebuffer.reset();
+	s_PreviousIterationFramebuffer.reset();
+	s_SampleMaskFramebuffer.reset();
+	s_SampleFramebuffer.reset();
+	s_AccumulationFramebuffer.reset();
+	s_PreviousAccumulationFramebuffer.reset();
+	s_HistogramTexture.reset();
+	s_HistogramCDFTexture.reset();
+	s_PaletteTexture.reset();
+	s_CPURenderer.reset();
+
+	for (auto& timerQuery : s_TimerQueries) {
+		timerQuery.reset();
+	}
+
+	s_PendingTimerQueries = 0;
 }
 
 void Renderer::Begin() {
@@ -37,57 +64,463 @@ void Renderer::End() {
 	s_Framebuffer->Unbind();
 }
 
-void Renderer::Submit(const Mandelbrot& mandelbrot) {
-	if (!m_Shader || ! m_QuadVA) {
+void Renderer::Submit(const Mandelbrot& mandelbrot, bool settled) {
+	MB_PROFILE_SCOPE("Renderer::Submit");
+
+	const auto& rendering = SettingsManager::Get().Rendering;
+
+	// Deep views are beyond the precision of the shader, so they are handed over to the perturbation path of the CPU engine
+	const bool perturbation = rendering.CPU.Perturbation && mandelbrot.SupportsPerturbation() && s_Framebuffer && mandelbrot.RequiresPerturbation(s_Framebuffer->GetHeight());
+
+	s_ActiveEngine = perturbation ? RenderingEngine::CPU : rendering.Engine;
+
+	// With an automatic budget, the frame is rendered with the limit picked from the previous frames
+	Mandelbrot frame = mandelbrot;
+	frame.MaxIterations = IterationBudget::Resolve(mandelbrot);
+
+	const auto start = std::chrono::steady_clock::now();
+	s_FramePassIterations = 0.0;
+
+	const Ref<TimerQuery> timerQuery = s_PendingTimerQueries < TimerQueryCount ? s_TimerQueries[s_NextTimerQuery] : nullptr;
+	if (timerQuery) {
+		timerQuery->Begin();
+	}
+
+	switch (s_ActiveEngine) {
+		case RenderingEngine::CPU:
+			SubmitCPU(frame, settled);
+			break;
+		case RenderingEngine::OpenGL:
+		default:
+			SubmitOpenGL(frame);
+			break;
+	}
+
+	const uint64_t pixels = s_Framebuffer ? (uint64_t)s_Framebuffer->GetWidth() * s_Framebuffer->GetHeight() : 0;
+	const bool cpu = s_ActiveEngine == RenderingEngine::CPU && s_CPURenderer;
+
+	if (timerQuery) {
+		timerQuery->End();
+
+		s_TimerQueryPixels[s_NextTimerQuery] = cpu ? 0 : pixels;
+		s_TimerQueryPassIterations[s_NextTimerQuery] = s_FramePassIterations;
+		s_NextTimerQuery = (s_NextTimerQuery + 1) % TimerQueryCount;
+		++s_PendingTimerQueries;
+	}
+
+	// The OpenGL engine only queues its passes, so its pixels are timed on the GPU. A frame reusing its orbits did not iterate any.
+	const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+	const CPURenderStatistics* statistics = cpu ? &s_CPURenderer->GetStatistics() : nullptr;
+
+	FrameTimings::ReportRender(elapsed.count(), cpu ? pixels : 0, statistics && !statistics->ReusedOrbits ? statistics->Iterations : 0);
+
+	s_SubmittedFractal = frame;
+	s_SubmittedWidth = s_Framebuffer ? s_Framebuffer->GetWidth() : 0;
+	s_SubmittedHeight = s_Framebuffer ? s_Framebuffer->GetHeight() : 0;
+	s_SubmittedEngine = rendering.Engine;
+	s_SubmittedOpenGLSettings = rendering.OpenGL;
+	s_SubmittedCPUSettings = rendering.CPU;
+	s_SubmittedSupersampling = rendering.Supersampling;
+	s_HasSubmitted = true;
+}
+
+bool Renderer::IsUpToDate(const Mandelbrot& mandelbrot) {
+	if (!s_HasSubmitted || !s_Framebuffer) {
+		return false;
+	}
+
+	// Resizing the framebuffer discards its image
+	if (s_Framebuffer->GetWidth() != s_SubmittedWidth || s_Framebuffer->GetHeight() != s_SubmittedHeight) {
+		return false;
+	}
+
+	const auto& rendering = SettingsManager::Get().Rendering;
+	if (rendering.Engine != s_SubmittedEngine || rendering.OpenGL != s_SubmittedOpenGLSettings || rendering.CPU != s_SubmittedCPUSettings || rendering.Supersampling != s_SubmittedSupersampling) {
+		return false;
+	}
+
+	// A view snapped to the pixel grid while panning, or rendered over several frames, still has to be finished
+	const bool complete = s_ActiveEngine == RenderingEngine::CPU
+		? s_CPURenderer && s_CPURenderer->IsComplete()
+		: s_OrbitFractal.Position == s_RequestedPosition && s_ProgressivePass == ProgressivePasses;
+
+	if (!complete) {
+		return false;
+	}
+
+	// The automatic budget may still move the limit of an unchanged view, after the statistics of the last frame
+	Mandelbrot frame = mandelbrot;
+	frame.MaxIterations = IterationBudget::Peek(mandelbrot);
+
+	// The OpenGL engine probes a view for the budget once it settled, which takes one more submission of the same view
+	if (frame.AutoIterations && s_ActiveEngine == RenderingEngine::OpenGL && IterationBudget::IsProbePending()) {
+		return false;
+	}
+
+	return frame == s_SubmittedFractal;
+}
+
+void Renderer::CollectTimings() {
+	// The queries finish in the order they were issued, so the oldest one is polled first
+	while (s_PendingTimerQueries > 0) {
+		const int index = (s_NextTimerQuery - s_PendingTimerQueries + TimerQueryCount) % TimerQueryCount;
+		const Ref<TimerQuery>& timerQuery = s_TimerQueries[index];
+
+		if (!timerQuery || !timerQuery->IsAvailable()) {
+			break;
+		}
+
+		const double elapsed = timerQuery->GetElapsedTime();
+		FrameTimings::ReportGPUTime(elapsed, s_TimerQueryPixels[index]);
+
+		// The whole frame is timed, coloring included, which only overestimates the passes
+		if (s_TimerQueryPassIterations[index] > 0.0) {
+			s_PassIterationTime = elapsed / s_TimerQueryPassIterations[index];
+		}
+
+		--s_PendingTimerQueries;
+	}
+}
+
+void Renderer::SubmitOpenGL(const Mandelbrot& mandelbrot) {
+	if (!m_IterationShader || !m_ColoringShader || !m_QuadVA) {
 		return;
 	}
 
-	const float& width = (float)s_Framebuffer->GetWidth();
-	const float& height = (float)s_Framebuffer->GetHeight();
+	const uint32_t width = s_Framebuffer->GetWidth();
+	const uint32_t height = s_Framebuffer->GetHeight();
+
+	// The iteration buffer follows the size of the viewport, and so do the buffers of supersampling
+	if (s_IterationFramebuffer->GetWidth() != width || s_IterationFramebuffer->GetHeight() != height) {
+		s_IterationFramebuffer->Resize(width, height);
+		s_PreviousIterationFramebuffer->Resize(width, height);
+		s_SampleMaskFramebuffer->Resize(width, height);
+		s_SampleFramebuffer->Resize(width, height);
+		s_AccumulationFramebuffer->Resize(width, height);
+		s_PreviousAccumulationFramebuffer->Resize(width, height);
+		s_HasOrbits = false;
+	}
+
+	const auto& rendering = SettingsManager::Get().Rendering;
+
+	// A view being panned is snapped to the pixel grid of the previous frame, whose orbits then only need shifting. The previews of progressive rendering are not worth shifting.
+	Mandelbrot frame = mandelbrot;
+	glm::ivec2 pan(0);
+	const bool panned = s_HasOrbits && s_ProgressivePass == ProgressivePasses && frame.SnapToPixelGrid(s_OrbitFractal, s_RequestedPosition, width, height, pan);
+	s_RequestedPosition = mandelbrot.Position;
+
+	// Coloring changes leave the orbits of the previous frame valid, so only the coloring pass runs again
+	if (!s_HasOrbits || !frame.HasSameOrbits(s_OrbitFractal)) {
+		// A new view rendered progressively starts from its first pass, run below with the following ones
+		if (rendering.OpenGL.Progressive && !panned) {
+			s_ProgressivePass = 0;
+		} else {
+			IterateOpenGL(frame, panned, pan);
+			s_ProgressivePass = ProgressivePasses;
+		}
+
+		s_OrbitFractal = frame;
+		s_HasOrbits = true;
+		s_HasHistogram = false;
+	}
+
+	// Turning progressive rendering off finishes the view in this frame
+	if (s_ProgressivePass < ProgressivePasses) {
+		ProgressOpenGL(frame, rendering.OpenGL.Progressive ? rendering.FrameBudget : 0.0f);
+		s_HasHistogram = false;
+	}
+
+	// The cumulative histogram only depends on the orbits, so it is built once for every iterated frame
+	if (frame.ExteriorColoring == ColorAlgorithm::Histogram && !s_HasHistogram) {
+		BuildHistogramOpenGL(frame);
+		s_HasHistogram = true;
+	}
+
+	ColorOpenGL(frame);
 
-	m_Shader->Bind();
+	// The previews of a view rendered over several frames are replaced anyway, so only the final image is supersampled
+	const auto& supersampling = rendering.Supersampling;
+	if (supersampling.Enabled && m_SampleMaskShader && s_ProgressivePass == ProgressivePasses) {
+		SupersampleOpenGL(frame, supersampling);
+	}
+
+	// The shader cannot report how its pixels escaped, so the automatic budget probes the frame on the CPU
+	if (frame.AutoIterations) {
+		IterationBudget::Probe(frame, width, height);
+	}
+}
+
+void Renderer::IterateOpenGL(const Mandelbrot& mandelbrot, bool reuseOrbits, const glm::ivec2& reuseOffset) {
+	// The orbits of the previous frame stay in the other buffer, for the pixels still on screen to be copied from
+	std::swap(s_IterationFramebuffer, s_PreviousIterationFramebuffer);
+
+	s_IterationFramebuffer->Bind();
+	SetIterationUniforms(mandelbrot);
+
+	s_PreviousIterationFramebuffer->GetColorAttachment(0)->Bind(0);
+	s_PreviousIterationFramebuffer->GetColorAttachment(1)->Bind(1);
+	m_IterationShader->SetUniform("u_ReuseOrbits", reuseOrbits);
+	m_IterationShader->SetUniform("u_ReuseOffset", reuseOffset);
+	m_IterationShader->SetUniform("u_Progressive", false);
+
+	// Every pixel is iterated at its center
+	m_IterationShader->SetUniform("u_SampleOffset", glm::vec2(0.0f));
+	m_IterationShader->SetUniform("u_UseSampleMask", false);
+
+	RenderCommand::DrawIndexed(m_QuadVA);
+
+	// Back to the framebuffer of the frame, for the coloring pass
+	s_Framebuffer->Bind();
+}
+
+void Renderer::ProgressOpenGL(const Mandelbrot& mandelbrot, float frameBudget) {
+	const int remaining = ProgressivePasses - s_ProgressivePass;
+	int passes = remaining;
+
+	// The GPU runs the passes after the frame is submitted, so their time is estimated from the previous frames, in proportion to the iteration limit.
+	// Until a frame was measured, a single pass runs per frame.
+	if (frameBudget > 0.0f) {
+		const double passTime = s_PassIterationTime * (double)std::max(mandelbrot.MaxIterations, 1);
+		const int affordable = passTime > 0.0 ? (int)std::min((double)frameBudget / passTime, (double)ProgressivePasses) : 1;
+
+		passes = std::clamp(affordable, 1, remaining);
+	}
+
+	// The first pass is drawn on its own, whatever the budget, so the pixels of the following ones have a pixel of their block to show until they are iterated
+	if (s_ProgressivePass == 0) {
+		IteratePassesOpenGL(mandelbrot, 0, 1);
+		IteratePassesOpenGL(mandelbrot, 1, passes);
+	} else {
+		IteratePassesOpenGL(mandelbrot, s_ProgressivePass, s_ProgressivePass + passes);
+	}
+
+	s_ProgressivePass += passes;
+	s_FramePassIterations += (double)passes * (double)std::max(mandelbrot.MaxIterations, 1);
+}
+
+void Renderer::IteratePassesOpenGL(const Mandelbrot& mandelbrot, int passBegin, int passEnd) {
+	// Every draw reads the orbits of the one before, so the buffers are swapped like for a panned view
+	std::swap(s_IterationFramebuffer, s_PreviousIterationFramebuffer);
+
+	s_IterationFramebuffer->Bind();
+	SetIterationUniforms(mandelbrot);
+
+	s_PreviousIterationFramebuffer->GetColorAttachment(0)->Bind(0);
+	s_PreviousIterationFramebuffer->GetColorAttachment(1)->Bind(1);
+	m_IterationShader->SetUniform("u_ReuseOrbits", false);
+	m_IterationShader->SetUniform("u_Progressive", true);
+	m_IterationShader->SetUniform("u_PassBegin", passBegin);
+	m_IterationShader->SetUniform("u_PassEnd", passEnd);
+
+	m_IterationShader->SetUniform("u_SampleOffset", glm::vec2(0.0f));
+	m_IterationShader->SetUniform("u_UseSampleMask", false);
+
+	RenderCommand::DrawIndexed(m_QuadVA);
+
+	s_Framebuffer->Bind();
+}
+
+void Renderer::SetIterationUniforms(const Mandelbrot& mandelbrot) {
+	const float width = (float)s_Framebuffer->GetWidth();
+	const float height = (float)s_Framebuffer->GetHeight();
+
+	m_IterationShader->Bind();
 
 	// View and Calculation
-	m_Shader->SetUniform("u_Resolution", glm::vec2(width, height));
-	m_Shader->SetUniform("u_Zoom", mandelbrot.Zoom);
-	m_Shader->SetUniform("u_Position", mandelbrot.Position);
-	m_Shader->SetUniform("u_Rotation", glm::radians(mandelbrot.Rotation));
-	m_Shader->SetUniform("u_MaxIterations", mandelbrot.MaxIterations);
-	m_Shader->SetUniform("u_Bailout", mandelbrot.Bailout);
-	m_Shader->SetUniform("u_Algorithm", static_cast<int>(mandelbrot.Algorithm));
-	m_Shader->SetUniform("u_Power", mandelbrot.Power);
+	const glm::dvec2 position(mandelbrot.Position);
+
+	m_IterationShader->SetUniform("u_Resolution", glm::vec2(width, height));
+	m_IterationShader->SetUniform("u_Zoom", (float)mandelbrot.Zoom);
+	m_IterationShader->SetUniform("u_Position", glm::vec2(position));
+
+	// Past the limits of single precision, the shader iterates in double precision
+	m_IterationShader->SetUniform("u_UseDoublePrecision", mandelbrot.RequiresDoublePrecision((uint32_t)height));
+	m_IterationShader->SetUniform("u_DoubleZoom", mandelbrot.Zoom);
+	m_IterationShader->SetUniform("u_DoublePosition", position);
+	m_IterationShader->SetUniform("u_Rotation", glm::radians(mandelbrot.Rotation));
+	m_IterationShader->SetUniform("u_MaxIterations", mandelbrot.MaxIterations);
+	m_IterationShader->SetUniform("u_Bailout", mandelbrot.Bailout);
+	m_IterationShader->SetUniform("u_Algorithm", static_cast<int>(mandelbrot.Algorithm));
+	m_IterationShader->SetUniform("u_RejectInterior", mandelbrot.SupportsInteriorRejection());
+	m_IterationShader->SetUniform("u_Power", mandelbrot.Power);
+	m_IterationShader->SetUniform("u_NeedsDerivative", mandelbrot.NeedsDerivative());
 
 	// Julia
-	m_Shader->SetUniform("u_JuliaMode", mandelbrot.JuliaMode);
-	m_Shader->SetUniform("u_JuliaC", mandelbrot.JuliaC);
+	m_IterationShader->SetUniform("u_JuliaMode", mandelbrot.JuliaMode);
+	m_IterationShader->SetUniform("u_JuliaC", mandelbrot.JuliaC);
 
-	// Coloration
-	m_Shader->SetUniform("u_ExteriorColoring", static_cast<int>(mandelbrot.ExteriorColoring));
-	m_Shader->SetUniform("u_InteriorColoring", static_cast<int>(mandelbrot.InteriorColoring));
-	m_Shader->SetUniform("u_InteriorColor", mandelbrot.InteriorColor);
-	m_Shader->SetUniform("u_ColorFrequency", mandelbrot.ColorFrequency);
-	m_Shader->SetUniform("u_ColorOffset", mandelbrot.ColorOffset);
-	m_Shader->SetUniform("u_OrbitColoring", mandelbrot.OrbitColoring);
-	m_Shader->SetUniform("u_DistanceScale", mandelbrot.DistanceScale);
+	// Orbit Trap
+	m_IterationShader->SetUniform("u_TrapType", static_cast<int>(mandelbrot.Trap.Type));
+	m_IterationShader->SetUniform("u_TrapP1", mandelbrot.Trap.P1);
+	m_IterationShader->SetUniform("u_TrapP2", mandelbrot.Trap.P2);
+}
+
+void Renderer::ColorOpenGL(const Mandelbrot& mandelbrot) {
+	SetColoringUniforms(mandelbrot);
+
+	s_IterationFramebuffer->GetColorAttachment(0)->Bind(0);
+	s_IterationFramebuffer->GetColorAttachment(1)->Bind(1);
+	m_ColoringShader->SetUniform("u_Accumulate", false);
+
+	RenderCommand::DrawIndexed(m_QuadVA);
+}
 
-	// Pallette
-	m_Shader->SetUniform("u_ColorCount", mandelbrot.ColorPalette.ColorCount);
-	if (mandelbrot.ColorPalette.ColorCount > 0) {
-		m_Shader->UploadUniformVec3Array("u_Colors", mandelbrot.ColorPalette.ColorData, mandelbrot.ColorPalette.ColorCount);
-		m_Shader->UploadUniformFloatArray("u_ColorPositions", mandelbrot.ColorPalette.ColorPositions, mandelbrot.ColorPalette.ColorCount);
+void Renderer::SetColoringUniforms(const Mandelbrot& mandelbrot) {
+	m_ColoringShader->Bind();
+
+	s_HistogramCDFTexture->Bind(2);
+
+	// Calculation
+	m_ColoringShader->SetUniform("u_MaxIterations", mandelbrot.MaxIterations);
+	m_ColoringShader->SetUniform("u_Power", mandelbrot.Power);
+
+	// Coloration
+	m_ColoringShader->SetUniform("u_ExteriorColoring", static_cast<int>(mandelbrot.ExteriorColoring));
+	m_ColoringShader->SetUniform("u_InteriorColoring", static_cast<int>(mandelbrot.InteriorColoring));
+	m_ColoringShader->SetUniform("u_InteriorColor", mandelbrot.InteriorColor);
+	m_ColoringShader->SetUniform("u_ColorFrequency", mandelbrot.ColorFrequency);
+	m_ColoringShader->SetUniform("u_ColorOffset", mandelbrot.ColorOffset);
+	m_ColoringShader->SetUniform("u_OrbitColoring", mandelbrot.OrbitColoring);
+	m_ColoringShader->SetUniform("u_DistanceScale", mandelbrot.DistanceScale);
+	m_ColoringShader->SetUniform("u_HistogramBins", mandelbrot.GetHistogramBinCount());
+
+	// Pallette, only uploaded again when its colors change
+	if (s_PaletteLUT.Update(mandelbrot.ColorPalette)) {
+		s_PaletteTexture->SetData(s_PaletteLUT.GetData(), TextureFormat::RGBA32F);
 	}
 
+	s_PaletteTexture->Bind(3);
+
 	// Orbit Trap
-	m_Shader->SetUniform("u_TrapType", static_cast<int>(mandelbrot.Trap.Type));
-	m_Shader->SetUniform("u_TrapP1", mandelbrot.Trap.P1);
-	m_Shader->SetUniform("u_TrapP2", mandelbrot.Trap.P2);
-	m_Shader->SetUniform("u_TrapColor", mandelbrot.Trap.Color);
-	m_Shader->SetUniform("u_TrapBlend", mandelbrot.Trap.Blend);
+	m_ColoringShader->SetUniform("u_TrapType", static_cast<int>(mandelbrot.Trap.Type));
+	m_ColoringShader->SetUniform("u_TrapColor", mandelbrot.Trap.Color);
+	m_ColoringShader->SetUniform("u_TrapBlend", mandelbrot.Trap.Blend);
+}
+
+void Renderer::SupersampleOpenGL(const Mandelbrot& mandelbrot, const SupersamplingSettings& supersampling) {
+	const uint32_t height = s_Framebuffer->GetHeight();
+
+	// The mask pass compares every pixel with its neighbours, on the orbits and the colors of the frame
+	s_SampleMaskFramebuffer->Bind();
+	m_SampleMaskShader->Bind();
+
+	s_IterationFramebuffer->GetColorAttachment(0)->Bind(0);
+	s_IterationFramebuffer->GetColorAttachment(1)->Bind(1);
+	s_Framebuffer->GetColorAttachment(0)->Bind(2);
+
+	m_SampleMaskShader->SetUniform("u_MaxIterations", mandelbrot.MaxIterations);
+	m_SampleMaskShader->SetUniform("u_ColorThreshold", supersampling.ColorThreshold);
+	m_SampleMaskShader->SetUniform("u_IterationThreshold", supersampling.IterationThreshold);
+	m_SampleMaskShader->SetUniform("u_UseDistance", mandelbrot.NeedsDerivative());
+	m_SampleMaskShader->SetUniform("u_PixelSpacing", (float)mandelbrot.GetPixelSpacing(height));
 
 	RenderCommand::DrawIndexed(m_QuadVA);
+
+	// The uniforms of the fractal are the same for every sample
+	SetIterationUniforms(mandelbrot);
+	m_IterationShader->SetUniform("u_ReuseOrbits", false);
+	m_IterationShader->SetUniform("u_Progressive", false);
+	m_IterationShader->SetUniform("u_UseSampleMask", true);
+
+	SetColoringUniforms(mandelbrot);
+	m_ColoringShader->SetUniform("u_Accumulate", true);
+
+	const int grid = Supersampling::GetGrid(supersampling);
+	const int sampleCount = Supersampling::GetSampleCount(supersampling);
+
+	for (int sample = 0; sample < sampleCount; ++sample) {
+		const bool last = sample == sampleCount - 1;
+
+		// The samples render to buffers of their own, so the textures they read are never the ones being drawn to
+		s_SampleFramebuffer->Bind();
+		m_IterationShader->Bind();
+
+		s_IterationFramebuffer->GetColorAttachment(0)->Bind(0);
+		s_IterationFramebuffer->GetColorAttachment(1)->Bind(1);
+		s_SampleMaskFramebuffer->GetColorAttachment(0)->Bind(2);
+		m_IterationShader->SetUniform("u_SampleOffset", Supersampling::GetSampleOffset(grid, sample));
+
+		RenderCommand::DrawIndexed(m_QuadVA);
+
+		// The first sample adds its color to the one of the frame, the following ones to the sum of the samples before them
+		std::swap(s_AccumulationFramebuffer, s_PreviousAccumulationFramebuffer);
+		const Ref<Texture2D> accumulated = sample == 0 ? s_Framebuffer->GetColorAttachment(0) : s_PreviousAccumulationFramebuffer->GetColorAttachment(0);
+
+		// The last sample writes the average back into the frame, drawn over it again
+		if (last) {
+			s_Framebuffer->Bind();
+			RenderCommand::ClearDepth();
+		} else {
+			s_AccumulationFramebuffer->Bind();
+		}
+
+		m_ColoringShader->Bind();
+
+		s_SampleFramebuffer->GetColorAttachment(0)->Bind(0);
+		s_SampleFramebuffer->GetColorAttachment(1)->Bind(1);
+		s_HistogramCDFTexture->Bind(2);
+		s_PaletteTexture->Bind(3);
+		s_SampleMaskFramebuffer->GetColorAttachment(0)->Bind(4);
+		accumulated->Bind(5);
+		m_ColoringShader->SetUniform("u_ColorScale", last ? 1.0f / (float)(sampleCount + 1) : 1.0f);
+
+		RenderCommand::DrawIndexed(m_QuadVA);
+	}
+}
+
+void Renderer::BuildHistogramOpenGL(const Mandelbrot& mandelbrot) {
+	const uint32_t width = s_IterationFramebuffer->GetWidth();
+	const uint32_t height = s_IterationFramebuffer->GetHeight();
+	const int bins = mandelbrot.GetHistogramBinCount();
+
+	// Each workgroup counts a tile into its own histogram in shared memory, then adds it to the histogram of the frame
+	m_HistogramShader->Bind();
+	s_IterationFramebuffer->GetColorAttachment(0)->Bind(0);
+	s_HistogramTexture->BindToImageUnit(0, true, true);
+
+	m_HistogramShader->SetUniform("u_MaxIterations", mandelbrot.MaxIterations);
+	m_HistogramShader->SetUniform("u_HistogramBins", bins);
+
+	RenderCommand::DispatchCompute((width + HistogramTileSize - 1) / HistogramTileSize, (height + HistogramTileSize - 1) / HistogramTileSize, 1);
+
+	// A single workgroup scans the histogram into the cumulative histogram
+	m_HistogramScanShader->Bind();
+	s_HistogramTexture->BindToImageUnit(0, true, true);
+	s_HistogramCDFTexture->BindToImageUnit(1, false, true);
+
+	m_HistogramScanShader->SetUniform("u_HistogramBins", bins);
+
+	RenderCommand::DispatchCompute(1, 1, 1);
+}
+
+void Renderer::SubmitCPU(const Mandelbrot& mandelbrot, bool settled) {
+	if (!s_Framebuffer) {
+		return;
+	}
+
+	// The worker threads are only spawned the first time the CPU engine is used.
+	if (!s_CPURenderer) {
+		s_CPURenderer = CreateScope<CPURenderer>();
+		Log::Info("Renderer::SubmitCPU - CPU Renderer running on " + std::to_string(s_CPURenderer->GetThreadCount()) + " threads");
+	}
+
+	const uint32_t width = s_Framebuffer->GetWidth();
+	const uint32_t height = s_Framebuffer->GetHeight();
+
+	const auto& rendering = SettingsManager::Get().Rendering;
+	s_CPURenderer->Render(mandelbrot, width, height, rendering.CPU, rendering.FrameBudget, rendering.Supersampling, settled);
+
+	if (mandelbrot.AutoIterations) {
+		IterationBudget::Report(s_CPURenderer->GetStatistics().Escapes);
+	}
+
+	// The CPU image is stored bottom-up, so it can be copied straight into the color attachment.
+	s_Framebuffer->GetColorAttachment()->SetData(s_CPURenderer->GetPixels().data(), TextureFormat::RGBA8);
 }
 
 void Renderer::ExportFrame(const std::filesystem::path& filepath) {
+	MB_PROFILE_SCOPE("Renderer::ExportFrame");
+
 	if (!s_Framebuffer) {
 		Log::Error("Renderer::ExportFrame - Cannot export, framebuffer is null.");
 		return;
@@ -112,34 +545,8 @@ void Renderer::ExportFrame(const std::filesystem::path& filepath) {
 	// Stop using the framebuffer.
 	s_Framebuffer->Unbind();
 
-	// Tell STB to flip the image vertically when saving it.
-	// This is necessary because the OpenGL coordinate system(0, 0 down) is
-	// inverted compared to most image formats(0, 0 up).
-	stbi_flip_vertically_on_write(1);
-
 	const auto& exportSettings = SettingsManager::Get().Export;
-	const std::string pathStr = filepath.string();
-
-	switch (exportSettings.ImageFormat) {
-		case ExportImageFormat::JPEG: {
-			// JPEG does not support an alpha channel; drop it to RGB first.
-			std::vector<uint8_t> rgb(width * height * 3);
-			for (uint32_t i = 0; i < width * height; ++i) {
-				rgb[i * 3 + 0] = pixels[i * 4 + 0];
-				rgb[i * 3 + 1] = pixels[i * 4 + 1];
-				rgb[i * 3 + 2] = pixels[i * 4 + 2];
-			}
-			stbi_write_jpg(pathStr.c_str(), width, height, 3, rgb.data(), exportSettings.ImageQuality);
-			break;
-		}
-		case ExportImageFormat::BMP:
-			stbi_write_bmp(pathStr.c_str(), width, height, 4, pixels.data());
-			break;
-		case ExportImageFormat::PNG:
-		default:
-			stbi_write_png(pathStr.c_str(), width, height, 4, pixels.data(), width * 4);
-			break;
-	}
+	Image::Write(filepath, width, height, pixels.data(), exportSettings.ImageFormat, exportSettings.ImageQuality);
 }
 
 void Renderer::InitFramebuffer() {
@@ -166,6 +573,67 @@ void Renderer::InitFramebuffer() {
 
 	Log::Trace("Renderer::InitFramebuffer - Creating the Framebuffer");
 	s_Framebuffer = Framebuffer::Create(fbSpec);
+
+	// The iteration buffer stores raw orbits, which must be neither filtered nor rounded
+	Log::Trace("Renderer::InitFramebuffer - Setting up the Iteration Framebuffer");
+	TextureSpecification orbitSpec;
+	orbitSpec.Format = TextureFormat::RGBA32F;
+	orbitSpec.MinFilter = TextureFilter::Nearest;
+	orbitSpec.MagFilter = TextureFilter::Nearest;
+	orbitSpec.WrapS = TextureWrap::ClampToEdge;
+	orbitSpec.WrapT = TextureWrap::ClampToEdge;
+	orbitSpec.GenerateMips = false;
+
+	TextureSpecification derivativeSpec = orbitSpec;
+	derivativeSpec.Format = TextureFormat::R32F;
+
+	FramebufferSpecification iterationSpec;
+	iterationSpec.Width = fbSpec.Width;
+	iterationSpec.Height = fbSpec.Height;
+	iterationSpec.ColorAttachmentSpecification = orbitSpec;
+	iterationSpec.AdditionalColorAttachmentSpecifications = { derivativeSpec };
+
+	Log::Trace("Renderer::InitFramebuffer - Creating the Iteration Framebuffer");
+	s_IterationFramebuffer = Framebuffer::Create(iterationSpec);
+	s_PreviousIterationFramebuffer = Framebuffer::Create(iterationSpec);
+
+	// Supersampling iterates its samples like the frame, and sums their colors in full precision
+	Log::Trace("Renderer::InitFramebuffer - Creating the Supersampling Framebuffers");
+	s_SampleFramebuffer = Framebuffer::Create(iterationSpec);
+
+	FramebufferSpecification sampleMaskSpec = iterationSpec;
+	sampleMaskSpec.ColorAttachmentSpecification = derivativeSpec;
+	sampleMaskSpec.AdditionalColorAttachmentSpecifications.clear();
+	s_SampleMaskFramebuffer = Framebuffer::Create(sampleMaskSpec);
+
+	FramebufferSpecification accumulationSpec = sampleMaskSpec;
+	accumulationSpec.ColorAttachmentSpecification = orbitSpec;
+	s_AccumulationFramebuffer = Framebuffer::Create(accumulationSpec);
+	s_PreviousAccumulationFramebuffer = Framebuffer::Create(accumulationSpec);
+
+	Log::Trace("Renderer::InitFramebuffer - Creating the Histogram Textures");
+	TextureSpecification histogramSpec = orbitSpec;
+	histogramSpec.Width = MAX_HISTOGRAM_BINS;
+	histogramSpec.Height = 1;
+	histogramSpec.Format = TextureFormat::R32UI;
+	s_HistogramTexture = Texture2D::Create(histogramSpec);
+
+	// The scan clears the histogram after reading it, so it only starts out cleared here
+	const std::vector<uint32_t> emptyHistogram(MAX_HISTOGRAM_BINS, 0);
+	s_HistogramTexture->SetData(emptyHistogram.data(), TextureFormat::R32UI);
+
+	TextureSpecification cdfSpec = histogramSpec;
+	cdfSpec.Width = MAX_HISTOGRAM_BINS + 1;
+	cdfSpec.Format = TextureFormat::R32F;
+	s_HistogramCDFTexture = Texture2D::Create(cdfSpec);
+
+	Log::Trace("Renderer::InitFramebuffer - Creating the Palette Texture");
+	TextureSpecification paletteSpec = cdfSpec;
+	paletteSpec.Width = PaletteLUT::Size;
+	paletteSpec.Format = TextureFormat::RGBA32F;
+	paletteSpec.MinFilter = TextureFilter::Linear;
+	paletteSpec.MagFilter = TextureFilter::Linear;
+	s_PaletteTexture = Texture2D::Create(paletteSpec);
 }
 
 void Renderer::InitVertexArray() {
@@ -198,8 +666,21 @@ void Renderer::InitVertexArray() {
 void Renderer::InitShader() {
 	Log::Trace("Renderer::InitFramebuffer - Initializing Shader");
 
-	m_Shader = Shader::CreateGraphics(
+	m_IterationShader = Shader::CreateGraphics(
+		"Internal/Shaders/Mandelbrot/Mandelbrot.vert",
+		"Internal/Shaders/Mandelbrot/Iteration.frag"
+	);
+
+	m_ColoringShader = Shader::CreateGraphics(
 		"Internal/Shaders/Mandelbrot/Mandelbrot.vert",
-		"Internal/Shaders/Mandelbrot/Mandelbrot.frag"
+		"Internal/Shaders/Mandelbrot/Coloring.frag"
 	);
+
+	m_SampleMaskShader = Shader::CreateGraphics(
+		"Internal/Shaders/Mandelbrot/Mandelbrot.vert",
+		"Internal/Shaders/Mandelbrot/SampleMask.frag"
+	);
+
+	m_HistogramShader = Shader::CreateCompute("Internal/Shaders/Mandelbrot/Histogram.comp");
+	m_HistogramScanShader = Shader::CreateCompute("Internal/Shaders/Mandelbrot/HistogramScan.comp");
 }
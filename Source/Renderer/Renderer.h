@@ -2,11 +2,17 @@
 
 #include "Renderer/RenderCommand.h"
 #include "Renderer/Framebuffer.h"
+#include "Renderer/IterationBudget.h"
+#include "Renderer/PaletteLUT.h"
 #include "Renderer/Shader.h"
+#include "Renderer/TimerQuery.h"
 #include "Renderer/VertexArray.h"
 
+#include "Renderer/CPU/CPURenderer.h"
+
 #include "Layers/Mandelbrot/Mandelbrot.h"
 
+#include <array>
 #include <filesystem>
 
 class Renderer {
@@ -17,16 +23,119 @@ public:
 	static void Begin();
 	static void End();
 
-	static void Submit(const Mandelbrot& mandelbrot);
+	// Renders the fractal. 'settled' tells whether the view stopped moving, as the frames of an animation are not worth keeping in the tile store of the CPU engine.
+	static void Submit(const Mandelbrot& mandelbrot, bool settled = true);
+
+	// Whether the framebuffer already holds the final image of the fractal, so the frame does not need rendering:
+	// nothing changed since the last one (the fractal, the iteration limit, the size or the rendering settings), and that one was not a preview.
+	static bool IsUpToDate(const Mandelbrot& mandelbrot);
 	static void ExportFrame(const std::filesystem::path& filepath);
 
+	// Reports the GPU time of the submitted frames the GPU has finished since the last call (see 'FrameTimings'), without waiting for the others. Called once per frame.
+	static void CollectTimings();
+
 	static Ref<Framebuffer> GetFramebuffer() { return s_Framebuffer; }
+
+	// Only valid once the CPU engine has rendered a frame; returns nullptr otherwise.
+	static const CPURenderer* GetCPURenderer() { return s_CPURenderer.get(); }
+
+	// The engine that rendered the last frame, which differs from the settings when a deep view is handed over to the CPU engine.
+	static RenderingEngine GetActiveEngine() { return s_ActiveEngine; }
 private:
 	static void InitFramebuffer();
 	static void InitVertexArray();
 	static void InitShader();
+
+	static void SubmitOpenGL(const Mandelbrot& mandelbrot);
+	static void SubmitCPU(const Mandelbrot& mandelbrot, bool settled);
+
+	// The two passes of the OpenGL engine: the iteration pass stores the orbit of every pixel, which the coloring pass turns into colors.
+	// When panning, the iteration pass copies the orbits still on screen from the previous frame, shifted by 'reuseOffset' pixels.
+	static void IterateOpenGL(const Mandelbrot& mandelbrot, bool reuseOrbits, const glm::ivec2& reuseOffset);
+	static void ColorOpenGL(const Mandelbrot& mandelbrot);
+
+	// Runs the next passes of progressive rendering (see 'OpenGLRenderingSettings::Progressive') that fit in 'frameBudget' milliseconds of GPU time, at least one.
+	// With a budget of 0, the view is finished in this frame.
+	static void ProgressOpenGL(const Mandelbrot& mandelbrot, float frameBudget);
+
+	// Iterates the pixels of the passes '[passBegin, passEnd)' of progressive rendering, the others copying their orbit from the previous iteration buffer.
+	static void IteratePassesOpenGL(const Mandelbrot& mandelbrot, int passBegin, int passEnd);
+
+	// Bind the shader of each pass and set the uniforms of the fractal, shared by the passes of the frame and the sample passes of supersampling.
+	static void SetIterationUniforms(const Mandelbrot& mandelbrot);
+	static void SetColoringUniforms(const Mandelbrot& mandelbrot);
+
+	// Antialiases the colored frame (see 'SupersamplingSettings'): a mask pass flags the pixels to supersample, then every extra sample is iterated and colored
+	// for the flagged pixels only, its color added to those of the samples before it. The last sample writes the average back into the framebuffer.
+	static void SupersampleOpenGL(const Mandelbrot& mandelbrot, const SupersamplingSettings& supersampling);
+
+	// Builds the cumulative iteration histogram of the iteration buffer on the GPU, for 'ColorAlgorithm::Histogram'.
+	static void BuildHistogramOpenGL(const Mandelbrot& mandelbrot);
 private:
+	// The size of the square of pixels each workgroup of 'Histogram.comp' counts
+	static constexpr uint32_t HistogramTileSize = 64;
+
+	// The number of passes of progressive rendering, each one iterating a pixel in every 8x8 block (see 'Iteration.frag')
+	static constexpr int ProgressivePasses = 64;
+
 	inline static Ref<Framebuffer> s_Framebuffer = nullptr;
 	inline static Ref<VertexArray> m_QuadVA = nullptr;
-	inline static Ref<Shader> m_Shader = nullptr;
+	inline static Ref<Shader> m_IterationShader = nullptr;
+	inline static Ref<Shader> m_ColoringShader = nullptr;
+
+	// The orbits of the last frame iterated by the OpenGL engine, and the fractal they belong to
+	inline static Ref<Framebuffer> s_IterationFramebuffer = nullptr;
+	inline static Mandelbrot s_OrbitFractal;
+	inline static bool s_HasOrbits = false;
+
+	// The passes of progressive rendering the orbits went through, all of them once the view is finished
+	inline static int s_ProgressivePass = ProgressivePasses;
+
+	// The orbits of the frame before, which a panned view copies its pixels still on screen from, and the position the last frame was requested at
+	inline static Ref<Framebuffer> s_PreviousIterationFramebuffer = nullptr;
+	inline static BigVec2 s_RequestedPosition;
+
+	// The iteration histogram (cleared again by the scan) and the cumulative histogram of the iteration buffer, built once for every iterated frame
+	inline static Ref<Shader> m_HistogramShader = nullptr;
+	inline static Ref<Shader> m_HistogramScanShader = nullptr;
+	inline static Ref<Texture2D> s_HistogramTexture = nullptr;
+	inline static Ref<Texture2D> s_HistogramCDFTexture = nullptr;
+	inline static bool s_HasHistogram = false;
+
+	// The pixels flagged for supersampling, the orbits of the sample being iterated, and the sums of the colors of the samples so far (read from one, written to the other)
+	inline static Ref<Shader> m_SampleMaskShader = nullptr;
+	inline static Ref<Framebuffer> s_SampleMaskFramebuffer = nullptr;
+	inline static Ref<Framebuffer> s_SampleFramebuffer = nullptr;
+	inline static Ref<Framebuffer> s_AccumulationFramebuffer = nullptr;
+	inline static Ref<Framebuffer> s_PreviousAccumulationFramebuffer = nullptr;
+
+	// The palette of the last frame, baked into a lookup table and uploaded to a texture
+	inline static PaletteLUT s_PaletteLUT;
+	inline static Ref<Texture2D> s_PaletteTexture = nullptr;
+
+	// The last fractal submitted, with its iteration limit, and what it was rendered with
+	inline static Mandelbrot s_SubmittedFractal;
+	inline static uint32_t s_SubmittedWidth = 0, s_SubmittedHeight = 0;
+	inline static RenderingEngine s_SubmittedEngine = RenderingEngine::OpenGL;
+	inline static OpenGLRenderingSettings s_SubmittedOpenGLSettings;
+	inline static CPURenderingSettings s_SubmittedCPUSettings;
+	inline static SupersamplingSettings s_SubmittedSupersampling;
+	inline static bool s_HasSubmitted = false;
+
+	// The GPU time of the submitted frames, measured by queries read back a few frames later. A frame finding every query still in flight is not measured, rather than waiting for the GPU.
+	// Each query keeps the number of pixels its frame rendered on the GPU (none for the CPU engine, which only uploads its image).
+	static constexpr int TimerQueryCount = 4;
+	inline static std::array<Ref<TimerQuery>, TimerQueryCount> s_TimerQueries;
+	inline static std::array<uint64_t, TimerQueryCount> s_TimerQueryPixels = {};
+	inline static int s_NextTimerQuery = 0;
+	inline static int s_PendingTimerQueries = 0;
+
+	// The progressive passes of the frame being submitted and of each query, weighed by the iteration limit they ran with, which the GPU time of a pass is estimated from.
+	// The time of a pass per iteration of the limit follows from the last query that ran passes (0 until one is read back), so a view with a higher limit gets fewer passes per frame straight away.
+	inline static double s_FramePassIterations = 0.0;
+	inline static std::array<double, TimerQueryCount> s_TimerQueryPassIterations = {};
+	inline static double s_PassIterationTime = 0.0;
+
+	inline static Scope<CPURenderer> s_CPURenderer = nullptr;
+	inline static RenderingEngine s_ActiveEngine = RenderingEngine::OpenGL;
 };
\ No newline at end of file
@@ -21,10 +21,16 @@ public:
 			UploadUniformInt(name, value);
 		} else if constexpr (std::is_same_v<T, float>) {
 			UploadUniformFloat(name, value);
+		} else if constexpr (std::is_same_v<T, double>) {
+			UploadUniformDouble(name, value);
 		} else if constexpr (std::is_same_v<T, bool>) {
 			UploadUniformBool(name, value);
 		} else if constexpr (std::is_same_v<T, glm::vec2>) {
 			UploadUniformVec2(name, value);
+		} else if constexpr (std::is_same_v<T, glm::ivec2>) {
+			UploadUniformIVec2(name, value);
+		} else if constexpr (std::is_same_v<T, glm::dvec2>) {
+			UploadUniformDVec2(name, value);
 		} else if constexpr (std::is_same_v<T, glm::vec3>) {
 			UploadUniformVec3(name, value);
 		} else if constexpr (std::is_same_v<T, glm::vec4>) {
@@ -44,8 +50,11 @@ public:
 private:
 	virtual void UploadUniformInt(const std::string& name, int value) = 0;
 	virtual void UploadUniformFloat(const std::string& name, float value) = 0;
+	virtual void UploadUniformDouble(const std::string& name, double value) = 0;
 	virtual void UploadUniformBool(const std::string& name, bool value) = 0;
 	virtual void UploadUniformVec2(const std::string& name, const glm::vec2& value) = 0;
+	virtual void UploadUniformIVec2(const std::string& name, const glm::ivec2& value) = 0;
+	virtual void UploadUniformDVec2(const std::string& name, const glm::dvec2& value) = 0;
 	virtual void UploadUniformVec3(const std::string& name, const glm::vec3& value) = 0;
 	virtual void UploadUniformVec4(const std::string& name, const glm::vec4& value) = 0;
 	virtual void UploadUniformMat4(const std::string& name, const glm::mat4& value) = 0;
@@ -0,0 +1,24 @@
+#include "Supersampling.h"
+
+#include <algorithm>
+#include <cmath>
+
+int Supersampling::GetGrid(const SupersamplingSettings& settings) {
+	return std::clamp(settings.Grid, MinGrid, MaxGrid);
+}
+
+int Supersampling::GetSampleCount(const SupersamplingSettings& settings) {
+	const int grid = GetGrid(settings);
+	return grid * grid;
+}
+
+glm::vec2 Supersampling::GetSampleOffset(int grid, int index) {
+	// The R2 sequence (built on the plastic number) jitters the samples of neighbouring cells differently, without any visible pattern
+	const float jitterX = std::fmod(0.5f + 0.7548776662f * (float)index, 1.0f);
+	const float jitterY = std::fmod(0.5f + 0.5698402909f * (float)index, 1.0f);
+
+	const float cellX = (float)(index % grid);
+	const float cellY = (float)(index / grid);
+
+	return glm::vec2((cellX + jitterX) / (float)grid - 0.5f, (cellY + jitterY) / (float)grid - 0.5f);
+}
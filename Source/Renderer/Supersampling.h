@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Core/Settings/Settings.h"
+
+#include <glm/glm.hpp>
+
+/**
+ * The sample pattern of adaptive supersampling (see `SupersamplingSettings`), shared by both rendering engines so they antialias the same way.
+ *
+ * The extra samples of a pixel are stratified: the pixel is split into a grid of cells, each one holding a sample jittered inside it.
+ * The jitter follows a low-discrepancy sequence, so it is the same for every pixel and every frame, and a still image does not flicker.
+ */
+class Supersampling {
+public:
+	/// @brief The range of `SupersamplingSettings::Grid`.
+	static constexpr int MinGrid = 2;
+	static constexpr int MaxGrid = 8;
+
+	/**
+	 * Gets the number of cells along each side of the grid, clamped to the supported range.
+	 */
+	static int GetGrid(const SupersamplingSettings& settings);
+
+	/**
+	 * Gets the number of extra samples of a supersampled pixel.
+	 */
+	static int GetSampleCount(const SupersamplingSettings& settings);
+
+	/**
+	 * Gets the offset of an extra sample from the pixel center, in pixels, each coordinate within `[-0.5, 0.5)`.
+	 *
+	 * @param grid The number of cells along each side of the grid.
+	 * @param index The index of the sample, below `grid * grid`.
+	 */
+	static glm::vec2 GetSampleOffset(int grid, int index);
+};
@@ -17,6 +17,8 @@ public:
 
 	virtual void Bind(uint32_t slot = 0) const = 0;
 	virtual void BindToImageUnit(uint32_t unit, bool read, bool write) = 0;
+
+	virtual void SetData(const void* data, TextureFormat dataFormat) = 0;
 };
 
 class Texture2D : public Texture {
@@ -11,6 +11,9 @@ enum class TextureFormat {
 	RGB8,
 	RGBA8,
 	RGBA16F,
+	R32F,
+	RGBA32F,
+	R32UI,
 	// Depth/Stencil Format
 	Depth24Stencil8
 };
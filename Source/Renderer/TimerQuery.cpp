@@ -0,0 +1,19 @@
+#include "TimerQuery.h"
+
+#include "Core/Log.h"
+
+#include "Renderer/RendererAPI.h"
+
+#include "Platform/OpenGL/OpenGLTimerQuery.h"
+
+Ref<TimerQuery> TimerQuery::Create() {
+	Log::Trace("TimerQuery::Create - Creating Timer Query");
+
+	switch (RendererAPI::GetAPI()) {
+		case RendererAPI::API::OpenGL:	return CreateRef<OpenGLTimerQuery>();
+	}
+
+	Log::Error("TimerQuery::Create - Unknown Renderer API");
+
+	return nullptr;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Core/Core.h"
+
+/**
+ * Measures the time the GPU spends on the commands issued between `Begin` and `End`.
+ *
+ * The result is only known once the GPU has run the commands, usually a few frames later, so it is polled with `IsAvailable` rather than waited for.
+ */
+class TimerQuery {
+public:
+	virtual ~TimerQuery() = default;
+
+	virtual void Begin() = 0;
+	virtual void End() = 0;
+
+	/// @brief Whether the GPU has finished the measured commands, so reading the result will not stall.
+	virtual bool IsAvailable() const = 0;
+
+	/// @brief The time the measured commands took on the GPU, in milliseconds.
+	virtual double GetElapsedTime() const = 0;
+
+	static Ref<TimerQuery> Create();
+};
@@ -7,6 +7,7 @@ std::string Utilities::RenderingEngineToString(const RenderingEngine& engine) {
 		case RenderingEngine::OpenGL:	return "OpenGL";
 		case RenderingEngine::DirectX:	return "DirectX";
 		case RenderingEngine::Vulkan:	return "Vulkan";
+		case RenderingEngine::CPU:		return "CPU";
 		default:						return "Unknown";
 	}
 }
@@ -15,6 +16,7 @@ RenderingEngine Utilities::StringToRenderingEngine(const std::string& engine) {
 	if (engine == "OpenGL")		return RenderingEngine::OpenGL;
 	if (engine == "DirectX")	return RenderingEngine::DirectX;
 	if (engine == "Vulkan")		return RenderingEngine::Vulkan;
+	if (engine == "CPU")		return RenderingEngine::CPU;
 
 	Log::Error("Utilities::StringToRenderingEngine - Unknown Rendering Engine");
 
@@ -160,6 +162,7 @@ std::string Utilities::ColorAlgorithmToString(const ColorAlgorithm& algorithm) {
 		case ColorAlgorithm::Step:					return "Step";
 		case ColorAlgorithm::Smooth:				return "Smooth";
 		case ColorAlgorithm::DistanceEstimation:	return "Distance Estimation";
+		case ColorAlgorithm::Histogram:				return "Histogram";
 		default:									return "Unknown";
 	}
 }
@@ -168,6 +171,7 @@ ColorAlgorithm Utilities::StringToColorAlgorithm(const std::string& algorithm) {
 	if (algorithm == "Step")				return ColorAlgorithm::Step;
 	if (algorithm == "Smooth")				return ColorAlgorithm::Smooth;
 	if (algorithm == "Distance Estimation")	return ColorAlgorithm::DistanceEstimation;
+	if (algorithm == "Histogram")			return ColorAlgorithm::Histogram;
 
 	Log::Error("Utilities::StringToColorAlgorithm - Unknown Color Algorithm");
 
@@ -297,3 +301,45 @@ ExportImageFormat Utilities::StringToExportImageFormat(const std::string& format
 
 	return ExportImageFormat::PNG;
 }
+
+std::string Utilities::InstructionSetToString(const InstructionSet& instructionSet) {
+	switch (instructionSet) {
+		case InstructionSet::Auto:		return "Auto";
+		case InstructionSet::Scalar:	return "Scalar";
+		case InstructionSet::SSE2:		return "SSE2";
+		case InstructionSet::AVX2:		return "AVX2";
+		case InstructionSet::AVX512:	return "AVX-512";
+		default:						return "Unknown";
+	}
+}
+
+InstructionSet Utilities::StringToInstructionSet(const std::string& instructionSet) {
+	if (instructionSet == "Auto")		return InstructionSet::Auto;
+	if (instructionSet == "Scalar")		return InstructionSet::Scalar;
+	if (instructionSet == "SSE2")		return InstructionSet::SSE2;
+	if (instructionSet == "AVX2")		return InstructionSet::AVX2;
+	if (instructionSet == "AVX-512")	return InstructionSet::AVX512;
+
+	Log::Error("Utilities::StringToInstructionSet - Unknown Instruction Set");
+
+	return InstructionSet::Auto;
+}
+
+std::string Utilities::AreaSkippingModeToString(const AreaSkippingMode& mode) {
+	switch (mode) {
+		case AreaSkippingMode::None:			return "None";
+		case AreaSkippingMode::MarianiSilver:	return "Mariani-Silver";
+		case AreaSkippingMode::SolidGuessing:	return "Solid Guessing";
+		default:								return "Unknown";
+	}
+}
+
+AreaSkippingMode Utilities::StringToAreaSkippingMode(const std::string& mode) {
+	if (mode == "None")				return AreaSkippingMode::None;
+	if (mode == "Mariani-Silver")	return AreaSkippingMode::MarianiSilver;
+	if (mode == "Solid Guessing")	return AreaSkippingMode::SolidGuessing;
+
+	Log::Error("Utilities::StringToAreaSkippingMode - Unknown Area Skipping Mode");
+
+	return AreaSkippingMode::None;
+}
\ No newline at end of file
@@ -40,4 +40,10 @@ public:
 
 	static std::string ExportImageFormatToString(const ExportImageFormat& format);
 	static ExportImageFormat StringToExportImageFormat(const std::string& format);
+
+	static std::string InstructionSetToString(const InstructionSet& instructionSet);
+	static InstructionSet StringToInstructionSet(const std::string& instructionSet);
+
+	static std::string AreaSkippingModeToString(const AreaSkippingMode& mode);
+	static AreaSkippingMode StringToAreaSkippingMode(const std::string& mode);
 };
\ No newline at end of file
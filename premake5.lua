@@ -97,6 +97,66 @@ project "Mandelbrot"
 
     filter "configurations:Dist"
         kind "WindowedApp"
+        defines { "MB_DIST" }
+        runtime "Release"
+        optimize "On"
+        symbols "Off"
+
+-- Microbenchmarks of the escape-time kernels of the CPU engine, built from the kernel sources alone (no window, no OpenGL).
+-- Run it with '--help' for its options. It prints a JSON report, so the results of two runs can be diffed.
+project "MandelbrotBench"
+    kind "ConsoleApp"
+    language "C++"
+    cppdialect "C++latest"
+    staticruntime "on"
+
+	targetdir ("%{wks.location}/bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("%{wks.location}/bin-int/" .. outputdir .. "/%{prj.name}")
+
+    files {
+        "Benchmarks/**.h",
+        "Benchmarks/**.cpp",
+        "Source/Core/BigFloat.cpp",
+        "Source/Core/CommandLine.cpp",
+        "Source/Core/CPUFeatures.cpp",
+        "Source/Core/JsonWriter.cpp",
+        "Source/Core/Log.cpp",
+        "Source/Core/Profiler.cpp",
+        "Source/Core/ThreadPool.cpp",
+        "Source/Renderer/CPU/FractalKernel.cpp",
+        "Source/Renderer/CPU/FractalKernelSSE2.cpp",
+        "Source/Renderer/CPU/FractalKernelAVX2.cpp",
+        "Source/Renderer/CPU/FractalKernelAVX512.cpp",
+        "Source/Utilities/Utilities.cpp"
+    }
+
+    defines {
+        "_CRT_SECURE_NO_WARNINGS",
+        "GLM_ENABLE_EXPERIMENTAL"
+    }
+
+    includedirs {
+        "Source",
+		"%{IncludeDir.glm}",
+    }
+
+    filter "system:windows"
+        systemversion "latest"
+        defines { "MB_PLATFORM_WINDOWS" }
+
+    filter "configurations:Debug"
+        defines { "WL_DEBUG" }
+        runtime "Debug"
+        symbols "On"
+
+    filter "configurations:Release"
+        defines { "MB_RELEASE" }
+        runtime "Release"
+        optimize "On"
+        symbols "On"
+
+    -- Dist stays a console application, as the report goes to the standard output
+    filter "configurations:Dist"
         defines { "MB_DIST" }
         runtime "Release"
         optimize "On"